@@ -7,7 +7,9 @@
 #include "Game\Entities\PointOfInterest.hpp"
 #include "Game\GameStates\PlayingState.hpp"
 #include "Game\Entities\Fire.hpp"
-#include "Game\Helpers\AnalysisData.hpp"
+#include "Game\Helpers\AnalysisScope.hpp"
+#include "Game\Helpers\SimulationPolicies.hpp"
+#include "Game\Helpers\SimulationSnapshot.hpp"
 #include "Engine\Core\Transform2D.hpp"
 #include "Engine\Math\MathUtils.hpp"
 #include "Engine\Window\Window.hpp"
@@ -27,11 +29,14 @@ Agent::Agent(Vector2 startingPosition, IsoSpriteAnimSet* animationSet, Map* mapR
 	//set id according to how many we've made
 	m_id = mapReference->m_agentsOrderedByXPosition.size();
 
+	//spawn order is the same for every sim using this seed so agents keep their personality across runs
+	m_randomStream.Reseed(mapReference->m_randomSeed, AGENT_RANDOM_STREAM_OFFSET + (uint64_t)m_id);
+
 	//setup position and planner
 	m_position = startingPosition;
 	m_planner = new Planner(mapReference, this);
 	m_intermediateGoalPosition = m_position;
-	m_actionTimer = new Stopwatch(GetGameClock());
+	m_actionTimer = mapReference->m_timingWheel.CreateTimer();
 
 	//generate personality
 	GenerateRandomStats();
@@ -42,8 +47,8 @@ Agent::Agent(Vector2 startingPosition, IsoSpriteAnimSet* animationSet, Map* mapR
 
 	//precompute sprite data
 	m_animationSet = animationSet;
-	m_animationSet->SetCurrentAnim("idle");
-	Sprite sprite = *m_animationSet->GetCurrentSprite(m_spriteDirection);
+	m_animationSet->StartAnim(m_animationState, IDLE_ANIMATION_TYPE);
+	Sprite sprite = *m_animationSet->GetCurrentSprite(m_animationState, m_spriteDirection);
 	Vector2 spritePivot = sprite.m_definition->m_pivot;
 	IntVector2 spriteDimensions = sprite.GetDimensions();
 
@@ -52,22 +57,21 @@ Agent::Agent(Vector2 startingPosition, IsoSpriteAnimSet* animationSet, Map* mapR
 	//m_spriteRenderBounds.mins.y = 0.f - (spritePivot.y) * 1.f;
 	//m_spriteRenderBounds.maxs.y = m_spriteRenderBounds.mins.y + 1.f * 1.f;
 
-	m_positionStuckCheckTimer = new Stopwatch(GetGameClock());
-	m_positionStuckCheckTimer->SetTimer(g_agentOldPositionRefreshRate);
+	m_positionStuckCheckTimer = mapReference->m_timingWheel.CreateTimer();
+	mapReference->m_timingWheel.StartTimer(m_positionStuckCheckTimer, g_agentOldPositionRefreshRate, true);
 }
 
 //  =========================================================================================
 Agent::~Agent()
 {
+	//timers live on the map so release them while we can still reach it through the planner
+	TimingWheel& timingWheel = m_planner->m_map->m_timingWheel;
+	timingWheel.DestroyTimer(m_actionTimer);
+	timingWheel.DestroyTimer(m_positionStuckCheckTimer);
+
 	delete(m_planner);
 	m_planner = nullptr;
 
-	delete(m_actionTimer);
-	m_actionTimer = nullptr;
-
-	delete(m_positionStuckCheckTimer);
-	m_positionStuckCheckTimer = nullptr;
-
 	m_animationSet = nullptr;
 }
 
@@ -83,15 +87,15 @@ Agent::~Agent()
 //  =========================================================================================
 void Agent::GenerateRandomStats()
 {
-	m_combatBias = GetRandomFloatInRange(0.1f, 0.9f);
-	m_repairBias = GetRandomFloatInRange(0.1f, 0.9f);
-	m_healBias = GetRandomFloatInRange(0.1f, 0.9f);
-	m_fireFightingBias = GetRandomFloatInRange(0.1f, 0.9f);
+	m_combatBias = m_randomStream.GetNextFloatInRange(0.1f, 0.9f);
+	m_repairBias = m_randomStream.GetNextFloatInRange(0.1f, 0.9f);
+	m_healBias = m_randomStream.GetNextFloatInRange(0.1f, 0.9f);
+	m_fireFightingBias = m_randomStream.GetNextFloatInRange(0.1f, 0.9f);
 
-	m_combatEfficiency = GetRandomFloatInRange(0.25f, 0.9f);
-	m_repairEfficiency = GetRandomFloatInRange(0.25f, 0.9f);
-	m_healEfficiency = GetRandomFloatInRange(0.25f, 0.9f);
-	m_fireFightingEfficiency = GetRandomFloatInRange(0.25f, 0.9f);
+	m_combatEfficiency = m_randomStream.GetNextFloatInRange(0.25f, 0.9f);
+	m_repairEfficiency = m_randomStream.GetNextFloatInRange(0.25f, 0.9f);
+	m_healEfficiency = m_randomStream.GetNextFloatInRange(0.25f, 0.9f);
+	m_fireFightingEfficiency = m_randomStream.GetNextFloatInRange(0.25f, 0.9f);
 
 	UpdateCombatPerformanceTime();
 	UpdateRepairPerformanceTime();
@@ -100,26 +104,16 @@ void Agent::GenerateRandomStats()
 }	
 
 //  =========================================================================================
+template <typename SimulationPolicy>
 void Agent::Update(float deltaSeconds)
 {
 	PROFILER_PUSH();
 
-#ifdef AgentUpdateAnalysis
-	// profiling ----------------------------------------------
-	g_agentUpdateAnalysisData->Start();
-	//  ----------------------------------------------
-#endif
+	ScopedAnalysisTimer<AgentUpdateAnalysisPolicy> analysisTimer(g_agentUpdateAnalysisData);
 
-	m_planner->ProcessActionStack(deltaSeconds);	
+	m_planner->ProcessActionStack<SimulationPolicy>(deltaSeconds);	
 
 	UpdateSpriteRenderDirection();
-	m_animationSet->Update(deltaSeconds);
-
-#ifdef AgentUpdateAnalysis
-	// profiling ----------------------------------------------
-	g_agentUpdateAnalysisData->End();
-	//  ----------------------------------------------
-#endif	
 }
 
 //  =============================================================================
@@ -129,8 +123,6 @@ void Agent::QuickUpdate(float deltaSeconds)
 
 	int priorityIncreaseAmount = 1;
 
-	m_animationSet->Update(deltaSeconds);
-
 	//if we are walking at the moment, keep walking in the same direction (physics will handle the rest)
 	if (m_currentPath.size() > 0 && m_planner->IsMoving())
 	{
@@ -138,7 +130,7 @@ void Agent::QuickUpdate(float deltaSeconds)
 		m_forward.NormalizeAndGetLength();
 
 		//move even slower if we can't get here
-		m_position += (m_forward * (m_movespeed * GetGameClock()->GetDeltaSeconds()));
+		m_position += (m_forward * (m_movespeed * deltaSeconds));
 	}
 
 	TODO("Later add more criteria to better define this data");
@@ -154,7 +146,7 @@ void Agent::Render()
 	/*PROFILER_PUSH();
 	Renderer* theRenderer = Renderer::GetInstance();
 
-	Sprite sprite = *m_animationSet->GetCurrentSprite(m_spriteDirection);
+	Sprite sprite = *m_animationSet->GetCurrentSprite(m_animationState, m_spriteDirection);
 	Texture* texture = sprite.GetSpriteTexture();
 
 	Rgba agentColor = Rgba::WHITE;
@@ -179,15 +171,12 @@ void Agent::Render()
 }
 
 //  =========================================================================================
+template <typename PathingPolicy>
 bool Agent::GetPathToDestination(const Vector2& goalDestination)
 {
 	PROFILER_PUSH();
 
-#ifdef PathingDataAnalysis
-	// profiling ----------------------------------------------
-	g_pathingAnalysisData->Start();
-	//  ----------------------------------------------
-#endif
+	ScopedAnalysisTimer<PathingAnalysisPolicy> analysisTimer(g_pathingAnalysisData);
 
 	//PROFILER_PUSH();
 	m_currentPath = std::vector<Vector2>(); //clear vector
@@ -199,23 +188,13 @@ bool Agent::GetPathToDestination(const Vector2& goalDestination)
 	m_currentPath.push_back(goalDestination);
 
 	//add the location
-	if (GetIsOptimized())
-	{
-		isDestinationFound = AStarSearchOnGrid(m_currentPath, startCoord, endCoord, m_planner->m_map->m_mapAsGrid, m_planner->m_map);
-	}		
-	else
-	{
-		Grid<int> mapGrid;
-		m_planner->m_map->GetAsGrid(mapGrid);
+	Grid<int> scratchGrid;
+	Grid<int>* mapGrid = PathingPolicy::GetPathingGrid(m_planner->m_map, scratchGrid);
 
-		isDestinationFound = AStarSearchOnGrid(m_currentPath, startCoord, endCoord, &mapGrid, m_planner->m_map);
-	}
+	isDestinationFound = AStarSearchOnGrid(m_currentPath, startCoord, endCoord, mapGrid, m_planner->m_map);
 
-#ifdef PathingDataAnalysis
-	// profiling ----------------------------------------------
-	g_pathingAnalysisData->End();
-	//  ----------------------------------------------
-#endif
+	//start following from the end of the path so MoveAction doesn't search again
+	m_currentPathIndex = m_currentPath.empty() ? INVALID_PATH_INDEX : (int)m_currentPath.size() - 1;
 
 	return isDestinationFound;
 }
@@ -235,6 +214,16 @@ bool Agent::GetIsAtPosition(const Vector2& position)
 	return m_physicsDisc.IsPointInside(position);
 }
 
+//  =========================================================================================
+bool Agent::GetHasPathToDestination(const Vector2& goalDestination) const
+{
+	//paths are stored end first
+	if (m_currentPathIndex == INVALID_PATH_INDEX || m_currentPathIndex >= (int)m_currentPath.size())
+		return false;
+
+	return m_currentPath[0] == goalDestination;
+}
+
 //  =========================================================================================
 void Agent::UpdatePhysicsData()
 {
@@ -249,8 +238,8 @@ bool Agent::IsHazardAhead()
 	Map* map = m_planner->m_map;
 
 	Vector2 positionAhead = m_position + m_forward;
-	Tile* forwardTile = map->GetTileAtWorldPosition(positionAhead);
-	if(forwardTile->m_tileDefinition->m_name == "Fire")
+	const Tile* forwardTile = map->GetTileAtWorldPosition(positionAhead);
+	if(forwardTile != nullptr && forwardTile->IsHazard())
 		return true;
 
 	return false;
@@ -313,14 +302,14 @@ void Agent::ConstructInformationAsText(std::vector<std::string>& outStrings)
 	outStrings.push_back(Stringf("Plan: %s", m_planner->GetPlanTypeAsText().c_str()));
 	outStrings.push_back(Stringf("Path Steps: %i", m_currentPath.size()));
 	outStrings.push_back(Stringf("Update Pr.: %i", m_updatePriority));
-	outStrings.push_back(Stringf("Gather Arr. Util.: %f", m_planner->m_utilityHistory.m_lastGatherArrows));
-	outStrings.push_back(Stringf("Gather Lum. Util.: %f", m_planner->m_utilityHistory.m_lastGatherLumber));
-	outStrings.push_back(Stringf("Gather Ban. Util.: %f", m_planner->m_utilityHistory.m_lastGatherBandages));
-	outStrings.push_back(Stringf("Gather Wat. Util.: %f", m_planner->m_utilityHistory.m_lastGatherWater));
-	outStrings.push_back(Stringf("Shoot. Util.: %f", m_planner->m_utilityHistory.m_lastShoot));
-	outStrings.push_back(Stringf("Repair Util.: %f", m_planner->m_utilityHistory.m_lastRepair));
-	outStrings.push_back(Stringf("Heal Util.: %f", m_planner->m_utilityHistory.m_lastHeal));
-	outStrings.push_back(Stringf("Fire Util.: %f", m_planner->m_utilityHistory.m_lastFightFire));
+	outStrings.push_back(Stringf("Gather Arr. Util.: %f", m_planner->m_utilityHistory.m_lastUtilityPerPlanType[GATHER_ARROWS_PLAN_TYPE]));
+	outStrings.push_back(Stringf("Gather Lum. Util.: %f", m_planner->m_utilityHistory.m_lastUtilityPerPlanType[GATHER_LUMBER_PLAN_TYPE]));
+	outStrings.push_back(Stringf("Gather Ban. Util.: %f", m_planner->m_utilityHistory.m_lastUtilityPerPlanType[GATHER_BANDAGES_PLAN_TYPE]));
+	outStrings.push_back(Stringf("Gather Wat. Util.: %f", m_planner->m_utilityHistory.m_lastUtilityPerPlanType[GATHER_WATER_PLAN_TYPE]));
+	outStrings.push_back(Stringf("Shoot. Util.: %f", m_planner->m_utilityHistory.m_lastUtilityPerPlanType[SHOOT_PLAN_TYPE]));
+	outStrings.push_back(Stringf("Repair Util.: %f", m_planner->m_utilityHistory.m_lastUtilityPerPlanType[REPAIR_PLAN_TYPE]));
+	outStrings.push_back(Stringf("Heal Util.: %f", m_planner->m_utilityHistory.m_lastUtilityPerPlanType[HEAL_PLAN_TYPE]));
+	outStrings.push_back(Stringf("Fire Util.: %f", m_planner->m_utilityHistory.m_lastUtilityPerPlanType[FIGHT_FIRE_PLAN_TYPE]));
 	outStrings.push_back(Stringf("Chosen Outcome.: %i", (int)m_planner->m_utilityHistory.m_chosenOutcome));
 
 }
@@ -406,6 +395,8 @@ void Agent::ResetPriority()
 void Agent::ResetPlannerAndPathing()
 {
 	m_planner->ClearActionStack();
+	m_planner->CancelPlanEvaluation();
+	m_planner->ClearPrefetchedPath();
 	ClearCurrentPath();
 }
 
@@ -413,7 +404,7 @@ void Agent::ResetPlannerAndPathing()
 void Agent::ClearCurrentPath()
 {
 	m_currentPath.clear();
-	m_currentPathIndex = UINT8_MAX;
+	m_currentPathIndex = INVALID_PATH_INDEX;
 }
 
 //  =========================================================================================
@@ -427,16 +418,17 @@ bool MoveAction(Agent* agent, const Vector2& goalDestination, int interactEntity
 	//used to handle any extra logic that must occur on first loop
 	if (agent->m_isFirstLoopThroughAction)
 	{
-		//do first pass logic
-		agent->ClearCurrentPath();
+		//do first pass logic. keep a path that was already loaded for this goal (prefetched during slack time)
+		if(!agent->GetHasPathToDestination(goalDestination))
+			agent->ClearCurrentPath();
 		agent->m_isFirstLoopThroughAction = false;
 		agent->m_oldPosition = agent->m_position;
 
-		agent->m_positionStuckCheckTimer->Reset();
+		agent->m_planner->m_map->m_timingWheel.StartTimer(agent->m_positionStuckCheckTimer, g_agentOldPositionRefreshRate, true);
 	}
 
 	//catch scenarios where agent is stuck here
-	if (agent->m_positionStuckCheckTimer->ResetAndDecrementIfElapsed())
+	if (agent->m_planner->m_map->m_timingWheel.ConsumeExpirations(agent->m_positionStuckCheckTimer) > 0)
 	{
 		//if(agent->m_physicsDisc.IsPointInside(agent->m_oldPosition))
 		if( FloorPosition(agent->m_oldPosition) == FloorPosition(agent->m_position))
@@ -449,15 +441,14 @@ bool MoveAction(Agent* agent, const Vector2& goalDestination, int interactEntity
 
 	UNUSED(interactEntityId);
 
-	TODO("might optimize not doing this every frame later");
-	agent->m_animationSet->SetCurrentAnim("walk");
+	agent->m_animationSet->SetCurrentAnim(agent->m_animationState, WALK_ANIMATION_TYPE);
 
 	// early out
 	if (agent->GetIsAtPosition(goalDestination))
 	{
 		//reset first loop action
 		agent->m_isFirstLoopThroughAction = true;
-		agent->m_currentPathIndex = UINT8_MAX;
+		agent->m_currentPathIndex = INVALID_PATH_INDEX;
 		agent->UpdatePhysicsData();
 		return true;
 	}		
@@ -473,10 +464,19 @@ bool MoveAction(Agent* agent, const Vector2& goalDestination, int interactEntity
 	}
 
 	//if we don't have a path to the destination or have completed our previous path, get a new path
-	if (agent->m_currentPath.size() == 0 || agent->m_currentPathIndex == UINT8_MAX)
+	if (agent->m_currentPath.size() == 0 || agent->m_currentPathIndex == INVALID_PATH_INDEX)
 	{
-		agent->GetPathToDestination(goalDestination);
-		agent->m_currentPathIndex = (uint8)agent->m_currentPath.size() - 1;
+		//chained steps usually have a path ready from slack time
+		//actions are plain callbacks so the search comes through the map's policy pick instead of a template argument
+		if(!agent->m_planner->TryUsePrefetchedPath(goalDestination))
+			(agent->*(agent->m_planner->m_map->m_agentPathFunction))(goalDestination);
+
+		//nothing to follow yet. try again next update
+		if (agent->m_currentPathIndex == INVALID_PATH_INDEX)
+		{
+			agent->UpdatePhysicsData();
+			return false;
+		}
 	}	
 
 	//We have a path, follow it.
@@ -487,7 +487,7 @@ bool MoveAction(Agent* agent, const Vector2& goalDestination, int interactEntity
 		agent->m_forward = agent->m_intermediateGoalPosition - agent->m_position;
 		agent->m_forward.NormalizeAndGetLength();
 
-		agent->m_position += (agent->m_forward * (agent->m_movespeed * GetGameClock()->GetDeltaSeconds()));
+		agent->m_position += (agent->m_forward * (agent->m_movespeed * agent->m_planner->m_map->m_simulationDeltaSeconds));
 		agent->UpdatePhysicsData();
 	}		
 	else
@@ -513,7 +513,7 @@ bool MoveAction(Agent* agent, const Vector2& goalDestination, int interactEntity
 			agent->m_forward = agent->m_intermediateGoalPosition - agent->m_position;
 			agent->m_forward.NormalizeAndGetLength();
 
-			agent->m_position += (agent->m_forward * (agent->m_movespeed * GetGameClock()->GetDeltaSeconds()));
+			agent->m_position += (agent->m_forward * (agent->m_movespeed * agent->m_planner->m_map->m_simulationDeltaSeconds));
 			agent->UpdatePhysicsData();
 		}
 	}
@@ -532,13 +532,13 @@ bool ShootAction(Agent* agent, const Vector2& goalDestination, int interactEntit
 	{
 		//do first pass logic
 		agent->m_isFirstLoopThroughAction = false;
-		agent->m_actionTimer->SetTimer(agent->m_calculatedCombatPerformancePerSecond);		
+		agent->m_planner->m_map->m_timingWheel.StartTimer(agent->m_actionTimer, agent->m_calculatedCombatPerformancePerSecond, true);		
 	}
 
-	agent->m_animationSet->SetCurrentAnim("shoot");
+	agent->m_animationSet->SetCurrentAnim(agent->m_animationState, SHOOT_ANIMATION_TYPE);
 
 	//if we are at our destination, we are ready to shoot	
-	if (agent->m_actionTimer->DecrementAll() > 0)
+	if (agent->m_planner->m_map->m_timingWheel.ConsumeExpirations(agent->m_actionTimer) > 0)
 	{
 		//launch arrow in agent forward
 		agent->m_planner->m_map->m_threat = ClampInt(agent->m_planner->m_map->m_threat - g_baseShootDamageAmountPerPerformance, 0, g_maxThreat);
@@ -546,7 +546,7 @@ bool ShootAction(Agent* agent, const Vector2& goalDestination, int interactEntit
 
 		ASSERT_OR_DIE(agent->m_arrowCount >= 0, "AGENT ARROW COUNT NEGATIVE!!");
 
-		agent->m_animationSet->GetCurrentAnim()->PlayFromStart();
+		agent->m_animationSet->StartAnim(agent->m_animationState, SHOOT_ANIMATION_TYPE);
 	}	
 
 	if (agent->m_arrowCount == 0 || agent->m_planner->m_map->m_threat == 0)
@@ -570,16 +570,16 @@ bool RepairAction(Agent* agent, const Vector2& goalDestination, int interactEnti
 		PointOfInterest* targetPoi = agent->m_planner->m_map->GetPointOfInterestById(interactEntityId);
 		agent->m_forward = targetPoi->GetWorldBounds().GetCenter() - agent->m_position;
 		//do first pass logic
-		agent->m_actionTimer->SetTimer(agent->m_calculatedRepairPerformancePerSecond);
+		agent->m_planner->m_map->m_timingWheel.StartTimer(agent->m_actionTimer, agent->m_calculatedRepairPerformancePerSecond, true);
 		agent->m_isFirstLoopThroughAction = false;
 	}
 
-	agent->m_animationSet->SetCurrentAnim("cast");
+	agent->m_animationSet->SetCurrentAnim(agent->m_animationState, CAST_ANIMATION_TYPE);
 
 	//if we are at our destination, we are ready to repair
 	PointOfInterest* targetPoi = agent->m_planner->m_map->GetPointOfInterestById(interactEntityId);
 	
-	if (agent->m_actionTimer->DecrementAll() > 0)
+	if (agent->m_planner->m_map->m_timingWheel.ConsumeExpirations(agent->m_actionTimer) > 0)
 	{
 		targetPoi->m_health = ClampInt(targetPoi->m_health + g_baseRepairAmountPerPerformance, 0, 100);
 		agent->m_lumberCount--;
@@ -606,13 +606,13 @@ bool HealAction(Agent* agent, const Vector2& goalDestination, int interactEntity
 	if (agent->m_isFirstLoopThroughAction)
 	{
 		//do first pass logic
-		agent->m_actionTimer->SetTimer(agent->m_calculatedHealPerformancePerSecond);
+		agent->m_planner->m_map->m_timingWheel.StartTimer(agent->m_actionTimer, agent->m_calculatedHealPerformancePerSecond, true);
 		agent->m_isFirstLoopThroughAction = false;
 	}
 
-	agent->m_animationSet->SetCurrentAnim("heal");
+	agent->m_animationSet->SetCurrentAnim(agent->m_animationState, HEAL_ANIMATION_TYPE);
 
-	if (agent->m_actionTimer->DecrementAll() > 0)
+	if (agent->m_planner->m_map->m_timingWheel.ConsumeExpirations(agent->m_actionTimer) > 0)
 	{
 		agent->m_health = ClampInt(agent->m_health + g_baseHealAmountPerPerformance, 0, 100);
 		agent->m_bandageCount--;
@@ -649,14 +649,14 @@ bool FightFireAction(Agent* agent, const Vector2& goalDestination, int interactE
 	{
 		//do first pass logic
 		agent->m_forward = targetFire->m_worldPosition - agent->m_position;	
-		agent->m_actionTimer->SetTimer(agent->m_calculatedRepairPerformancePerSecond);
+		agent->m_planner->m_map->m_timingWheel.StartTimer(agent->m_actionTimer, agent->m_calculatedRepairPerformancePerSecond, true);
 		agent->m_isFirstLoopThroughAction = false;
 	}
 
-	agent->m_animationSet->SetCurrentAnim("heal");
+	agent->m_animationSet->SetCurrentAnim(agent->m_animationState, HEAL_ANIMATION_TYPE);
 
 	//if we are at our destination, we are ready to fight the fire
-	if (agent->m_actionTimer->DecrementAll() > 0)
+	if (agent->m_planner->m_map->m_timingWheel.ConsumeExpirations(agent->m_actionTimer) > 0)
 	{
 		targetFire->m_health = ClampInt(targetFire->m_health - g_baseFireFightingAmountPerPerformance, 0, g_maxFireHealth);
 		agent->m_waterCount--;
@@ -679,7 +679,7 @@ bool GatherAction(Agent* agent, const Vector2& goalDestination, int interactEnti
 {
 	PROFILER_PUSH();
 
-	agent->m_animationSet->SetCurrentAnim("cast");
+	agent->m_animationSet->SetCurrentAnim(agent->m_animationState, CAST_ANIMATION_TYPE);
 
 	//if we are at our destination, we are ready to gather
 	PointOfInterest* targetPoi = agent->m_planner->m_map->GetPointOfInterestById(interactEntityId);
@@ -706,8 +706,8 @@ bool GatherAction(Agent* agent, const Vector2& goalDestination, int interactEnti
 		if (targetPoi->m_agentCurrentlyServing == nullptr)
 		{
 			targetPoi->m_agentCurrentlyServing = agent;
-			targetPoi->m_refillTimer->Reset();
-			agent->m_animationSet->SetCurrentAnim("cast");
+			agent->m_planner->m_map->m_timingWheel.StartTimer(targetPoi->m_refillTimer, g_baseResourceRefillTimePerSecond, true);
+			agent->m_animationSet->SetCurrentAnim(agent->m_animationState, CAST_ANIMATION_TYPE);
 		}
 		//another agent is being served so we need to wait
 		else
@@ -722,7 +722,7 @@ bool GatherAction(Agent* agent, const Vector2& goalDestination, int interactEnti
 	switch (targetPoi->m_type)
 	{
 	case ARMORY_POI_TYPE:
-		if (targetPoi->m_refillTimer->ResetAndDecrementIfElapsed())
+		if (targetPoi->m_map->m_timingWheel.ConsumeExpirations(targetPoi->m_refillTimer) > 0)
 		{
 			agent->m_arrowCount++;
 		}
@@ -737,7 +737,7 @@ bool GatherAction(Agent* agent, const Vector2& goalDestination, int interactEnti
 		}
 		break;
 	case LUMBERYARD_POI_TYPE:
-		if (targetPoi->m_refillTimer->ResetAndDecrementIfElapsed())
+		if (targetPoi->m_map->m_timingWheel.ConsumeExpirations(targetPoi->m_refillTimer) > 0)
 		{
 			agent->m_lumberCount++;
 		}
@@ -752,7 +752,7 @@ bool GatherAction(Agent* agent, const Vector2& goalDestination, int interactEnti
 		}
 		break;
 	case MED_STATION_POI_TYPE:
-		if (targetPoi->m_refillTimer->ResetAndDecrementIfElapsed())
+		if (targetPoi->m_map->m_timingWheel.ConsumeExpirations(targetPoi->m_refillTimer) > 0)
 		{
 			agent->m_bandageCount++;
 		}
@@ -768,7 +768,7 @@ bool GatherAction(Agent* agent, const Vector2& goalDestination, int interactEnti
 		break;	
 
 		case WELL_POI_TYPE:
-			if (targetPoi->m_refillTimer->ResetAndDecrementIfElapsed())
+			if (targetPoi->m_map->m_timingWheel.ConsumeExpirations(targetPoi->m_refillTimer) > 0)
 			{
 				agent->m_waterCount++;
 			}
@@ -788,6 +788,104 @@ bool GatherAction(Agent* agent, const Vector2& goalDestination, int interactEnti
 	return false;
 }
 
+//  =========================================================================================
+void Agent::WriteSnapshot(SnapshotWriter& writer)
+{
+	writer.Write(m_id);
+	writer.Write(m_updatePriority);
+	writer.Write(m_health);
+	writer.Write(m_isFirstLoopThroughAction);
+	writer.Write(m_actionTimer);
+	writer.Write(m_positionStuckCheckTimer);
+	writer.Write(m_randomStream);
+
+	//personality
+	writer.Write(m_combatBias);
+	writer.Write(m_repairBias);
+	writer.Write(m_healBias);
+	writer.Write(m_fireFightingBias);
+	writer.Write(m_combatEfficiency);
+	writer.Write(m_repairEfficiency);
+	writer.Write(m_healEfficiency);
+	writer.Write(m_fireFightingEfficiency);
+	writer.Write(m_calculatedCombatPerformancePerSecond);
+	writer.Write(m_calculatedRepairPerformancePerSecond);
+	writer.Write(m_calculatedHealPerformancePerSecond);
+	writer.Write(m_calculatedFireFightingPerformancePerSecond);
+
+	//inventory
+	writer.Write(m_arrowCount);
+	writer.Write(m_bandageCount);
+	writer.Write(m_lumberCount);
+	writer.Write(m_waterCount);
+
+	//movement
+	writer.Write(m_movespeed);
+	writer.Write(m_position);
+	writer.Write(m_forward);
+	writer.Write(m_intermediateGoalPosition);
+	writer.Write(m_oldPosition);
+	writer.Write(m_physicsDisc);
+	writer.WriteVector(m_currentPath);
+	writer.Write(m_currentPathIndex);
+	writer.Write(m_spriteDirection);
+
+	writer.Write(m_indexInSortedXList);
+	writer.Write(m_indexInSortedYList);
+	writer.Write(m_indexInPriorityList);
+
+	m_planner->WriteSnapshot(writer);
+}
+
+//  =========================================================================================
+bool Agent::ReadSnapshot(SnapshotReader& reader)
+{
+	reader.Read(m_id);
+	reader.Read(m_updatePriority);
+	reader.Read(m_health);
+	reader.Read(m_isFirstLoopThroughAction);
+	reader.Read(m_actionTimer);
+	reader.Read(m_positionStuckCheckTimer);
+	reader.Read(m_randomStream);
+
+	//personality
+	reader.Read(m_combatBias);
+	reader.Read(m_repairBias);
+	reader.Read(m_healBias);
+	reader.Read(m_fireFightingBias);
+	reader.Read(m_combatEfficiency);
+	reader.Read(m_repairEfficiency);
+	reader.Read(m_healEfficiency);
+	reader.Read(m_fireFightingEfficiency);
+	reader.Read(m_calculatedCombatPerformancePerSecond);
+	reader.Read(m_calculatedRepairPerformancePerSecond);
+	reader.Read(m_calculatedHealPerformancePerSecond);
+	reader.Read(m_calculatedFireFightingPerformancePerSecond);
+
+	//inventory
+	reader.Read(m_arrowCount);
+	reader.Read(m_bandageCount);
+	reader.Read(m_lumberCount);
+	reader.Read(m_waterCount);
+
+	//movement
+	reader.Read(m_movespeed);
+	reader.Read(m_position);
+	reader.Read(m_forward);
+	reader.Read(m_intermediateGoalPosition);
+	reader.Read(m_oldPosition);
+	reader.Read(m_physicsDisc);
+	reader.ReadVector(m_currentPath);
+	reader.Read(m_currentPathIndex);
+	reader.Read(m_spriteDirection);
+
+	reader.Read(m_indexInSortedXList);
+	reader.Read(m_indexInSortedYList);
+	reader.Read(m_indexInPriorityList);
+
+	return m_planner->ReadSnapshot(reader);
+}
+
 //  =========================================================================================
 bool AgentSort(Agent* a, Agent* b)
 {
@@ -797,3 +895,38 @@ bool AgentSort(Agent* a, Agent* b)
 	return false;
 }
 
+//  =========================================================================================
+//append only. the index is what gets saved
+static ActionCallback s_actionCallbacks[] = { &MoveAction, &ShootAction, &RepairAction, &HealAction, &FightFireAction, &GatherAction };
+constexpr int NUM_ACTION_CALLBACKS = sizeof(s_actionCallbacks) / sizeof(ActionCallback);
+
+//  =========================================================================================
+int GetActionCallbackIndex(ActionCallback action)
+{
+	for (int actionIndex = 0; actionIndex < NUM_ACTION_CALLBACKS; ++actionIndex)
+	{
+		if (s_actionCallbacks[actionIndex] == action)
+			return actionIndex;
+	}
+
+	ASSERT_OR_DIE(false, "ACTION MISSING FROM CALLBACK TABLE");
+	return -1;
+}
+
+//  =========================================================================================
+ActionCallback GetActionCallbackFromIndex(int actionIndex)
+{
+	if (actionIndex < 0 || actionIndex >= NUM_ACTION_CALLBACKS)
+		return nullptr;
+
+	return s_actionCallbacks[actionIndex];
+}
+
+//  =========================================================================================
+//  Policy instantiations
+//  =========================================================================================
+template void Agent::Update<OptimizedSimulationPolicy>(float deltaSeconds);
+template void Agent::Update<UnoptimizedSimulationPolicy>(float deltaSeconds);
+
+template bool Agent::GetPathToDestination<CopyPathPolicy>(const Vector2& goalDestination);
+template bool Agent::GetPathToDestination<SearchPathPolicy>(const Vector2& goalDestination);
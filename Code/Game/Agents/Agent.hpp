@@ -6,13 +6,19 @@
 #include "Engine\Core\Transform2D.hpp"
 #include "Engine\Math\AABB2.hpp"
 #include "Engine\Math\Disc2.hpp"
+#include "Game\Helpers\TimingWheel.hpp"
+#include "Game\Helpers\RandomStream.hpp"
 
 //forward declarations
 class Planner;
 class Map;
 class PlayingState;
 class Agent;
-class Stopwatch;
+class SnapshotWriter;
+class SnapshotReader;
+
+//path index meaning there is no path left to follow
+constexpr int INVALID_PATH_INDEX = -1;
 
 //typedefs
 typedef bool (*ActionCallback)(Agent* agent, const Vector2& goalDestination, int interactEntityId);
@@ -38,6 +44,7 @@ public:
 	void GenerateRandomStats();
 
 	//overriden classes
+	template <typename SimulationPolicy>
 	void Update(float deltaSeconds);
 	void QuickUpdate(float deltaSeconds);
 	void Render();
@@ -52,8 +59,10 @@ public:
 	void ClearCurrentPath();
 
 	//pathing
+	template <typename PathingPolicy>
 	bool GetPathToDestination(const Vector2& goalDestination);
 	bool GetIsAtPosition(const Vector2& goalDestination);
+	bool GetHasPathToDestination(const Vector2& goalDestination) const;
 	void UpdatePhysicsData();
 
 	bool IsHazardAhead();
@@ -67,14 +76,19 @@ public:
 	//debug tools
 	void ConstructInformationAsText(std::vector<std::string>& outStrings);
 
+	//checkpoints
+	void WriteSnapshot(SnapshotWriter& writer);
+	bool ReadSnapshot(SnapshotReader& reader);
+
 public:
 	int m_updatePriority = 1;
 
 	int m_id = -1;
 	int m_health = 100;
+	RandomStream m_randomStream;
 	bool m_isFirstLoopThroughAction = true;
-	Stopwatch* m_actionTimer = nullptr;
-	Stopwatch* m_positionStuckCheckTimer = nullptr;
+	TimerHandle m_actionTimer = INVALID_TIMER_HANDLE;
+	TimerHandle m_positionStuckCheckTimer = INVALID_TIMER_HANDLE;
 
 	// bias ----------------------------------------------
 	float m_combatBias = 0.5f;
@@ -114,11 +128,12 @@ public:
 
 	//goal logic ----------------------------------------------
 	std::vector<Vector2> m_currentPath;
-	uint8_t m_currentPathIndex = UINT8_MAX;
+	int m_currentPathIndex = INVALID_PATH_INDEX;
 
 	//sprites ----------------------------------------------
 	IntVector2 m_spriteDirection = IntVector2::UP;
-	IsoSpriteAnimSet* m_animationSet = nullptr;			
+	IsoSpriteAnimSet* m_animationSet = nullptr; //shared by every agent using the same definition
+	IsoSpriteAnimState m_animationState;			
 
 	//helper references ----------------------------------------------
 	Planner* m_planner = nullptr;
@@ -137,6 +152,10 @@ bool HealAction(Agent* agent, const Vector2& goalDestination, int interactEntity
 bool FightFireAction(Agent* agent, const Vector2& goalDestination, int interactEntityId);	//fight fire
 bool GatherAction(Agent* agent, const Vector2& goalDestination, int interactEntityId);		//acquire resource at poiLocation	
 
+//function pointers can't be saved so snapshots store the action's index
+int GetActionCallbackIndex(ActionCallback action);
+ActionCallback GetActionCallbackFromIndex(int actionIndex);
+
 
 bool AgentSort(Agent* a, Agent* b);
 
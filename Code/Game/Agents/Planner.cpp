@@ -4,11 +4,17 @@
 #include "Game\Entities\PointOfInterest.hpp"
 #include "Game\Agents\Agent.hpp"
 #include "Game\Entities\Fire.hpp"
+#include "Game\Definitions\PlanDefinition.hpp"
 #include "Game\GameCommon.hpp"
 #include "Game\GameStates\PlayingState.hpp"
 #include "Game\Game.hpp"
-#include "Game\Helpers\AnalysisData.hpp"
+#include "Game\Helpers\AnalysisScope.hpp"
+#include "Game\Helpers\SimulationPolicies.hpp"
+#include "Game\Helpers\SimulationSnapshot.hpp"
 #include "Engine\Time\Stopwatch.hpp"
+#include "Engine\Time\Time.hpp"
+#include "Engine\Utility\AStar.hpp"
+#include "Engine\Math\MathUtils.hpp"
 #include "Engine\Profiler\Profiler.hpp"
 #include "Engine\Core\EngineCommon.hpp"
 #include "Engine\Profiler\ProfilerConsole.hpp"
@@ -44,11 +50,11 @@ Planner::Planner(Map* mapReference, Agent* agentReference)
 		m_testUtilityStorage = new UtilityStorage(0.f, 1.f, g_utilityStorageDivisions);
 	}
 
-	m_updatePlanTimer = new Stopwatch(GetGameClock());
-	Game::GetGlobalRNG()->GetRandomInRange(0.f, 5.f);	
+	m_updatePlanTimer = m_map->m_timingWheel.CreateTimer();
+	m_testUtilityRandomStream.Reseed(m_map->m_randomSeed, PLANNER_TEST_RANDOM_STREAM_OFFSET + (uint64_t)m_agent->m_id);
 
 	//set a random timer so we can stagger the first update plans over 5 seconds
-	m_updatePlanTimer->SetTimer(Game::GetGlobalRNG()->GetRandomInRange(0.f, 5.f));
+	m_map->m_timingWheel.StartTimer(m_updatePlanTimer, m_agent->m_randomStream.GetNextFloatInRange(0.f, 5.f), false);
 }
 
 //  =========================================================================================
@@ -56,6 +62,8 @@ Planner::Planner(Map* mapReference, Agent* agentReference)
 //  =========================================================================================
 Planner::~Planner()
 {
+	m_map->m_timingWheel.DestroyTimer(m_updatePlanTimer);
+
 	m_map = nullptr;
 	m_agent = nullptr;
 
@@ -82,27 +90,29 @@ Planner::~Planner()
 }
 
 //  =========================================================================================
+template <typename SimulationPolicy>
 void Planner::ProcessActionStack(float deltaSeconds)
 {
 	PROFILER_PUSH();
 	
-#ifdef ActionStackAnalysis
-	// profiling ----------------------------------------------
-	g_processActionStackAnalysisData->Start();
-	//  ----------------------------------------------
-#endif
+	ScopedAnalysisTimer<ActionStackAnalysisPolicy> analysisTimer(g_processActionStackAnalysisData);
 
 	//if we don't have a plan, we need an immediate update, or our timer for checking our plan has elapsed
-	if (m_actionStack.size() == 0)
+	if (m_planEvaluation.m_isInProgress)
+	{
+		//keep working on the plan we started in a previous frame
+		UpdatePlan<SimulationPolicy>();
+	}
+	else if (m_actionStack.size() == 0)
 	{
 		//force a new plan update
 		ResetCurrentPlanData();
-		UpdatePlan();
+		UpdatePlan<SimulationPolicy>();
 	}
-	else if (m_updatePlanTimer->HasElapsed())
+	else if (m_map->m_timingWheel.HasElapsed(m_updatePlanTimer))
 	{
 		//only change the plan IF it's different than our current
-		UpdatePlan();
+		UpdatePlan<SimulationPolicy>();
 	}
 
 	//get action at the top of the queue
@@ -116,14 +126,9 @@ void Planner::ProcessActionStack(float deltaSeconds)
 		if (isComplete)
 		{
 			m_actionStack.pop();
+			UpdateChainedPlan();
 		}
 	}
-
-#ifdef ActionStackAnalysis
-	// profiling ----------------------------------------------
-	g_processActionStackAnalysisData->End();
-	//  ---------------------------------------------
-#endif
 }
 
 //  =========================================================================================
@@ -139,189 +144,128 @@ void Planner::ClearActionStack()
 	{
 		m_actionStack.pop();
 	}
+
+	m_chainedPlanStackSize = -1;
 }
 
 //  =========================================================================================
 //  Planning
 //  =========================================================================================
+template <typename SimulationPolicy>
 void Planner::UpdatePlan()
 {
 	PROFILER_PUSH();
 
-#ifdef UpdatePlanAnalysis
-	// profiling ----------------------------------------------
-	g_updatePlanAnalysisData->Start();
-	//  ----------------------------------------------
-#endif
-
-	//set preset to 
-	ePlanTypes chosenOutcome = NONE_PLAN_TYPE;
-	UtilityInfo highestUtilityInfo = GetIdleUtilityInfo();
-	UtilityInfo compareUtilityInfo;
-
-	float randomInput = GetRandomFloatZeroToOne();
-	CalculateTestUtility(randomInput);
+	ScopedAnalysisTimer<UpdatePlanAnalysisPolicy> analysisTimer(g_updatePlanAnalysisData);
 
-	//utility for gathering arrows ----------------------------------------------
-	compareUtilityInfo = GetHighestGatherArrowsUtility();
-	if (compareUtilityInfo.utility != 0.f)
-		SkewUtilityForBias(compareUtilityInfo, m_agent->m_combatBias);
-
-	if (m_currentPlan.m_chosenPlanType == GATHER_ARROWS_PLAN_TYPE  && compareUtilityInfo.utility != 0.f)
-	{
-		SkewCurrentPlanUtilityValue(compareUtilityInfo);
-	}
-	if (compareUtilityInfo.utility > highestUtilityInfo.utility)
+	//start a fresh evaluation if we aren't resuming one from a previous frame
+	if (!m_planEvaluation.m_isInProgress)
 	{
-		highestUtilityInfo = compareUtilityInfo;
-		chosenOutcome = GATHER_ARROWS_PLAN_TYPE;
+		BeginPlanEvaluation<SimulationPolicy>();
 	}
-	m_utilityHistory.m_lastGatherArrows = compareUtilityInfo.utility; //debug info
-		
-	//utility for gathering lumber ----------------------------------------------
-	compareUtilityInfo = GetHighestGatherLumberUtility();
-
-	if (compareUtilityInfo.utility != 0.f)
-		SkewUtilityForBias(compareUtilityInfo, m_agent->m_repairBias);
 
-	if (m_currentPlan.m_chosenPlanType == GATHER_LUMBER_PLAN_TYPE && compareUtilityInfo.utility != 0.f)
-	{
-		SkewCurrentPlanUtilityValue(compareUtilityInfo);
-	}
-	if(compareUtilityInfo.utility > highestUtilityInfo.utility)
-	{
-		highestUtilityInfo = compareUtilityInfo;
-		chosenOutcome = GATHER_LUMBER_PLAN_TYPE;
-	}
-	m_utilityHistory.m_lastGatherLumber = compareUtilityInfo.utility; 	//debug info
+	uint64_t sliceStartHPC = GetPerformanceCounter();
+	++m_planEvaluation.m_slicesUsed;
 
-	// utility for gathering bandages ----------------------------------------------
-	compareUtilityInfo = GetHighestGatherBandagesUtility();
-	if (compareUtilityInfo.utility != 0.f)
-		SkewUtilityForBias(compareUtilityInfo, m_agent->m_healBias);
+	//agent inputs are shared by every plan so they are only gathered once per slice
+	float utilityInputs[NUM_UTILITY_INPUTS];
+	FillAgentUtilityInputs(utilityInputs);
 
-	if (m_currentPlan.m_chosenPlanType == GATHER_BANDAGES_PLAN_TYPE && compareUtilityInfo.utility != 0.f)
+	//score plan types from the compiled plan definitions until we finish or run out of slice ----------------------------------------------
+	int numPlans = (int)PlanDefinition::s_planDefinitions.size();
+	while (m_planEvaluation.m_numPlansEvaluated < numPlans)
 	{
-		SkewCurrentPlanUtilityValue(compareUtilityInfo);
-	}
-	if(compareUtilityInfo.utility > highestUtilityInfo.utility)
-	{
-		highestUtilityInfo = compareUtilityInfo;
-		chosenOutcome = GATHER_BANDAGES_PLAN_TYPE;
-	}
-	m_utilityHistory.m_lastGatherBandages = compareUtilityInfo.utility;
+		int planIndex = (m_planEvaluation.m_startPlanIndex + m_planEvaluation.m_numPlansEvaluated) % numPlans;
+		const PlanDefinition& plan = PlanDefinition::s_planDefinitions[planIndex];
+		UtilityInfo compareUtilityInfo = EvaluatePlanDefinition<SimulationPolicy>(plan, utilityInputs);
 
-	//utility for gathering water ----------------------------------------------
-	compareUtilityInfo = GetHighestGatherWaterUtility();
-	if (compareUtilityInfo.utility != 0.f)
-		SkewUtilityForBias(compareUtilityInfo, m_agent->m_fireFightingBias);
+		if (compareUtilityInfo.utility != 0.f)
+		{
+			SkewUtilityForBias(compareUtilityInfo, GetBiasValue(plan.m_biasType));
 
-	if (m_currentPlan.m_chosenPlanType == GATHER_WATER_PLAN_TYPE  && compareUtilityInfo.utility != 0.f)
-	{
-		SkewCurrentPlanUtilityValue(compareUtilityInfo);
-	}
-	if (compareUtilityInfo.utility > highestUtilityInfo.utility)
-	{
-		highestUtilityInfo = compareUtilityInfo;
-		chosenOutcome = GATHER_WATER_PLAN_TYPE;
-	}
-	m_utilityHistory.m_lastGatherWater = compareUtilityInfo.utility; //debug info
+			if (m_currentPlan.m_chosenPlanType == plan.m_planType)
+				SkewCurrentPlanUtilityValue(compareUtilityInfo);
+		}
 
-	//utility for shooting	 ----------------------------------------------
-	compareUtilityInfo = GetHighestShootUtility();
+		if (compareUtilityInfo.utility > m_planEvaluation.m_highestUtilityInfo.utility)
+		{
+			m_planEvaluation.m_highestUtilityInfo = compareUtilityInfo;
+			m_planEvaluation.m_chosenOutcome = plan.m_planType;
+		}
+		m_utilityHistory.m_lastUtilityPerPlanType[plan.m_planType] = compareUtilityInfo.utility; //debug info
 
-	if(compareUtilityInfo.utility != 0.f)
-		SkewUtilityForBias(compareUtilityInfo, m_agent->m_combatBias);
+		++m_planEvaluation.m_numPlansEvaluated;
 
-	if (m_currentPlan.m_chosenPlanType == SHOOT_PLAN_TYPE  && compareUtilityInfo.utility != 0.f)
-	{
-		SkewCurrentPlanUtilityValue(compareUtilityInfo);
-	}
-	if(compareUtilityInfo.utility > highestUtilityInfo.utility)
-	{
-		highestUtilityInfo = compareUtilityInfo;
-		chosenOutcome = SHOOT_PLAN_TYPE;
+		//a budget of zero means the plan is always evaluated in one go
+		if (g_perPlanningSliceHPCBudget != 0 && GetPerformanceCounter() - sliceStartHPC >= g_perPlanningSliceHPCBudget)
+			break;
 	}
-	m_utilityHistory.m_lastShoot = compareUtilityInfo.utility; 	//debug info
-	
-
-	//utility for repairing buildings ----------------------------------------------
-	compareUtilityInfo = GetHighestRepairUtility();
 
-	if(compareUtilityInfo.utility != 0.f)
-		SkewUtilityForBias(compareUtilityInfo, m_agent->m_repairBias);
-
-	if (m_currentPlan.m_chosenPlanType == REPAIR_PLAN_TYPE  && compareUtilityInfo.utility != 0.f)
-	{
-		SkewCurrentPlanUtilityValue(compareUtilityInfo);
-	}
-	if(compareUtilityInfo.utility > highestUtilityInfo.utility)
+	//commit once everything is scored or when we've waited too long and have to go with the best so far
+	bool isEvaluationComplete = m_planEvaluation.m_numPlansEvaluated >= numPlans;
+	if (isEvaluationComplete || m_planEvaluation.m_slicesUsed >= g_maxPlanningSlicesBeforeCommit)
 	{
-		highestUtilityInfo = compareUtilityInfo;
-		chosenOutcome = REPAIR_PLAN_TYPE;
-	}
-	m_utilityHistory.m_lastRepair = compareUtilityInfo.utility; 	//debug info
-
-	//utility for healing agents  ----------------------------------------------
-	compareUtilityInfo = GetHealSelfUtility();
+		//the next evaluation picks up at the first plan this one didn't get to
+		if (numPlans > 0)
+			m_nextPlanEvaluationStartIndex = (m_planEvaluation.m_startPlanIndex + m_planEvaluation.m_numPlansEvaluated) % numPlans;
 
-	if(compareUtilityInfo.utility != 0.f)
-		SkewUtilityForBias(compareUtilityInfo, m_agent->m_healBias);
-
-	if (m_currentPlan.m_chosenPlanType == HEAL_PLAN_TYPE && compareUtilityInfo.utility != 0.f)
-	{
-		SkewCurrentPlanUtilityValue(compareUtilityInfo);
+		CommitPlanEvaluation<SimulationPolicy>();
 	}
-	if(compareUtilityInfo.utility > highestUtilityInfo.utility)
-	{
-		highestUtilityInfo = compareUtilityInfo;
-		chosenOutcome = HEAL_PLAN_TYPE;
-	}
-	//debug info
-	m_utilityHistory.m_lastHeal = compareUtilityInfo.utility;
+}
 
-	//utility for fighting fires  ----------------------------------------------
-	compareUtilityInfo = GetHighestFightFireUtility();
+//  =========================================================================================
+template <typename SimulationPolicy>
+void Planner::BeginPlanEvaluation()
+{
+	m_planEvaluation = PlanEvaluationProgress();
+	m_planEvaluation.m_isInProgress = true;
+	m_planEvaluation.m_startPlanIndex = m_nextPlanEvaluationStartIndex;
 
-	if(compareUtilityInfo.utility != 0.f)
-		SkewUtilityForBias(compareUtilityInfo, m_agent->m_fireFightingBias);
+	//idle is the floor every other plan has to beat
+	m_planEvaluation.m_highestUtilityInfo = GetIdleUtilityInfo();
 
-	if (m_currentPlan.m_chosenPlanType ==  FIGHT_FIRE_PLAN_TYPE && compareUtilityInfo.utility != 0.f)
-	{
-		SkewCurrentPlanUtilityValue(compareUtilityInfo);
-	}
-	if(compareUtilityInfo.utility > highestUtilityInfo.utility)
-	{
-		highestUtilityInfo = compareUtilityInfo;
-		chosenOutcome = FIGHT_FIRE_PLAN_TYPE;
-	}
-	m_utilityHistory.m_lastFightFire = compareUtilityInfo.utility; 	//debug info
+	float randomInput = m_testUtilityRandomStream.GetNextFloatZeroToOne();
+	CalculateTestUtility<SimulationPolicy>(randomInput);
+}
 
+//  =========================================================================================
+template <typename SimulationPolicy>
+void Planner::CommitPlanEvaluation()
+{
 	// set final plan ----------------------------------------------
-	highestUtilityInfo.m_chosenPlanType = chosenOutcome;
+	UtilityInfo highestUtilityInfo = m_planEvaluation.m_highestUtilityInfo;
+	highestUtilityInfo.m_chosenPlanType = m_planEvaluation.m_chosenOutcome;
 	
 	//debug
-	m_utilityHistory.m_chosenOutcome = chosenOutcome;
+	m_utilityHistory.m_chosenOutcome = m_planEvaluation.m_chosenOutcome;
+
+	CancelPlanEvaluation();
 
 	if (!IsPlanSameAsCurrent(highestUtilityInfo))
 	{
 		ClearActionStack();
 		m_agent->ClearCurrentPath();
-		QueueActionsFromCurrentPlan(highestUtilityInfo);
-	}
-	else
-	{
-		int i = 0;//for debug testing
+
+		//queue the follow-up first so it sits under the first step on the stack
+		UtilityInfo followUpInfo;
+		if (TryChainFollowUpPlan<SimulationPolicy>(highestUtilityInfo, followUpInfo))
+		{
+			QueueChainedPlanActions(followUpInfo);
+			m_chainedPlan = followUpInfo;
+			m_chainedPlanStackSize = (int)m_actionStack.size();
+		}
+
+		QueueActionsFromCurrentPlan<SimulationPolicy>(highestUtilityInfo);
 	}
 		
 	//reset necessary flags
 	ResetAgentUpdatePlanTimer();
+}
 
-#ifdef UpdatePlanAnalysis
-	// profiling ----------------------------------------------
-	g_updatePlanAnalysisData->End();
-	//  ---------------------------------------------
-#endif
+//  =========================================================================================
+void Planner::CancelPlanEvaluation()
+{
+	m_planEvaluation = PlanEvaluationProgress();
 }
 
 //  =========================================================================================
@@ -345,18 +289,105 @@ bool Planner::IsPlanSameAsCurrent(const UtilityInfo& newPlan)
 }
 
 //  =========================================================================================
+template <typename SimulationPolicy>
 void Planner::QueueActionsFromCurrentPlan(const UtilityInfo& info)
 {
 	//PROFILER_PUSH();
 
 
 
-#ifdef QueueActionPathingDataAnalysis
-	// profiling ----------------------------------------------
-	g_queueActionPathingAnalysisData->Start();
-	//  ----------------------------------------------
-#endif
+	ScopedAnalysisTimer<QueueActionPathingAnalysisPolicy> analysisTimer(g_queueActionPathingAnalysisData);
+
+	QueueActionsForPlanType(info);
+
+	//decide if we have to queue a MoveAction
+	if (!m_agent->GetIsAtPosition(info.endPosition))
+	{
+		ActionData* data = new ActionData();
+		data->m_action = MoveAction;
+		data->m_finalGoalPosition = info.endPosition;
 
+		m_agent->m_planner->AddActionToStack(data);
+
+		{
+			PROFILER_SCOPE_PUSH("Pathing");
+
+			//use the path we prefetched while busy. otherwise optimized policy will try to skip doing an A* by borrowing someone else's path
+			if (!TryUsePrefetchedPath(info.endPosition))
+				SimulationPolicy::PathingPolicy::QueuePath(this, info.endPosition);
+		}
+
+	}
+}
+
+//  =========================================================================================
+template <typename SimulationPolicy>
+bool Planner::TryChainFollowUpPlan(const UtilityInfo& firstStepInfo, UtilityInfo& outFollowUpInfo)
+{
+	const PlanDefinition* firstStep = PlanDefinition::GetPlanDefinitionByType(firstStepInfo.m_chosenPlanType);
+	if (firstStep == nullptr || firstStep->m_followUpPlanType == NONE_PLAN_TYPE)
+		return false;
+
+	const PlanDefinition* followUp = PlanDefinition::GetPlanDefinitionByType(firstStep->m_followUpPlanType);
+	if (followUp == nullptr)
+		return false;
+
+	//follow-ups are scored from the poi we gather at
+	PointOfInterest* firstStepPoi = m_map->GetPointOfInterestById(firstStepInfo.targetEntityId);
+	if (firstStepPoi == nullptr)
+		return false;
+
+	//project the agent standing at the first step's poi carrying a full load of what it needs
+	float projectedInputs[NUM_UTILITY_INPUTS];
+	FillAgentUtilityInputs(projectedInputs);
+	if (followUp->m_requiredInputType != NUM_UTILITY_INPUTS)
+		projectedInputs[followUp->m_requiredInputType] = 1.f;
+
+	m_projectedOriginPointOfInterest = firstStepPoi;
+	outFollowUpInfo = EvaluatePlanDefinition<SimulationPolicy>(*followUp, projectedInputs);
+	m_projectedOriginPointOfInterest = nullptr;
+
+	if (outFollowUpInfo.utility == 0.f)
+		return false;
+
+	SkewUtilityForBias(outFollowUpInfo, GetBiasValue(followUp->m_biasType));
+	outFollowUpInfo.m_chosenPlanType = followUp->m_planType;
+
+	//only commit to the second step if it beats doing nothing
+	return outFollowUpInfo.utility > CalculateIdleUtility();
+}
+
+//  =========================================================================================
+void Planner::QueueChainedPlanActions(const UtilityInfo& info)
+{
+	QueueActionsForPlanType(info);
+
+	//we won't be standing here when this step starts so always walk. MoveAction finds (or picks up a prefetched) path once it's on top
+	ActionData* data = new ActionData();
+	data->m_action = MoveAction;
+	data->m_finalGoalPosition = info.endPosition;
+
+	AddActionToStack(data);
+}
+
+//  =========================================================================================
+void Planner::UpdateChainedPlan()
+{
+	if (m_chainedPlanStackSize < 0 || (int)m_actionStack.size() > m_chainedPlanStackSize)
+		return;
+
+	//first step is done. the follow-up is now what we're working on
+	m_currentPlan = m_chainedPlan;
+	m_chainedPlanStackSize = -1;
+
+	ResetAgentUpdatePlanTimer();
+}
+
+//  =============================================================================
+// Queue Actions Functions
+//  =============================================================================
+void Planner::QueueActionsForPlanType(const UtilityInfo& info)
+{
 	switch (info.m_chosenPlanType)
 	{
 	case GATHER_ARROWS_PLAN_TYPE:
@@ -387,44 +418,9 @@ void Planner::QueueActionsFromCurrentPlan(const UtilityInfo& info)
 		//idle QueueIdleAction(info);
 		break;
 	}
-
-	//decide if we have to queue a MoveAction
-	if (!m_agent->GetIsAtPosition(info.endPosition))
-	{
-		ActionData* data = new ActionData();
-		data->m_action = MoveAction;
-		data->m_finalGoalPosition = info.endPosition;
-
-		m_agent->m_planner->AddActionToStack(data);
-
-		{
-			PROFILER_SCOPE_PUSH("Pathing");
-
-			//figure out if we can skip doing an A* by borrowing someone else's path
-			if (GetIsOptimized())
-			{
-				//PROFILER_PUSH();
-				bool success = FindAgentAndCopyPath(info.endPosition);
-			}
-			else
-			{
-				//PROFILER_PUSH();
-				m_agent->GetPathToDestination(info.endPosition);
-			}
-		}
-
-#ifdef QueueActionPathingDataAnalysis
-		// profiling ----------------------------------------------
-		g_queueActionPathingAnalysisData->End();
-		//  ---------------------------------------------
-#endif
-
-	}
 }
 
-//  =============================================================================
-// Queue Actions Functions
-//  =============================================================================
+//  =========================================================================================
 void Planner::QueueGatherArrowsAction(const UtilityInfo& info)
 {
 	ActionData* gatherActionData = new ActionData();
@@ -552,404 +548,252 @@ std::string Planner::GetPlanTypeAsText()
 }
 
 //  =========================================================================================
-// Get utilities
+// Plan program evaluation
 //  =========================================================================================
-UtilityInfo Planner::GetHighestGatherArrowsUtility()
+template <typename SimulationPolicy>
+UtilityInfo Planner::EvaluatePlanDefinition(const PlanDefinition& plan, float* utilityInputs)
 {
-	UtilityInfo highestGatherArrowsUtility;
+	UtilityInfo highestUtilityInfo;
 
-	/*if (GetIsOptimized())
-	{*/
-		if (m_agent->m_arrowCount == g_maxResourceCarryAmount)
-		{
-			return highestGatherArrowsUtility;
-		}
-	//}
-
-	if (m_map->m_armories.size() > 0)
+	//easy out if we don't have what this plan spends (ex: no lumber to repair with)
+	if (plan.m_requiredInputType != NUM_UTILITY_INPUTS && utilityInputs[plan.m_requiredInputType] == 0.f)
 	{
-		for (int armoryIndex = 0; armoryIndex < (int)m_map->m_armories.size(); ++armoryIndex)
-		{
-			UtilityInfo infoForBuilding = GetGatherUitlityPerBuilding(m_map->m_armories[armoryIndex]);
-			if (infoForBuilding.utility > highestGatherArrowsUtility.utility)
-			{
-				highestGatherArrowsUtility = infoForBuilding;
-			}
-		}
+		return highestUtilityInfo;
 	}
 
-	return highestGatherArrowsUtility;
-}
+	switch (plan.m_targetType)
+	{
+	case ARMORY_PLAN_TARGET:
+		EvaluatePointOfInterestTargets<SimulationPolicy>(plan, m_map->m_armories, utilityInputs, highestUtilityInfo);
+		break;
+	case LUMBERYARD_PLAN_TARGET:
+		EvaluatePointOfInterestTargets<SimulationPolicy>(plan, m_map->m_lumberyards, utilityInputs, highestUtilityInfo);
+		break;
+	case MED_STATION_PLAN_TARGET:
+		EvaluatePointOfInterestTargets<SimulationPolicy>(plan, m_map->m_medStations, utilityInputs, highestUtilityInfo);
+		break;
+	case WELL_PLAN_TARGET:
+		EvaluatePointOfInterestTargets<SimulationPolicy>(plan, m_map->m_wells, utilityInputs, highestUtilityInfo);
+		break;
+	case POINT_OF_INTEREST_PLAN_TARGET:
+		EvaluatePointOfInterestTargets<SimulationPolicy>(plan, m_map->m_pointsOfInterest, utilityInputs, highestUtilityInfo);
+		break;
+	case FIRE_PLAN_TARGET:
+		EvaluateFireTargets<SimulationPolicy>(plan, utilityInputs, highestUtilityInfo);
+		break;
+	case SELF_PLAN_TARGET:
+	{
+		utilityInputs[DISTANCE_TO_TARGET_UTILITY_INPUT] = 0.f;
+		utilityInputs[TARGET_HEALTH_UTILITY_INPUT] = utilityInputs[AGENT_HEALTH_UTILITY_INPUT];
 
-//  =========================================================================================
-UtilityInfo Planner::GetHighestGatherLumberUtility()
-{
-	UtilityInfo highestGatherLumberUtility;
+		highestUtilityInfo.utility = EvaluateConsiderations<SimulationPolicy>(plan, utilityInputs);
+		highestUtilityInfo.targetEntityId = m_agent->m_id;
+		highestUtilityInfo.endPosition = GetEvaluationOrigin();
+		break;
+	}
+	case MAP_EDGE_PLAN_TARGET:
+	{
+		Vector2 nearestWallPosition = Vector2(0.5f, 0.5f) + (Vector2)GetNearestTileCoordinateOfMapEdgeFromCoordinate((IntVector2)GetEvaluationOrigin());
 
-	/*if (GetIsOptimized())
-	{*/
-		if (m_agent->m_lumberCount == g_maxResourceCarryAmount)
-		{
-			return highestGatherLumberUtility;
-		}
-	//}
+		utilityInputs[DISTANCE_TO_TARGET_UTILITY_INPUT] = GetNormalizedDistanceToPosition(nearestWallPosition);
+		utilityInputs[TARGET_HEALTH_UTILITY_INPUT] = 1.f;
 
-	if (m_map->m_lumberyards.size() > 0)
-	{
-		for (int lumberyardIndex = 0; lumberyardIndex < (int)m_map->m_lumberyards.size(); ++lumberyardIndex)
-		{
-			UtilityInfo infoForBuilding = GetGatherUitlityPerBuilding(m_map->m_lumberyards[lumberyardIndex]);
-			if (infoForBuilding.utility > highestGatherLumberUtility.utility)
-			{
-				highestGatherLumberUtility = infoForBuilding;
-			}
-		}
+		highestUtilityInfo.utility = EvaluateConsiderations<SimulationPolicy>(plan, utilityInputs);
+		highestUtilityInfo.endPosition = nearestWallPosition;
+		break;
+	}
 	}
 
-	return highestGatherLumberUtility;
+	return highestUtilityInfo;
 }
 
 //  =========================================================================================
-UtilityInfo Planner::GetHighestGatherBandagesUtility()
+template <typename SimulationPolicy>
+void Planner::EvaluatePointOfInterestTargets(const PlanDefinition& plan, const std::vector<PointOfInterest*>& pointsOfInterest, float* utilityInputs, UtilityInfo& outHighestUtilityInfo)
 {
-	UtilityInfo highestGatherBandagesUtility;
+	for (int poiIndex = 0; poiIndex < (int)pointsOfInterest.size(); ++poiIndex)
+	{
+		PointOfInterest* poi = pointsOfInterest[poiIndex];
 
-	/*if (GetIsOptimized())
-	{*/
-		if (m_agent->m_bandageCount == g_maxResourceCarryAmount)
-		{
-			return highestGatherBandagesUtility;
-		}
-	//}
+		utilityInputs[DISTANCE_TO_TARGET_UTILITY_INPUT] = GetNormalizedDistanceToPointOfInterest(poi);
+		utilityInputs[TARGET_HEALTH_UTILITY_INPUT] = (float)poi->m_health / (float)g_maxHealth;
 
-	if (m_map->m_medStations.size() > 0)
-	{
-		for (int medStationIndex = 0; medStationIndex < (int)m_map->m_medStations.size(); ++medStationIndex)
+		float utility = EvaluateConsiderations<SimulationPolicy>(plan, utilityInputs);
+		if (utility > outHighestUtilityInfo.utility)
 		{
-			UtilityInfo infoForBuilding = GetGatherUitlityPerBuilding(m_map->m_medStations[medStationIndex]);
-			if (infoForBuilding.utility > highestGatherBandagesUtility.utility)
-			{
-				highestGatherBandagesUtility = infoForBuilding;
-			}
+			outHighestUtilityInfo.utility = utility;
+			outHighestUtilityInfo.endPosition = poi->m_accessPosition;
+			outHighestUtilityInfo.targetEntityId = poi->m_id;
 		}
 	}
-
-	return highestGatherBandagesUtility;
 }
 
 //  =========================================================================================
-UtilityInfo Planner::GetHighestGatherWaterUtility()
+template <typename SimulationPolicy>
+void Planner::EvaluateFireTargets(const PlanDefinition& plan, float* utilityInputs, UtilityInfo& outHighestUtilityInfo)
 {
-	UtilityInfo highestGatherWaterUtility;
+	Fire* highestFire = nullptr;
 
-	/*if (GetIsOptimized())
-	{*/
-	if (m_agent->m_waterCount == g_maxResourceCarryAmount)
-	{
-		return highestGatherWaterUtility;
-	}
-	//}
-
-	if (m_map->m_wells.size() > 0)
+	for (int fireIndex = 0; fireIndex < (int)m_map->m_fires.size(); ++fireIndex)
 	{
-		for (int wellIndex = 0; wellIndex < (int)m_map->m_medStations.size(); ++wellIndex)
-		{
-			UtilityInfo infoForBuilding = GetGatherUitlityPerBuilding(m_map->m_wells[wellIndex]);
-			if (infoForBuilding.utility > highestGatherWaterUtility.utility)
-			{
-				highestGatherWaterUtility = infoForBuilding;
-			}
-		}
-	}
+		Fire* fire = m_map->m_fires[fireIndex];
 
-	return highestGatherWaterUtility;
-}
+		//easy out if the fire is already out
+		if (fire->m_health == 0)
+			continue;
 
-//  =========================================================================================
-UtilityInfo Planner::GetHighestShootUtility()
-{
-	UtilityInfo info;
+		utilityInputs[DISTANCE_TO_TARGET_UTILITY_INPUT] = GetNormalizedDistanceToPosition(fire->m_worldPosition);
+		utilityInputs[TARGET_HEALTH_UTILITY_INPUT] = (float)fire->m_health / (float)g_maxFireHealth;
 
-	/*if (GetIsOptimized())
-	{*/
-		if (m_map->m_threat == 0 || m_agent->m_arrowCount == 0)
+		float utility = EvaluateConsiderations<SimulationPolicy>(plan, utilityInputs);
+		if (utility > outHighestUtilityInfo.utility)
 		{
-			return info;
+			outHighestUtilityInfo.utility = utility;
+			outHighestUtilityInfo.endPosition = fire->m_worldPosition;
+			outHighestUtilityInfo.targetEntityId = fire->m_id;
+			highestFire = fire;
 		}
-	//}
-
-	Vector2 nearestWallPosition = Vector2(0.5f, 0.5f) + (Vector2)GetNearestTileCoordinateOfMapEdgeFromCoordinate((IntVector2)m_agent->m_position);
-
-	// distance to nearest wall squared ----------------------------------------------
-	float distanceToBuildingSquared = GetDistanceSquared(m_agent->m_position, nearestWallPosition);
-
-	//get max distance
-	float maxDistanceSquared = GetDistanceSquared(Vector2::ZERO, Vector2(m_map->GetDimensions()));
-
-	//normalize distance
-	float normalizedDistance = distanceToBuildingSquared/maxDistanceSquared;
-
-	//apply distance utility formula for utility value
-	float distanceUtility = CalculateDistanceUtility(normalizedDistance);
-
-
-	//normalized threat ----------------------------------------------
-	float normalizedThreat = m_map->m_threat/g_maxThreat;
-
-	//apply shoot utility formula for utility value
-	float threatUtility = CalculateShootUtility(normalizedThreat);
-
+	}
 
-	//combine distance and health utilities for final utility ----------------------------------------------
-	float adjustedShootUtility = distanceUtility * threatUtility;
-	info.utility = adjustedShootUtility;
-	info.endPosition = nearestWallPosition;
+	//if none of them are high (or none exist) return invalid utility
+	if (highestFire == nullptr)
+		return;
 
-	return info;
+	//we have a highest, use its access location (usually precomputed in slack time)
+	outHighestUtilityInfo.endPosition = highestFire->GetAccessPosition();
+	ASSERT_OR_DIE(highestFire->m_hasAccessPosition, "NO ACCESSIBLE PATH TO THE FIRE");
 }
 
 //  =========================================================================================
-UtilityInfo Planner::GetHighestRepairUtility()
+template <typename SimulationPolicy>
+float Planner::EvaluateConsiderations(const PlanDefinition& plan, const float* utilityInputs)
 {
-	UtilityInfo highestRepairUtility;
-
-	//if (GetIsOptimized())
-	//{
-		if (m_agent->m_lumberCount == 0)
-		{
-			return highestRepairUtility;
-		}
-	//}
+	float utility = 1.f;
 
-	for (int buildingIndex = 0; buildingIndex < (int)m_map->m_pointsOfInterest.size(); ++buildingIndex)
+	int endIndex = plan.m_firstConsiderationIndex + plan.m_numConsiderations;
+	for (int considerationIndex = plan.m_firstConsiderationIndex; considerationIndex < endIndex; ++considerationIndex)
 	{
-		UtilityInfo utilityInfoForBuilding = GetRepairUtilityPerBuilding(m_map->m_pointsOfInterest[buildingIndex]);
-		if (utilityInfoForBuilding.utility > highestRepairUtility.utility)
-		{
-			highestRepairUtility = utilityInfoForBuilding;
-		}
+		const UtilityConsideration& consideration = PlanDefinition::s_considerations[considerationIndex];
+		utility *= consideration.m_weight * EvaluateUtilityCurve<SimulationPolicy>(consideration.m_curveType, utilityInputs[consideration.m_inputType]);
+
+		//nothing left can raise a zero product
+		if (utility == 0.f)
+			return 0.f;
 	}
 
-	return highestRepairUtility;
+	return utility;
 }
 
 //  =========================================================================================
-UtilityInfo Planner::GetHealSelfUtility()
+template <typename SimulationPolicy>
+float Planner::EvaluateUtilityCurve(eUtilityCurveType curveType, float input)
 {
-	UtilityInfo healUtilityInfo;
-
-	//if (GetIsOptimized())
-	//{
-	if (m_agent->m_bandageCount == 0)
-	{
-		return healUtilityInfo;
-	}
-	//}
-
-	//building health ----------------------------------------------
-	float normalizedHealth = m_agent->m_health/g_maxHealth;
-
-	float agentUtility = CalculateAgentHealthUtility(normalizedHealth);
-	healUtilityInfo.utility = agentUtility;
-	healUtilityInfo.targetEntityId = m_agent->m_id;
-	healUtilityInfo.endPosition = m_agent->m_position;
-
-	return healUtilityInfo;
+	switch (curveType)
+	{
+	case DISTANCE_UTILITY_CURVE:
+		return CalculateDistanceUtility<SimulationPolicy>(input);
+	case BUILDING_HEALTH_UTILITY_CURVE:
+		return CalculateBuildingHealthUtility<SimulationPolicy>(input);
+	case AGENT_HEALTH_UTILITY_CURVE:
+		return CalculateAgentHealthUtility<SimulationPolicy>(input);
+	case GATHER_UTILITY_CURVE:
+		return CalculateAgentGatherUtility<SimulationPolicy>(input);
+	case SHOOT_UTILITY_CURVE:
+		return CalculateShootUtility<SimulationPolicy>(input);
+	case LINEAR_UTILITY_CURVE:
+		return input;
+	case INVERSE_LINEAR_UTILITY_CURVE:
+		return 1.f - input;
+	}
+
+	return 0.f;
 }
 
 //  =========================================================================================
-UtilityInfo Planner::GetHighestFightFireUtility()
+UtilityStorage* Planner::GetUtilityStorageForCurve(eUtilityCurveType curveType)
 {
-	UtilityInfo highestFireUtility;
-
-	//if (GetIsOptimized())
-	//{
-	if (m_agent->m_waterCount == 0)
-	{
-		return highestFireUtility;
-	}
-	//}
-
-	for (int fireIndex = 0; fireIndex < (int)m_map->m_fires.size(); ++fireIndex)
-	{
-		UtilityInfo utilityInfoPerFire = GetFightFireUtilityPerFire(m_map->m_fires[fireIndex]);
-		if (utilityInfoPerFire.utility > highestFireUtility.utility)
-		{
-			highestFireUtility = utilityInfoPerFire;
-		}
-	}
-
-	//if none of them are high (or none exist) return invalid utility
-	if(highestFireUtility.targetEntityId == -1)
-		return highestFireUtility;
-
-	//we have a highest, determine if the access locaiton is valid
-	highestFireUtility.endPosition = GetBestAccessLocationForFireAtPosition(highestFireUtility.endPosition);
-	return highestFireUtility;
+	switch (curveType)
+	{
+	case DISTANCE_UTILITY_CURVE:
+		return m_distanceUtilityStorage;
+	case BUILDING_HEALTH_UTILITY_CURVE:
+		return m_buildingHealthUtilityStorage;
+	case AGENT_HEALTH_UTILITY_CURVE:
+		return m_agentHealthUitilityStorage;
+	case GATHER_UTILITY_CURVE:
+		return m_agentGatherUtilityStorage;
+	case SHOOT_UTILITY_CURVE:
+		return m_shootUtilityStorageUtility;
+	}
+
+	//linear curves aren't memoized
+	return nullptr;
 }
 
-//  =============================================================================
-UtilityInfo Planner::GetRepairUtilityPerBuilding(PointOfInterest* poi)
+//  =========================================================================================
+void Planner::FillAgentUtilityInputs(float* outUtilityInputs)
 {
-	UtilityInfo info;
-	info.utility = 0.f;
-	info.endPosition = poi->m_accessPosition;
-	info.targetEntityId = poi->m_id;
-
-	//easy out if building is at full health
-	if (poi->m_health == g_maxHealth || m_agent->m_lumberCount == 0)
-	{
-		return info;
-	}
-
-	// distance to building squared ----------------------------------------------
-	float distanceToBuildingSquared = GetDistanceSquared(m_agent->m_position, poi->m_accessPosition);
-	
-	//get max distance
-	float maxDistanceSquared = GetDistanceSquared(Vector2::ZERO, Vector2(m_map->GetDimensions()));
-
-	//normalize distance
-	float normalizedDistance = distanceToBuildingSquared/maxDistanceSquared;
-
-	//apply distance utility formula for utility value
-	float distanceUtility = CalculateDistanceUtility(normalizedDistance);
-
-
-	//building health ----------------------------------------------
-	float normalizedHealth = poi->m_health/g_maxHealth;
-
-	//apply health utility formula for utility value
-	float healthUtility = CalculateBuildingHealthUtility(normalizedHealth);
-
-
-	// combine distance and health utilities for final utility ----------------------------------------------
-	float adjustedUtility = distanceUtility * healthUtility;
-	info.utility = adjustedUtility;
-
-	return info;
+	float maxResourceCarryAmount = (float)g_maxResourceCarryAmount;
+
+	outUtilityInputs[DISTANCE_TO_TARGET_UTILITY_INPUT] = 0.f;
+	outUtilityInputs[TARGET_HEALTH_UTILITY_INPUT] = 0.f;
+	outUtilityInputs[AGENT_HEALTH_UTILITY_INPUT] = (float)m_agent->m_health / (float)g_maxHealth;
+	outUtilityInputs[THREAT_UTILITY_INPUT] = m_map->m_threat / g_maxThreat;
+	outUtilityInputs[ARROW_COUNT_UTILITY_INPUT] = (float)m_agent->m_arrowCount / maxResourceCarryAmount;
+	outUtilityInputs[LUMBER_COUNT_UTILITY_INPUT] = (float)m_agent->m_lumberCount / maxResourceCarryAmount;
+	outUtilityInputs[BANDAGE_COUNT_UTILITY_INPUT] = (float)m_agent->m_bandageCount / maxResourceCarryAmount;
+	outUtilityInputs[WATER_COUNT_UTILITY_INPUT] = (float)m_agent->m_waterCount / maxResourceCarryAmount;
 }
 
 //  =========================================================================================
-UtilityInfo Planner::GetFightFireUtilityPerFire(Fire* fire)
+float Planner::GetNormalizedDistanceToPosition(const Vector2& position)
 {
-	UtilityInfo info;
-	info.utility = 0.f;
-	info.endPosition = fire->m_worldPosition;
-	info.targetEntityId = fire->m_id;
-
-	//easy out if building is at full health
-	if (fire->m_health == 0 || m_agent->m_waterCount == 0)
-	{
-		return info;
-	}
-
-	// distance to building squared ----------------------------------------------
-	float distanceToBuildingSquared = GetDistanceSquared(m_agent->m_position, fire->m_worldPosition);
+	float distanceSquared = GetDistanceSquared(GetEvaluationOrigin(), position);
 
 	//get max distance
 	float maxDistanceSquared = GetDistanceSquared(Vector2::ZERO, Vector2(m_map->GetDimensions()));
 
-	//normalize distance
-	float normalizedDistance = distanceToBuildingSquared/maxDistanceSquared;
-
-	//apply distance utility formula for utility value
-	float distanceUtility = CalculateDistanceUtility(normalizedDistance);
-
-
-	//building health ----------------------------------------------
-	float normalizedHealth = fire->m_health/g_maxHealth;
-
-	//apply health utility formula for utility value
-	//float healthUtility = CalculateBuildingHealthUtility(normalizedHealth);
-
-	// combine distance and health utilities for final utility ----------------------------------------------
-	float adjustedUtility = distanceUtility;
-	info.utility = adjustedUtility;
-
-	return info;
+	return distanceSquared / maxDistanceSquared;
 }
 
-//  =============================================================================
-UtilityInfo Planner::GetGatherUitlityPerBuilding(PointOfInterest* poi)
+//  =========================================================================================
+float Planner::GetNormalizedDistanceToPointOfInterest(PointOfInterest* poi)
 {
-	UtilityInfo info;
-	info.utility = 0.f;
-	info.endPosition = poi->m_accessPosition;
-	info.targetEntityId = poi->m_id;
+	if (m_projectedOriginPointOfInterest == nullptr)
+		return GetNormalizedDistanceToPosition(poi->m_accessPosition);
 
-	int inventoryCountPerType = 0;
-	switch (poi->m_type)
-	{
-	case ARMORY_POI_TYPE:
-		inventoryCountPerType = m_agent->m_arrowCount;
-		break;
-	case LUMBERYARD_POI_TYPE:
-		inventoryCountPerType = m_agent->m_lumberCount;
-		break;
-	case MED_STATION_POI_TYPE:
-		inventoryCountPerType = m_agent->m_bandageCount;
-		break;
-	case WELL_POI_TYPE:
-		inventoryCountPerType = m_agent->m_waterCount;
-		break;
-	}
-
-	//easy out if we don't need to gather for this building type
-	if (inventoryCountPerType == g_maxResourceCarryAmount)
-	{
-		return info;
-	}
-
-	// distance to building squared ----------------------------------------------
-	float distanceToBuildingSquared = GetDistanceSquared(m_agent->m_position, poi->m_accessPosition);
-
-	//get max distance
+	//poi to poi uses the precomputed path distance so chains account for walls
+	float pathDistance = m_map->GetPathDistanceBetweenPointsOfInterest(m_projectedOriginPointOfInterest, poi);
 	float maxDistanceSquared = GetDistanceSquared(Vector2::ZERO, Vector2(m_map->GetDimensions()));
 
-	//normalize distance
-	float normalizedDistance = distanceToBuildingSquared/maxDistanceSquared;
-
-	//apply distance utility formula for utility value
-	float distanceUtility = CalculateDistanceUtility(normalizedDistance);
-
-
-	//resource gather utility ----------------------------------------------
-	float normalizedResourceAmount = inventoryCountPerType/g_maxResourceCarryAmount;
-
-	//apply gather utility formula for utility value
-	float gatherUtility = CalculateAgentGatherUtility(normalizedResourceAmount);
-
+	return Clamp((pathDistance * pathDistance) / maxDistanceSquared, 0.f, 1.f);
+}
 
-	// combine distance and health utilities for final utility ----------------------------------------------
-	float adjustedUtility = distanceUtility * gatherUtility;
-	info.utility = adjustedUtility;
+//  =========================================================================================
+Vector2 Planner::GetEvaluationOrigin()
+{
+	if (m_projectedOriginPointOfInterest != nullptr)
+		return m_projectedOriginPointOfInterest->m_accessPosition;
 
-	return info;
+	return m_agent->m_position;
 }
 
 //  =========================================================================================
-UtilityInfo Planner::GetHealUtilityPerAgent(Agent* agent)
+float Planner::GetBiasValue(eBiasType biasType)
 {
-	UtilityInfo info;
-	info.utility = 0.f;
-	info.endPosition = agent->m_position;
-	info.targetEntityId = agent->m_id;
-
-	//easy out if agent is at full health or if we don't have bandages
-	if (agent->m_health == g_maxHealth || m_agent->m_bandageCount == 0)
+	switch (biasType)
 	{
-		return info;
+	case COMBAT_BIAS:
+		return m_agent->m_combatBias;
+	case REPAIR_BIAS:
+		return m_agent->m_repairBias;
+	case HEAL_BIAS:
+		return m_agent->m_healBias;
+	case FIRE_FIGHTING_BIAS:
+		return m_agent->m_fireFightingBias;
 	}
 
-	//building health ----------------------------------------------
-	float normalizedHealth = agent->m_health/g_maxHealth;
-
-	//apply health utility formula for utility value
-	float healthUtility = CalculateAgentHealthUtility(normalizedHealth);
-
-	info.utility = healthUtility;
-
-	return info;
+	return 0.f;
 }
 
 //  =============================================================================
@@ -976,157 +820,76 @@ void Planner::SkewUtilityForBias(UtilityInfo& outInfo, float biasValue)
 //  =========================================================================================
 //  Utility Function Calculations
 //  =========================================================================================
+template <typename SimulationPolicy>
 float Planner::CalculateDistanceUtility(float normalizedDistance)
 {
 
-#ifdef MemoizationDataAnalysis
-	// profiling ----------------------------------------------
-	g_memoizationAnalysisData->Start();
-	//  ----------------------------------------------
-#endif
+	ScopedAnalysisTimer<MemoizationAnalysisPolicy> analysisTimer(g_memoizationAnalysisData);
 
 	// dynamic programming solution ----------------------------------------------
 	int outIndex = 0;
-	if (GetIsOptimized())
-	{
-		float outValue;
-		if (m_distanceUtilityStorage->DoesValueExistForInput(normalizedDistance, outValue, outIndex))
-		{
-#ifdef	MemoizationCountDataAnalysis
-			++g_numMemoizationStorageAccesses;
-#endif
-			g_memoizationAnalysisData->End();
-			return outValue;
-		}
-		else
-		{
-#ifdef	MemoizationCountDataAnalysis
-			++g_numMemoizationUtilityCalls;
-#endif
-		}
-	}
-	else
+	float outValue;
+	if (SimulationPolicy::UtilityPolicy::TryGetStoredUtility(m_distanceUtilityStorage, normalizedDistance, outValue, outIndex))
 	{
-#ifdef	MemoizationCountDataAnalysis
-		++g_numMemoizationUtilityCalls;
-#endif
+		MemoizationCountAnalysisPolicy::IncrementCounter(g_numMemoizationStorageAccesses);
+		return outValue;
 	}
+
+	MemoizationCountAnalysisPolicy::IncrementCounter(g_numMemoizationUtilityCalls);
 	//  ----------------------------------------------
 	
-	//  UTILITY FORMULA: ((1-x)^3 * 0.4f) + 0.1f = y 
-	float oneMinusNormalizedDistance = 1 - normalizedDistance;
-	float utility = ((oneMinusNormalizedDistance * oneMinusNormalizedDistance * oneMinusNormalizedDistance) * 0.4f) + 0.1f;
-
+	float utility = CalculateRawCurveUtility(DISTANCE_UTILITY_CURVE, normalizedDistance);
 
 	// dynamic programming solution ----------------------------------------------
-	if (GetIsOptimized())
-	{
-		m_distanceUtilityStorage->StoreValueForInputAtIndex(utility, outIndex);
-	}
+	SimulationPolicy::UtilityPolicy::StoreUtility(m_distanceUtilityStorage, utility, outIndex);
 	//  ----------------------------------------------
 
-#ifdef MemoizationDataAnalysis
-// profiling ----------------------------------------------
-	g_memoizationAnalysisData->End();
-	//  ----------------------------------------------
-#endif
-
 	return utility;
 }
 
 //  =========================================================================================
+template <typename SimulationPolicy>
 float Planner::CalculateBuildingHealthUtility(float normalizedBuildingHealth)
 {
-#ifdef MemoizationDataAnalysis
-	// profiling ----------------------------------------------
-	g_memoizationAnalysisData->Start();
-	//  ----------------------------------------------
-#endif
+	ScopedAnalysisTimer<MemoizationAnalysisPolicy> analysisTimer(g_memoizationAnalysisData);
 
 	// dynamic programming solution ----------------------------------------------
 	int outIndex = 0;
-	if (GetIsOptimized())
-	{
-		float outValue;
-		if (m_buildingHealthUtilityStorage->DoesValueExistForInput(normalizedBuildingHealth, outValue, outIndex))
-		{
-#ifdef	MemoizationCountDataAnalysis
-			++g_numMemoizationStorageAccesses;
-#endif
-			g_memoizationAnalysisData->End();
-			return outValue;
-		}
-		else
-		{
-#ifdef	MemoizationCountDataAnalysis
-			++g_numMemoizationUtilityCalls;
-#endif
-		}
-	}
-	else
+	float outValue;
+	if (SimulationPolicy::UtilityPolicy::TryGetStoredUtility(m_buildingHealthUtilityStorage, normalizedBuildingHealth, outValue, outIndex))
 	{
-#ifdef	MemoizationCountDataAnalysis
-		++g_numMemoizationUtilityCalls;
-#endif
+		MemoizationCountAnalysisPolicy::IncrementCounter(g_numMemoizationStorageAccesses);
+		return outValue;
 	}
+
+	MemoizationCountAnalysisPolicy::IncrementCounter(g_numMemoizationUtilityCalls);
 	//  ----------------------------------------------
 
-	//  UTILITY FORMULA: ((1 - x)^2x * 0.8) = y
-	float oneMinusNormalizedBuildingHealth = 1.f - normalizedBuildingHealth;
-	float poweredHealth = std::pow(oneMinusNormalizedBuildingHealth, 2.f * normalizedBuildingHealth);
-	float utility = poweredHealth * 0.8f;
+	float utility = CalculateRawCurveUtility(BUILDING_HEALTH_UTILITY_CURVE, normalizedBuildingHealth);
 
 	// dynamic programming solution ----------------------------------------------
-	if (GetIsOptimized())
-	{
-		m_buildingHealthUtilityStorage->StoreValueForInputAtIndex(utility, outIndex);
-	}
-	//  ----------------------------------------------
-
-#ifdef MemoizationDataAnalysis
-	// profiling ----------------------------------------------
-	g_memoizationAnalysisData->End();
+	SimulationPolicy::UtilityPolicy::StoreUtility(m_buildingHealthUtilityStorage, utility, outIndex);
 	//  ----------------------------------------------
-#endif
 
 	return utility;
 }
 
 //  =========================================================================================
+template <typename SimulationPolicy>
 float Planner::CalculateTestUtility(float testValue)
 {
-#ifdef TestExtremeMemoizationDataAnalysis
-	// profiling ----------------------------------------------
-	g_testExtremeMemoizationAnalysisData->Start();
-	//  ----------------------------------------------
-#endif
+	ScopedAnalysisTimer<TestExtremeMemoizationAnalysisPolicy> analysisTimer(g_testExtremeMemoizationAnalysisData);
 
 	// dynamic programming solution ----------------------------------------------
 	int outIndex = 0;
-	if (GetIsOptimized())
-	{
-		float outValue;
-		if (m_testUtilityStorage->DoesValueExistForInput(testValue, outValue, outIndex))
-		{
-#ifdef	TestExtremeMemoizationDataAnalysis
-			++g_numTestMemoizationStorageAccesses;
-#endif
-			g_testExtremeMemoizationAnalysisData->End();
-			return outValue;
-		}
-		else
-		{
-#ifdef	TestExtremeMemoizationDataAnalysis
-			++g_numTestMemoizationExtremeUtilityCalls;
-#endif
-		}
-	}
-	else
+	float outValue;
+	if (SimulationPolicy::UtilityPolicy::TryGetStoredUtility(m_testUtilityStorage, testValue, outValue, outIndex))
 	{
-#ifdef	TestExtremeMemoizationDataAnalysis
-		++g_numTestMemoizationExtremeUtilityCalls;
-#endif
+		TestExtremeMemoizationAnalysisPolicy::IncrementCounter(g_numTestMemoizationStorageAccesses);
+		return outValue;
 	}
+
+	TestExtremeMemoizationAnalysisPolicy::IncrementCounter(g_numTestMemoizationExtremeUtilityCalls);
 	//  ----------------------------------------------
 
 	//  UTILITY FORMULA: ((1 - x)^2x * 0.8) = y
@@ -1135,205 +898,130 @@ float Planner::CalculateTestUtility(float testValue)
 	for (int i = 0; i < num; ++i)
 	{
 		//function call, subtraction, multiply, rand() call, division, addition
-		utility += GetRandomFloatInRange(0.f, 1.f);
+		utility += m_testUtilityRandomStream.GetNextFloatInRange(0.f, 1.f);
 	}
 
 	utility /= num;
 
 	// dynamic programming solution ----------------------------------------------
-	if (GetIsOptimized())
-	{
-		m_testUtilityStorage->StoreValueForInputAtIndex(utility, outIndex);
-	}
-	//  ----------------------------------------------
-
-#ifdef TestExtremeMemoizationDataAnalysis
-	// profiling ----------------------------------------------
-	g_testExtremeMemoizationAnalysisData->End();
+	SimulationPolicy::UtilityPolicy::StoreUtility(m_testUtilityStorage, utility, outIndex);
 	//  ----------------------------------------------
-#endif
 
 	return utility;
 }
 
 //  =============================================================================
+template <typename SimulationPolicy>
 float Planner::CalculateAgentHealthUtility(float normalizedAgentHealth)
 {
-#ifdef MemoizationDataAnalysis
-	// profiling ----------------------------------------------
-	g_memoizationAnalysisData->Start();
-	//  ----------------------------------------------
-#endif
+	ScopedAnalysisTimer<MemoizationAnalysisPolicy> analysisTimer(g_memoizationAnalysisData);
 
 	// dynamic programming solution ----------------------------------------------
 	int outIndex = 0;
-	if (GetIsOptimized())
-	{
-		float outValue;
-		if (m_agentHealthUitilityStorage->DoesValueExistForInput(normalizedAgentHealth, outValue, outIndex))
-		{
-#ifdef	MemoizationCountDataAnalysis
-			++g_numMemoizationStorageAccesses;
-#endif
-			g_memoizationAnalysisData->End();
-			return outValue;
-		}
-		else
-		{
-#ifdef	MemoizationCountDataAnalysis
-			++g_numMemoizationUtilityCalls;
-#endif
-		}
-	}
-	else
+	float outValue;
+	if (SimulationPolicy::UtilityPolicy::TryGetStoredUtility(m_agentHealthUitilityStorage, normalizedAgentHealth, outValue, outIndex))
 	{
-#ifdef	MemoizationCountDataAnalysis
-		++g_numMemoizationUtilityCalls;
-#endif
+		MemoizationCountAnalysisPolicy::IncrementCounter(g_numMemoizationStorageAccesses);
+		return outValue;
 	}
-	//  ----------------------------------------------
 
-	//  UTILITY FORMULA: ((1 - x)^2x * 0.8) = y
-	float oneMinusNormalizedAgentHealth= 1.f - normalizedAgentHealth;
+	MemoizationCountAnalysisPolicy::IncrementCounter(g_numMemoizationUtilityCalls);
+	//  ----------------------------------------------
 
-	float poweredHealth = std::pow(oneMinusNormalizedAgentHealth, 2.f * normalizedAgentHealth);
-	float utility = poweredHealth * 0.8f;
+	float utility = CalculateRawCurveUtility(AGENT_HEALTH_UTILITY_CURVE, normalizedAgentHealth);
 
 	// dynamic programming solution ----------------------------------------------
-	if (GetIsOptimized())
-	{
-		m_agentHealthUitilityStorage->StoreValueForInputAtIndex(utility, outIndex);
-	}
-	//  ----------------------------------------------
-
-#ifdef MemoizationDataAnalysis
-// profiling ----------------------------------------------
-	g_memoizationAnalysisData->End();
+	SimulationPolicy::UtilityPolicy::StoreUtility(m_agentHealthUitilityStorage, utility, outIndex);
 	//  ----------------------------------------------
-#endif
 
 	return utility;
 }
 
 //  =============================================================================
+template <typename SimulationPolicy>
 float Planner::CalculateAgentGatherUtility(float normalizedResourceCarryAmount)
 {
-#ifdef MemoizationDataAnalysis
-	// profiling ----------------------------------------------
-	g_memoizationAnalysisData->Start();
-	//  ----------------------------------------------
-#endif
+	ScopedAnalysisTimer<MemoizationAnalysisPolicy> analysisTimer(g_memoizationAnalysisData);
 
 	// dynamic programming solution ----------------------------------------------
 	int outIndex = 0;
-	if (GetIsOptimized())
-	{
-		float outValue;
-		if (m_agentGatherUtilityStorage->DoesValueExistForInput(normalizedResourceCarryAmount, outValue, outIndex))
-		{
-#ifdef	MemoizationCountDataAnalysis
-			++g_numMemoizationStorageAccesses;
-#endif
-			g_memoizationAnalysisData->End();
-			return outValue;
-		}
-		else
-		{
-#ifdef	MemoizationCountDataAnalysis
-			++g_numMemoizationUtilityCalls;
-#endif
-		}
-	}
-	else
+	float outValue;
+	if (SimulationPolicy::UtilityPolicy::TryGetStoredUtility(m_agentGatherUtilityStorage, normalizedResourceCarryAmount, outValue, outIndex))
 	{
-#ifdef	MemoizationCountDataAnalysis
-		++g_numMemoizationUtilityCalls;
-#endif
+		MemoizationCountAnalysisPolicy::IncrementCounter(g_numMemoizationStorageAccesses);
+		return outValue;
 	}
+
+	MemoizationCountAnalysisPolicy::IncrementCounter(g_numMemoizationUtilityCalls);
 	//  ----------------------------------------------
 
-	//  UTILITY FORMULA: ((1-x)^8x * 0.8) = y
-	float oneMinusNormalizedGatherUtility = 1.f - normalizedResourceCarryAmount;
-	
-	float poweredGather = std::pow(oneMinusNormalizedGatherUtility, 8.f * normalizedResourceCarryAmount);
-	float utility = poweredGather * 0.8f;
+	float utility = CalculateRawCurveUtility(GATHER_UTILITY_CURVE, normalizedResourceCarryAmount);
 
 	// dynamic programming solution ----------------------------------------------
-	if (GetIsOptimized())
-	{
-		m_agentGatherUtilityStorage->StoreValueForInputAtIndex(utility, outIndex);
-	}
+	SimulationPolicy::UtilityPolicy::StoreUtility(m_agentGatherUtilityStorage, utility, outIndex);
 	//  ----------------------------------------------
 
-#ifdef MemoizationDataAnalysis
-// profiling ----------------------------------------------
-	g_memoizationAnalysisData->End();
-	//  ----------------------------------------------
-#endif
-
 	return utility;
 }
 
 //  =============================================================================
+template <typename SimulationPolicy>
 float Planner::CalculateShootUtility(float normalizedThreatUtility)
 {
 
-#ifdef MemoizationDataAnalysis
-	// profiling ----------------------------------------------
-	g_memoizationAnalysisData->Start();
-	//  ----------------------------------------------
-#endif
+	ScopedAnalysisTimer<MemoizationAnalysisPolicy> analysisTimer(g_memoizationAnalysisData);
 
 	// dynamic programming solution ----------------------------------------------
 	int outIndex = 0;
-	if (GetIsOptimized())
+	float outValue;
+	if (SimulationPolicy::UtilityPolicy::TryGetStoredUtility(m_shootUtilityStorageUtility, normalizedThreatUtility, outValue, outIndex))
 	{
-		float outValue;
-		if (m_shootUtilityStorageUtility->DoesValueExistForInput(normalizedThreatUtility, outValue, outIndex))
-		{
-#ifdef	MemoizationCountDataAnalysis
-			++g_numMemoizationStorageAccesses;
-#endif
-			g_memoizationAnalysisData->End();
-			return outValue;
-		}			
-		else
-		{
-#ifdef	MemoizationCountDataAnalysis
-			++g_numMemoizationUtilityCalls;
-#endif
-		}
+		MemoizationCountAnalysisPolicy::IncrementCounter(g_numMemoizationStorageAccesses);
+		return outValue;
 	}
-	else
-	{
-#ifdef	MemoizationCountDataAnalysis
-		++g_numMemoizationUtilityCalls;
-#endif
-	}
-	//  ----------------------------------------------
 
-	//  UTILITY FORMULA: ((1-(1-x)^2x) * 0.8 = y
-	float oneMinusNormalizedThreatUtility = 1.f - normalizedThreatUtility;
+	MemoizationCountAnalysisPolicy::IncrementCounter(g_numMemoizationUtilityCalls);
+	//  ----------------------------------------------
 
-	float poweredThreat = 1.f - std::pow(oneMinusNormalizedThreatUtility, 2.f * normalizedThreatUtility);
-	float utility = poweredThreat * 0.8f;
+	float utility = CalculateRawCurveUtility(SHOOT_UTILITY_CURVE, normalizedThreatUtility);
 
 	// dynamic programming solution ----------------------------------------------
-	if (GetIsOptimized())
-	{
-		m_shootUtilityStorageUtility->StoreValueForInputAtIndex(utility, outIndex);
-	}
+	SimulationPolicy::UtilityPolicy::StoreUtility(m_shootUtilityStorageUtility, utility, outIndex);
 	//  ----------------------------------------------
 
-#ifdef MemoizationDataAnalysis
-// profiling ----------------------------------------------
-	g_memoizationAnalysisData->End();
-	//  ----------------------------------------------
-#endif
-
 	return utility;
 }
 
+//  =============================================================================
+float Planner::CalculateRawCurveUtility(eUtilityCurveType curveType, float input)
+{
+	//no storage and no analysis. the memoized Calculate functions above wrap these
+	float oneMinusInput = 1.f - input;
+
+	switch (curveType)
+	{
+	case DISTANCE_UTILITY_CURVE:
+		//  UTILITY FORMULA: ((1-x)^3 * 0.4f) + 0.1f = y 
+		return ((oneMinusInput * oneMinusInput * oneMinusInput) * 0.4f) + 0.1f;
+	case BUILDING_HEALTH_UTILITY_CURVE:
+	case AGENT_HEALTH_UTILITY_CURVE:
+		//  UTILITY FORMULA: ((1 - x)^2x * 0.8) = y
+		return std::pow(oneMinusInput, 2.f * input) * 0.8f;
+	case GATHER_UTILITY_CURVE:
+		//  UTILITY FORMULA: ((1-x)^8x * 0.8) = y
+		return std::pow(oneMinusInput, 8.f * input) * 0.8f;
+	case SHOOT_UTILITY_CURVE:
+		//  UTILITY FORMULA: ((1-(1-x)^2x) * 0.8 = y
+		return (1.f - std::pow(oneMinusInput, 2.f * input)) * 0.8f;
+	case LINEAR_UTILITY_CURVE:
+		return input;
+	case INVERSE_LINEAR_UTILITY_CURVE:
+		return oneMinusInput;
+	}
+
+	return 0.f;
+}
+
 //  =============================================================================
 float Planner::CalculateIdleUtility()
 {
@@ -1434,100 +1122,10 @@ IntVector2 Planner::GetNearestTileCoordinateOfMapEdgeFromCoordinate(const IntVec
 	return closestCoordinate;
 }
 
-//  =========================================================================================
-Vector2 Planner::GetBestAccessLocationForFireAtPosition(const Vector2& fireWorldPosition)
-{
-	//float highestDot = 0.f;
-	//dot for each cardinal direction and find the most resembling to the fire -> agent displacement
-	//north
-	//float northDot = DotProduct(directionToAgent, NORTH_VEC2);
-	//if (northDot > highestDot)
-	//{
-	//	highestDot = northDot;
-	//	direction = NORTH_VEC2;
-	//}
-
-	////south
-	//float northDot = DotProduct(directionToAgent, NORTH_VEC2);
-	//if (northDot > highestDot)
-	//{
-	//	highestDot = northDot;
-	//	direction = SOUTH_VEC2;
-	//}
-
-	////east
-	//float northDot = DotProduct(directionToAgent, NORTH_VEC2);
-	//if (northDot > highestDot)
-	//{
-	//	highestDot = northDot;
-	//	direction = WEST_VEC2;
-	//}
-
-	////west
-	//float northDot = DotProduct(directionToAgent, NORTH_VEC2);
-	//if (northDot > highestDot)
-	//{
-	//	highestDot = northDot;
-	//	direction = EAST_VEC2;
-	//}
-
-	Vector2 accessPosition = fireWorldPosition + NORTH_VEC2;
-
-	//if this coordinate doesn't work, let's just find anyone that works
-	IntVector2 tileCoordinate = m_map->GetTileCoordinateOfPosition(accessPosition);
-	if (m_map->CheckIsCoordinateValid(tileCoordinate))
-	{
-		if (!m_map->IsTileBlockingAtCoordinate(tileCoordinate))
-		{
-			return accessPosition;
-		}
-	}
-
-	accessPosition = fireWorldPosition + SOUTH_VEC2;
-	//if this coordinate doesn't work, let's just find anyone that works
-	tileCoordinate = m_map->GetTileCoordinateOfPosition(accessPosition);
-	if (m_map->CheckIsCoordinateValid(tileCoordinate))
-	{
-		if (!m_map->IsTileBlockingAtCoordinate(tileCoordinate))
-		{
-			return accessPosition;
-		}
-
-	}
-
-	accessPosition = fireWorldPosition + EAST_VEC2;
-
-	//if this coordinate doesn't work, let's just find anyone that works
-	tileCoordinate = m_map->GetTileCoordinateOfPosition(accessPosition);
-	if (m_map->CheckIsCoordinateValid(tileCoordinate))
-	{
-		if (!m_map->IsTileBlockingAtCoordinate(tileCoordinate))
-		{
-			return accessPosition;
-		}
-	}
-
-	accessPosition = fireWorldPosition + WEST_VEC2;
-
-	//if this coordinate doesn't work, let's just find anyone that works
-	tileCoordinate = m_map->GetTileCoordinateOfPosition(accessPosition);
-	if (m_map->CheckIsCoordinateValid(tileCoordinate))
-	{
-		if (!m_map->IsTileBlockingAtCoordinate(tileCoordinate))
-		{
-			return accessPosition;
-		}
-	}
-
-	//if we got this far, we haven't found a valid access position and this fire is blocked in on all sides
-	ASSERT_OR_DIE(false, "NO ACCESSIBLE PATH TO THE FIRE");
-}
-
 //  =========================================================================================
 void Planner::ResetAgentUpdatePlanTimer()
 {
-	m_updatePlanTimer->SetTimer(UPDATE_PLAN_TIMER);
-	m_updatePlanTimer->Reset();
+	m_map->m_timingWheel.StartTimer(m_updatePlanTimer, UPDATE_PLAN_TIMER, false);
 }
 
 //  =========================================================================================
@@ -1537,14 +1135,10 @@ bool Planner::FindAgentAndCopyPath(const Vector2& endPosition)
 {
 	PROFILER_PUSH();
 
-#ifdef CopyPathAnalysis	
-	// profiling ----------------------------------------------
-	g_copyPathAnalysisData->Start();
-	//  ----------------------------------------------
-#endif
+	ScopedAnalysisTimer<CopyPathAnalysisPolicy> analysisTimer(g_copyPathAnalysisData);
 
 	//start of function updates
-	static Disc2 compareDisc = Disc2(0.f, 0.f, g_agentCopyDestinationPositionRadius);
+	Disc2 compareDisc = Disc2(0.f, 0.f, g_agentCopyDestinationPositionRadius);
 	bool didSuccessfullyCopyMatchingAgent = false;
 
 	Vector2 goalPosition = Vector2::ZERO;
@@ -1579,7 +1173,7 @@ bool Planner::FindAgentAndCopyPath(const Vector2& endPosition)
 	
 		Agent* mostResembledAgent = nullptr;
 		float minDistanceSquared = m_map->GetMapDistanceSquared();
-		uint8_t indexIntoMostResembledAgentsPath = UINT8_MAX;
+		int indexIntoMostResembledAgentsPath = INVALID_PATH_INDEX;
 
 		compareDisc.center = goalPosition;
 
@@ -1609,7 +1203,7 @@ bool Planner::FindAgentAndCopyPath(const Vector2& endPosition)
 						{
 							mostResembledAgent = matchingAgents[agentIndex];
 							minDistanceSquared = distanceSquared;
-							indexIntoMostResembledAgentsPath = (uint8_t)agentPathIndex;
+							indexIntoMostResembledAgentsPath = agentPathIndex;
 						}
 					}
 				}
@@ -1635,20 +1229,14 @@ bool Planner::FindAgentAndCopyPath(const Vector2& endPosition)
 	//Generate our own path and queue move action
 	if (!didSuccessfullyCopyMatchingAgent)
 	{
-		m_agent->GetPathToDestination(endPosition);
+		m_agent->GetPathToDestination<CopyPathPolicy>(endPosition);
 	}
 
-#ifdef CopyPathAnalysis
-	// profiling ----------------------------------------------
-	g_copyPathAnalysisData->End();
-	//  ---------------------------------------------
-#endif
-
 	return didSuccessfullyCopyMatchingAgent;
 }
 
 //  =========================================================================================
-void Planner::CopyPath(Agent* toAgent, Agent* fromAgent, uint8_t startingIndex)
+void Planner::CopyPath(Agent* toAgent, Agent* fromAgent, int startingIndex)
 {
 	toAgent->m_currentPath.clear();
 	toAgent->m_currentPathIndex = startingIndex;
@@ -1683,6 +1271,114 @@ Agent* Planner::GetAgentFromSortedList(uint16_t agentIndex, eAgentSortType sortT
 	}
 }
 
+//  =========================================================================================
+template <typename SimulationPolicy>
+bool Planner::PrefetchLikelyNextPath()
+{
+	Vector2 likelyDestination;
+	if (!GetLikelyNextDestination(likelyDestination))
+		return false;
+
+	IntVector2 startCoord = m_map->GetTileCoordinateOfPosition(m_agent->m_position);
+	IntVector2 endCoord = m_map->GetTileCoordinateOfPosition(likelyDestination);
+
+	//easy out if we already have this path for the current grid
+	if (m_prefetchedPath.m_isValid 
+		&& m_prefetchedPath.m_mapGridVersion == m_map->m_mapGridVersion 
+		&& m_prefetchedPath.m_startCoordinate == startCoord 
+		&& m_prefetchedPath.m_endCoordinate == endCoord)
+	{
+		return false;
+	}
+
+	PROFILER_PUSH();
+
+	m_prefetchedPath.m_path.clear();
+	m_prefetchedPath.m_path.push_back(likelyDestination);
+
+	Grid<int> scratchGrid;
+	Grid<int>* mapGrid = SimulationPolicy::PathingPolicy::GetPathingGrid(m_map, scratchGrid);
+
+	m_prefetchedPath.m_isValid = AStarSearchOnGrid(m_prefetchedPath.m_path, startCoord, endCoord, mapGrid, m_map);
+	m_prefetchedPath.m_mapGridVersion = m_map->m_mapGridVersion;
+	m_prefetchedPath.m_startCoordinate = startCoord;
+	m_prefetchedPath.m_endCoordinate = endCoord;
+
+	return true;
+}
+
+//  =========================================================================================
+bool Planner::GetLikelyNextDestination(Vector2& outPosition)
+{
+	//only agents busy in place are worth predicting. moving agents will change their start tile
+	if (m_actionStack.size() == 0 || IsMoving())
+		return false;
+
+	//a queued follow-up step tells us exactly where we're going next
+	if (m_chainedPlanStackSize >= 0)
+	{
+		outPosition = m_chainedPlan.endPosition;
+		return true;
+	}
+
+	//the next plan is most likely refilling whatever the current action spends
+	ActionCallback currentAction = m_actionStack.top()->m_action;
+	std::vector<PointOfInterest*>* refillPointsOfInterest = nullptr;
+
+	if (currentAction == &ShootAction)
+		refillPointsOfInterest = &m_map->m_armories;
+	else if (currentAction == &RepairAction)
+		refillPointsOfInterest = &m_map->m_lumberyards;
+	else if (currentAction == &HealAction)
+		refillPointsOfInterest = &m_map->m_medStations;
+	else if (currentAction == &FightFireAction)
+		refillPointsOfInterest = &m_map->m_wells;
+	else
+		return false;
+
+	//gather plans score the nearest poi highest
+	float minDistanceSquared = m_map->GetMapDistanceSquared();
+	bool isDestinationFound = false;
+	for (int poiIndex = 0; poiIndex < (int)refillPointsOfInterest->size(); ++poiIndex)
+	{
+		PointOfInterest* poi = (*refillPointsOfInterest)[poiIndex];
+
+		float distanceSquared = GetDistanceSquared(m_agent->m_position, poi->m_accessPosition);
+		if (distanceSquared < minDistanceSquared)
+		{
+			minDistanceSquared = distanceSquared;
+			outPosition = poi->m_accessPosition;
+			isDestinationFound = true;
+		}
+	}
+
+	return isDestinationFound;
+}
+
+//  =========================================================================================
+bool Planner::TryUsePrefetchedPath(const Vector2& endPosition)
+{
+	if (!m_prefetchedPath.m_isValid || m_prefetchedPath.m_path.empty())
+		return false;
+
+	//prefetched paths are single use whether or not they were right
+	m_prefetchedPath.m_isValid = false;
+
+	//drop the path if the map changed or we guessed wrong
+	if (m_prefetchedPath.m_mapGridVersion != m_map->m_mapGridVersion
+		|| m_prefetchedPath.m_startCoordinate != m_map->GetTileCoordinateOfPosition(m_agent->m_position)
+		|| m_prefetchedPath.m_endCoordinate != m_map->GetTileCoordinateOfPosition(endPosition))
+	{
+		return false;
+	}
+
+	m_agent->m_currentPath.swap(m_prefetchedPath.m_path);
+	m_agent->m_currentPath[0] = endPosition;
+	m_agent->m_currentPathIndex = (int)m_agent->m_currentPath.size() - 1;
+
+	return true;
+}
+
 //  =============================================================================
 bool Planner::GetDoesHaveTopActionGoalPosition(Vector2& positionOut)
 {
@@ -1710,3 +1406,127 @@ bool Planner::IsMoving()
 
 	return false;
 }
+
+//  =========================================================================================
+void Planner::WriteSnapshot(SnapshotWriter& writer)
+{
+	writer.Write(m_currentPlan);
+	writer.Write(m_updatePlanTimer);
+	writer.Write(m_testUtilityRandomStream);
+	writer.Write(m_utilityHistory);
+	writer.Write(m_planEvaluation);
+	writer.Write(m_nextPlanEvaluationStartIndex);
+	writer.Write(m_chainedPlan);
+	writer.Write(m_chainedPlanStackSize);
+
+	int projectedOriginId = m_projectedOriginPointOfInterest != nullptr ? m_projectedOriginPointOfInterest->m_id : -1;
+	writer.Write(projectedOriginId);
+
+	//copy the stack out so it can be written bottom to top
+	std::stack<ActionData*> actionStack = m_actionStack;
+	std::vector<ActionData*> actions;
+	while (actionStack.size() > 0)
+	{
+		actions.push_back(actionStack.top());
+		actionStack.pop();
+	}
+
+	writer.Write((uint32_t)actions.size());
+	for (int actionIndex = (int)actions.size() - 1; actionIndex >= 0; --actionIndex)
+	{
+		writer.Write(GetActionCallbackIndex(actions[actionIndex]->m_action));
+		writer.Write(actions[actionIndex]->m_finalGoalPosition);
+		writer.Write(actions[actionIndex]->m_interactEntityId);
+	}
+}
+
+//  =========================================================================================
+bool Planner::ReadSnapshot(SnapshotReader& reader)
+{
+	//paths prefetched before the save are dropped. the next slack pass will find them again
+	ClearPrefetchedPath();
+	ClearActionStack();
+
+	reader.Read(m_currentPlan);
+	reader.Read(m_updatePlanTimer);
+	reader.Read(m_testUtilityRandomStream);
+	reader.Read(m_utilityHistory);
+	reader.Read(m_planEvaluation);
+	reader.Read(m_nextPlanEvaluationStartIndex);
+	reader.Read(m_chainedPlan);
+	reader.Read(m_chainedPlanStackSize);
+
+	int projectedOriginId = reader.Read<int>();
+	m_projectedOriginPointOfInterest = m_map->GetPointOfInterestById(projectedOriginId);
+
+	uint32_t numActions = reader.Read<uint32_t>();
+	for (uint32_t actionIndex = 0; actionIndex < numActions && reader.IsValid(); ++actionIndex)
+	{
+		ActionData* data = new ActionData();
+		data->m_action = GetActionCallbackFromIndex(reader.Read<int>());
+		reader.Read(data->m_finalGoalPosition);
+		reader.Read(data->m_interactEntityId);
+
+		//an action this build doesn't know can't be run
+		if (data->m_action == nullptr)
+		{
+			delete(data);
+			data = nullptr;
+			return false;
+		}
+
+		AddActionToStack(data);
+	}
+
+	return true;
+}
+
+//  =========================================================================================
+constexpr int NUM_SNAPSHOT_UTILITY_STORAGES = 6;
+
+//  =========================================================================================
+void Planner::WriteUtilityStorageSnapshot(SnapshotWriter& writer)
+{
+	UtilityStorage* storages[] = { m_distanceUtilityStorage, m_buildingHealthUtilityStorage, m_agentHealthUitilityStorage, m_agentGatherUtilityStorage, m_shootUtilityStorageUtility, m_testUtilityStorage };
+
+	for (int storageIndex = 0; storageIndex < NUM_SNAPSHOT_UTILITY_STORAGES; ++storageIndex)
+	{
+		bool doesExist = storages[storageIndex] != nullptr;
+		writer.Write(doesExist);
+
+		if (doesExist)
+			storages[storageIndex]->WriteSnapshot(writer);
+	}
+}
+
+//  =========================================================================================
+void Planner::ReadUtilityStorageSnapshot(SnapshotReader& reader)
+{
+	UtilityStorage* storages[] = { m_distanceUtilityStorage, m_buildingHealthUtilityStorage, m_agentHealthUitilityStorage, m_agentGatherUtilityStorage, m_shootUtilityStorageUtility, m_testUtilityStorage };
+
+	for (int storageIndex = 0; storageIndex < NUM_SNAPSHOT_UTILITY_STORAGES; ++storageIndex)
+	{
+		bool doesExist = reader.Read<bool>();
+		if (!doesExist)
+			continue;
+
+		//skip tables an unoptimized sim has no use for
+		if (storages[storageIndex] != nullptr)
+		{
+			storages[storageIndex]->ReadSnapshot(reader);
+		}
+		else
+		{
+			std::vector<float> unusedStorage;
+			reader.ReadVector(unusedStorage);
+		}
+	}
+}
+
+//  =========================================================================================
+//  Policy instantiations
+//  =========================================================================================
+template void Planner::ProcessActionStack<OptimizedSimulationPolicy>(float deltaSeconds);
+template void Planner::ProcessActionStack<UnoptimizedSimulationPolicy>(float deltaSeconds);
+template bool Planner::PrefetchLikelyNextPath<OptimizedSimulationPolicy>();
+template bool Planner::PrefetchLikelyNextPath<UnoptimizedSimulationPolicy>();
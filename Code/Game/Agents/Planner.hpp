@@ -1,15 +1,22 @@
 #pragma once
 #include "Engine\Math\IntVector2.hpp"
 #include "Game\Helpers\UtilityStorage.hpp"
+#include "Game\Helpers\TimingWheel.hpp"
+#include "Game\Helpers\RandomStream.hpp"
 #include <stack>
+#include <vector>
 
 struct ActionData;
-class Stopwatch;
 class Agent;
 class Fire;
 class Map;
 class PointOfInterest;
+class PlanDefinition;
+class SnapshotWriter;
+class SnapshotReader;
 enum eAgentSortType;
+enum eUtilityCurveType;
+enum eBiasType;
 
 enum ePlanTypes
 {
@@ -35,18 +42,31 @@ struct UtilityInfo
 
 struct UtilityHistory 
 {
-	float m_lastGatherArrows = 0.0f;
-	float m_lastGatherLumber = 0.0f;
-	float m_lastGatherBandages = 0.0f;
-	float m_lastGatherWater = 0.0f;
-	float m_lastShoot = 0.0f;
-	float m_lastRepair = 0.0f;
-	float m_lastHeal = 0.0f;
-	float m_lastFightFire = 0.0f;
-	float m_lastMove = 0.0f;	
+	float m_lastUtilityPerPlanType[NUM_PLAN_TYPE] = {};
 	ePlanTypes m_chosenOutcome = NUM_PLAN_TYPE;
 };
 
+//progress of a plan evaluation that may be spread across several frames
+struct PlanEvaluationProgress
+{
+	bool m_isInProgress = false;
+	int m_startPlanIndex = 0;
+	int m_numPlansEvaluated = 0;
+	int m_slicesUsed = 0;
+	ePlanTypes m_chosenOutcome = NONE_PLAN_TYPE;
+	UtilityInfo m_highestUtilityInfo;
+};
+
+//path computed ahead of time for where we think the agent will go next
+struct PrefetchedPath
+{
+	bool m_isValid = false;
+	uint32_t m_mapGridVersion = 0;
+	IntVector2 m_startCoordinate;
+	IntVector2 m_endCoordinate;
+	std::vector<Vector2> m_path;
+};
+
 class Planner
 {
 public:
@@ -54,16 +74,32 @@ public:
 	~Planner();
 
 	//queue management
+	template <typename SimulationPolicy>
 	void ProcessActionStack(float deltaSeconds);
 	void AddActionToStack(ActionData* actionData);
 	void ClearActionStack();
 	inline size_t GetActionStackSize() { return m_actionStack.size(); }
 
 	//planning
+	template <typename SimulationPolicy>
 	void UpdatePlan();
+	template <typename SimulationPolicy>
+	void BeginPlanEvaluation();
+	template <typename SimulationPolicy>
+	void CommitPlanEvaluation();
+	void CancelPlanEvaluation();
+	inline bool IsPlanEvaluationInProgress() { return m_planEvaluation.m_isInProgress; }
 	void ResetCurrentPlanData();
 	bool IsPlanSameAsCurrent(const UtilityInfo& newPlan);
+	template <typename SimulationPolicy>
 	void QueueActionsFromCurrentPlan(const UtilityInfo& info);
+	void QueueActionsForPlanType(const UtilityInfo& info);
+
+	//plan chaining
+	template <typename SimulationPolicy>
+	bool TryChainFollowUpPlan(const UtilityInfo& firstStepInfo, UtilityInfo& outFollowUpInfo);
+	void QueueChainedPlanActions(const UtilityInfo& info);
+	void UpdateChainedPlan();
 
 	void QueueGatherArrowsAction(const UtilityInfo& info);
 	void QueueGatherLumberAction(const UtilityInfo& info);
@@ -76,21 +112,23 @@ public:
 
 	std::string GetPlanTypeAsText();
 
-	//utility cost calculations
-	UtilityInfo GetHighestGatherArrowsUtility();
-	UtilityInfo GetHighestGatherLumberUtility();
-	UtilityInfo GetHighestGatherBandagesUtility();
-	UtilityInfo GetHighestGatherWaterUtility();
-
-	UtilityInfo GetHighestShootUtility();
-	UtilityInfo GetHighestRepairUtility();
-	UtilityInfo GetHealSelfUtility();
-	UtilityInfo GetHighestFightFireUtility();
-
-	UtilityInfo GetRepairUtilityPerBuilding(PointOfInterest* poi);
-	UtilityInfo GetGatherUitlityPerBuilding(PointOfInterest* poi);
-	UtilityInfo GetHealUtilityPerAgent(Agent* agent);
-	UtilityInfo GetFightFireUtilityPerFire(Fire* fire);
+	//plan program evaluation
+	template <typename SimulationPolicy>
+	UtilityInfo EvaluatePlanDefinition(const PlanDefinition& plan, float* utilityInputs);
+	template <typename SimulationPolicy>
+	void EvaluatePointOfInterestTargets(const PlanDefinition& plan, const std::vector<PointOfInterest*>& pointsOfInterest, float* utilityInputs, UtilityInfo& outHighestUtilityInfo);
+	template <typename SimulationPolicy>
+	void EvaluateFireTargets(const PlanDefinition& plan, float* utilityInputs, UtilityInfo& outHighestUtilityInfo);
+	template <typename SimulationPolicy>
+	float EvaluateConsiderations(const PlanDefinition& plan, const float* utilityInputs);
+	template <typename SimulationPolicy>
+	float EvaluateUtilityCurve(eUtilityCurveType curveType, float input);
+
+	void FillAgentUtilityInputs(float* outUtilityInputs);
+	float GetNormalizedDistanceToPosition(const Vector2& position);
+	float GetNormalizedDistanceToPointOfInterest(PointOfInterest* poi);
+	Vector2 GetEvaluationOrigin();
+	float GetBiasValue(eBiasType biasType);
 
 	UtilityInfo GetIdleUtilityInfo();
 
@@ -98,35 +136,69 @@ public:
 	void SkewUtilityForBias(UtilityInfo& outInfo, float biasValue);
 
 	//utility functions
+	template <typename SimulationPolicy>
 	float CalculateDistanceUtility(float normalizedDistance);
+	template <typename SimulationPolicy>
 	float CalculateBuildingHealthUtility(float normalizedBuildingHealth);
+	template <typename SimulationPolicy>
 	float CalculateTestUtility(float testValue);
+	template <typename SimulationPolicy>
 	float CalculateAgentHealthUtility(float normalizedAgentHealth);
+	template <typename SimulationPolicy>
 	float CalculateAgentGatherUtility(float normalizedGatherUtility);
+	template <typename SimulationPolicy>
 	float CalculateShootUtility(float normalizedThreatUtility);
 	float CalculateIdleUtility();
+	static float CalculateRawCurveUtility(eUtilityCurveType curveType, float input);
+	static UtilityStorage* GetUtilityStorageForCurve(eUtilityCurveType curveType);
 
 	//helpers
 	IntVector2 GetNearestTileCoordinateOfMapEdgeFromCoordinate(const IntVector2& coordinate);					//O(1)
-	Vector2 GetBestAccessLocationForFireAtPosition(const Vector2& fireWorldPosition);
 	void ResetAgentUpdatePlanTimer();
 
 	//optimizations
 	bool FindAgentAndCopyPath(const Vector2& endPostion);
-	void CopyPath(Agent* toAgent, Agent* fromAgent, uint8_t startingIndex);
+	void CopyPath(Agent* toAgent, Agent* fromAgent, int startingIndex);
 	Agent* GetAgentFromSortedList(uint16_t agentIndex, eAgentSortType sortType);
 
+	template <typename SimulationPolicy>
+	bool PrefetchLikelyNextPath();
+	bool GetLikelyNextDestination(Vector2& outPosition);
+	bool TryUsePrefetchedPath(const Vector2& endPosition);
+	inline void ClearPrefetchedPath() { m_prefetchedPath.m_isValid = false; }
+
 	bool GetDoesHaveTopActionGoalPosition(Vector2& outPosition);
 	bool IsMoving();
 
+	//checkpoints
+	void WriteSnapshot(SnapshotWriter& writer);
+	bool ReadSnapshot(SnapshotReader& reader);
+	static void WriteUtilityStorageSnapshot(SnapshotWriter& writer);
+	static void ReadUtilityStorageSnapshot(SnapshotReader& reader);
+
 public:
 	Map* m_map = nullptr;
 	Agent* m_agent = nullptr;
 	UtilityInfo m_currentPlan;
 
-	Stopwatch* m_updatePlanTimer = nullptr;
+	TimerHandle m_updatePlanTimer = INVALID_TIMER_HANDLE;
+
+	//test utility draws get their own stream. memoized runs skip them and must not shift the agent's stream
+	RandomStream m_testUtilityRandomStream;
 
 	UtilityHistory m_utilityHistory;
+	PlanEvaluationProgress m_planEvaluation;
+
+	//where the next evaluation starts. a forced commit leaves it on the first unscored plan so later plans aren't starved
+	int m_nextPlanEvaluationStartIndex = 0;
+	PrefetchedPath m_prefetchedPath;
+
+	//second step of a chain. becomes the current plan once the stack is down to its actions
+	UtilityInfo m_chainedPlan;
+	int m_chainedPlanStackSize = -1;
+
+	//when set, plans are scored as if the agent were standing at this poi (used for follow-up steps)
+	PointOfInterest* m_projectedOriginPointOfInterest = nullptr;
 
 	//utility data
 	static UtilityStorage* m_distanceUtilityStorage;
@@ -2,6 +2,7 @@
 #include "Engine\Core\StringUtils.hpp"
 #include "Game\Definitions\MapDefinition.hpp"
 #include "Game\Map\MapGenStep.hpp"
+#include "Game\Helpers\MapArtifactCache.hpp"
 
 std::map< std::string, MapDefinition* > MapDefinition:: s_definitions;
 
@@ -16,6 +17,12 @@ MapDefinition::MapDefinition( const tinyxml2::XMLElement& element )
 	std::string tileNameParsedString = ParseXmlAttribute(element, "defaultTile", defaultTileName);
 	GUARANTEE_OR_DIE(tileNameParsedString != "default", "No default tile set or incorrect matching name from known tile definitions");
 	m_defaultTile = TileDefinition::s_tileDefinitions[tileNameParsedString];
+	m_isCached = ParseXmlAttribute(element, "isCached", m_isCached);
+
+	//any edit to the definition or its steps invalidates cached layouts
+	tinyxml2::XMLPrinter printer;
+	element.Accept(&printer);
+	m_contentHash = HashArtifactString(printer.CStr(), MAP_ARTIFACT_HASH_OFFSET);
 
 	const tinyxml2::XMLElement* pRoot = element.FirstChildElement();
 	m_iterations = ParseXmlAttribute(*pRoot, "iterations", m_iterations);
@@ -22,6 +22,10 @@ public:
 	float m_chanceToRun = 1.f;
 	IntRange m_iterations = IntRange(1,1);
 
+	//generated layouts are reused from Data\Cache\Maps. hash of this definition's xml for the cache key
+	bool m_isCached = true;
+	uint64_t m_contentHash = 0;
+
 	std::vector<MapGenStep*> m_genSteps;	
 	static std::map< std::string, MapDefinition* >	s_definitions;
 	
@@ -0,0 +1,205 @@
+#include "Game\Definitions\PlanDefinition.hpp"
+#include "Engine\Core\ErrorWarningAssert.hpp"
+#include "Engine\Core\XMLUtilities.hpp"
+#include "Engine\Core\StringUtils.hpp"
+
+std::vector<PlanDefinition> PlanDefinition::s_planDefinitions;
+std::vector<UtilityConsideration> PlanDefinition::s_considerations;
+
+//  =============================================================================
+PlanDefinition::PlanDefinition(const tinyxml2::XMLElement& element)
+{
+	std::string planName = "";
+	std::string targetName = "";
+	std::string biasName = "";
+	std::string requiredInputName = "";
+	std::string followUpName = "";
+
+	planName = ParseXmlAttribute(element, "planType", planName);
+	targetName = ParseXmlAttribute(element, "target", targetName);
+	biasName = ParseXmlAttribute(element, "bias", biasName);
+	requiredInputName = ParseXmlAttribute(element, "requires", requiredInputName);
+	followUpName = ParseXmlAttribute(element, "followUp", followUpName);
+
+	m_planType = GetPlanTypeFromName(planName);
+	m_targetType = GetTargetTypeFromName(targetName);
+	m_biasType = GetBiasTypeFromName(biasName);
+
+	if (!IsStringNullOrEmpty(requiredInputName))
+	{
+		m_requiredInputType = GetInputTypeFromName(requiredInputName);
+	}
+
+	if (!IsStringNullOrEmpty(followUpName))
+	{
+		m_followUpPlanType = GetPlanTypeFromName(followUpName);
+	}
+
+	//flatten considerations into the shared list
+	m_firstConsiderationIndex = (int)s_considerations.size();
+
+	for (const tinyxml2::XMLElement* considerationNode = element.FirstChildElement("Consideration"); considerationNode; considerationNode = considerationNode->NextSiblingElement("Consideration"))
+	{
+		std::string inputName = "";
+		std::string curveName = "";
+
+		UtilityConsideration consideration;
+		inputName = ParseXmlAttribute(*considerationNode, "input", inputName);
+		curveName = ParseXmlAttribute(*considerationNode, "curve", curveName);
+		consideration.m_weight = ParseXmlAttribute(*considerationNode, "weight", consideration.m_weight);
+
+		consideration.m_inputType = GetInputTypeFromName(inputName);
+		consideration.m_curveType = GetCurveTypeFromName(curveName);
+
+		s_considerations.push_back(consideration);
+	}
+
+	m_numConsiderations = (int)s_considerations.size() - m_firstConsiderationIndex;
+	ASSERT_OR_DIE(m_numConsiderations > 0, Stringf("PLAN DEFINITION %s HAS NO CONSIDERATIONS", planName.c_str()));
+}
+
+//  =============================================================================
+void PlanDefinition::Initialize(const std::string& filePath)
+{
+	//clear any previous program so definitions can be reloaded with the simulations
+	s_planDefinitions.clear();
+	s_considerations.clear();
+
+	tinyxml2::XMLDocument planDefDoc;
+	planDefDoc.LoadFile(filePath.c_str());
+
+	tinyxml2::XMLElement* pRoot = planDefDoc.FirstChildElement();
+	ASSERT_OR_DIE(pRoot != nullptr, Stringf("PLAN DEFINITIONS MISSING: %s", filePath.c_str()));
+
+	for (const tinyxml2::XMLElement* definitionNode = pRoot->FirstChildElement(); definitionNode; definitionNode = definitionNode->NextSiblingElement())
+	{
+		s_planDefinitions.push_back(PlanDefinition(*definitionNode));
+	}
+
+	//debugger notification
+	DebuggerPrintf("Loaded plan definitions!!!");
+}
+
+//  =============================================================================
+const PlanDefinition* PlanDefinition::GetPlanDefinitionByType(ePlanTypes planType)
+{
+	for (int planIndex = 0; planIndex < (int)s_planDefinitions.size(); ++planIndex)
+	{
+		if (s_planDefinitions[planIndex].m_planType == planType)
+			return &s_planDefinitions[planIndex];
+	}
+
+	return nullptr;
+}
+
+//  =============================================================================
+ePlanTypes PlanDefinition::GetPlanTypeFromName(const std::string& name)
+{
+	if (name == "gatherArrows")
+		return GATHER_ARROWS_PLAN_TYPE;
+	if (name == "gatherLumber")
+		return GATHER_LUMBER_PLAN_TYPE;
+	if (name == "gatherBandages")
+		return GATHER_BANDAGES_PLAN_TYPE;
+	if (name == "gatherWater")
+		return GATHER_WATER_PLAN_TYPE;
+	if (name == "shoot")
+		return SHOOT_PLAN_TYPE;
+	if (name == "repair")
+		return REPAIR_PLAN_TYPE;
+	if (name == "heal")
+		return HEAL_PLAN_TYPE;
+	if (name == "fightFire")
+		return FIGHT_FIRE_PLAN_TYPE;
+
+	ASSERT_OR_DIE(false, Stringf("INVALID PLAN TYPE: %s", name.c_str()));
+	return NONE_PLAN_TYPE;
+}
+
+//  =============================================================================
+ePlanTargetType PlanDefinition::GetTargetTypeFromName(const std::string& name)
+{
+	if (name == "armories")
+		return ARMORY_PLAN_TARGET;
+	if (name == "lumberyards")
+		return LUMBERYARD_PLAN_TARGET;
+	if (name == "medStations")
+		return MED_STATION_PLAN_TARGET;
+	if (name == "wells")
+		return WELL_PLAN_TARGET;
+	if (name == "pointsOfInterest")
+		return POINT_OF_INTEREST_PLAN_TARGET;
+	if (name == "fires")
+		return FIRE_PLAN_TARGET;
+	if (name == "self")
+		return SELF_PLAN_TARGET;
+	if (name == "mapEdge")
+		return MAP_EDGE_PLAN_TARGET;
+
+	ASSERT_OR_DIE(false, Stringf("INVALID PLAN TARGET: %s", name.c_str()));
+	return NUM_PLAN_TARGETS;
+}
+
+//  =============================================================================
+eUtilityInputType PlanDefinition::GetInputTypeFromName(const std::string& name)
+{
+	if (name == "distanceToTarget")
+		return DISTANCE_TO_TARGET_UTILITY_INPUT;
+	if (name == "targetHealth")
+		return TARGET_HEALTH_UTILITY_INPUT;
+	if (name == "agentHealth")
+		return AGENT_HEALTH_UTILITY_INPUT;
+	if (name == "threat")
+		return THREAT_UTILITY_INPUT;
+	if (name == "arrowCount")
+		return ARROW_COUNT_UTILITY_INPUT;
+	if (name == "lumberCount")
+		return LUMBER_COUNT_UTILITY_INPUT;
+	if (name == "bandageCount")
+		return BANDAGE_COUNT_UTILITY_INPUT;
+	if (name == "waterCount")
+		return WATER_COUNT_UTILITY_INPUT;
+
+	ASSERT_OR_DIE(false, Stringf("INVALID UTILITY INPUT: %s", name.c_str()));
+	return NUM_UTILITY_INPUTS;
+}
+
+//  =============================================================================
+eUtilityCurveType PlanDefinition::GetCurveTypeFromName(const std::string& name)
+{
+	if (name == "distance")
+		return DISTANCE_UTILITY_CURVE;
+	if (name == "buildingHealth")
+		return BUILDING_HEALTH_UTILITY_CURVE;
+	if (name == "agentHealth")
+		return AGENT_HEALTH_UTILITY_CURVE;
+	if (name == "gather")
+		return GATHER_UTILITY_CURVE;
+	if (name == "shoot")
+		return SHOOT_UTILITY_CURVE;
+	if (name == "linear")
+		return LINEAR_UTILITY_CURVE;
+	if (name == "inverseLinear")
+		return INVERSE_LINEAR_UTILITY_CURVE;
+
+	ASSERT_OR_DIE(false, Stringf("INVALID UTILITY CURVE: %s", name.c_str()));
+	return NUM_UTILITY_CURVES;
+}
+
+//  =============================================================================
+eBiasType PlanDefinition::GetBiasTypeFromName(const std::string& name)
+{
+	if (IsStringNullOrEmpty(name))
+		return NO_BIAS;
+	if (name == "combat")
+		return COMBAT_BIAS;
+	if (name == "repair")
+		return REPAIR_BIAS;
+	if (name == "heal")
+		return HEAL_BIAS;
+	if (name == "fireFighting")
+		return FIRE_FIGHTING_BIAS;
+
+	ASSERT_OR_DIE(false, Stringf("INVALID BIAS: %s", name.c_str()));
+	return NO_BIAS;
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Engine\ThirdParty\tinyxml2\tinyxml2.h"
+#include "Game\Agents\Planner.hpp"
+
+enum ePlanTargetType
+{
+	ARMORY_PLAN_TARGET,
+	LUMBERYARD_PLAN_TARGET,
+	MED_STATION_PLAN_TARGET,
+	WELL_PLAN_TARGET,
+	POINT_OF_INTEREST_PLAN_TARGET,
+	FIRE_PLAN_TARGET,
+	SELF_PLAN_TARGET,
+	MAP_EDGE_PLAN_TARGET,
+	NUM_PLAN_TARGETS
+};
+
+//agent inputs are gathered once per UpdatePlan, target inputs are refilled per target
+enum eUtilityInputType
+{
+	DISTANCE_TO_TARGET_UTILITY_INPUT,
+	TARGET_HEALTH_UTILITY_INPUT,
+	AGENT_HEALTH_UTILITY_INPUT,
+	THREAT_UTILITY_INPUT,
+	ARROW_COUNT_UTILITY_INPUT,
+	LUMBER_COUNT_UTILITY_INPUT,
+	BANDAGE_COUNT_UTILITY_INPUT,
+	WATER_COUNT_UTILITY_INPUT,
+	NUM_UTILITY_INPUTS
+};
+
+enum eUtilityCurveType
+{
+	DISTANCE_UTILITY_CURVE,
+	BUILDING_HEALTH_UTILITY_CURVE,
+	AGENT_HEALTH_UTILITY_CURVE,
+	GATHER_UTILITY_CURVE,
+	SHOOT_UTILITY_CURVE,
+	LINEAR_UTILITY_CURVE,
+	INVERSE_LINEAR_UTILITY_CURVE,
+	NUM_UTILITY_CURVES
+};
+
+enum eBiasType
+{
+	NO_BIAS,
+	COMBAT_BIAS,
+	REPAIR_BIAS,
+	HEAL_BIAS,
+	FIRE_FIGHTING_BIAS,
+	NUM_BIASES
+};
+
+//  ----------------------------------------------
+struct UtilityConsideration
+{
+	eUtilityInputType m_inputType = NUM_UTILITY_INPUTS;
+	eUtilityCurveType m_curveType = NUM_UTILITY_CURVES;
+	float m_weight = 1.f;
+};
+
+//  ----------------------------------------------
+class PlanDefinition
+{
+public:
+	explicit PlanDefinition(const tinyxml2::XMLElement& element);
+	static void Initialize(const std::string& filePath);
+	static const PlanDefinition* GetPlanDefinitionByType(ePlanTypes planType);
+
+	static ePlanTypes GetPlanTypeFromName(const std::string& name);
+	static ePlanTargetType GetTargetTypeFromName(const std::string& name);
+	static eUtilityInputType GetInputTypeFromName(const std::string& name);
+	static eUtilityCurveType GetCurveTypeFromName(const std::string& name);
+	static eBiasType GetBiasTypeFromName(const std::string& name);
+
+public:
+	ePlanTypes m_planType = NONE_PLAN_TYPE;
+	ePlanTargetType m_targetType = NUM_PLAN_TARGETS;
+	eBiasType m_biasType = NO_BIAS;
+
+	//plan is skipped entirely when this input is zero (ex: no lumber to repair with)
+	eUtilityInputType m_requiredInputType = NUM_UTILITY_INPUTS;
+
+	//plan that usually comes next (ex: repair after gathering lumber). scored up front so both steps can be queued at once
+	ePlanTypes m_followUpPlanType = NONE_PLAN_TYPE;
+
+	//range in s_considerations
+	int m_firstConsiderationIndex = 0;
+	int m_numConsiderations = 0;
+
+	//compiled program. plans are stored in evaluation order and their considerations are flattened into one list
+	static std::vector<PlanDefinition> s_planDefinitions;
+	static std::vector<UtilityConsideration> s_considerations;
+};
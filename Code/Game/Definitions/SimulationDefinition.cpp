@@ -1,8 +1,10 @@
 #include "Engine\Core\ErrorWarningAssert.hpp"
 #include "Engine\Core\StringUtils.hpp"
+#include "Engine\Time\Time.hpp"
 #include "Game\Definitions\SimulationDefinition.hpp"
 #include "Game\Definitions\MapDefinition.hpp"
 #include "Game\Map\MapGenStep.hpp"
+#include "Game\GameCommon.hpp"
 
 std::vector<SimulationDefinition*> SimulationDefinition:: s_simulationDefinitions;
 
@@ -22,6 +24,20 @@ SimulationDefinition::SimulationDefinition( const tinyxml2::XMLElement& element
 	m_totalProcessingTimeInSeconds = ParseXmlAttribute(element, "processTimerInSeconds", m_totalProcessingTimeInSeconds);
 	m_isOptimized = ParseXmlAttribute(element, "isOptimized", m_isOptimized);
 	m_isUpdateBudgeted = ParseXmlAttribute(element, "isBudgeted", m_isUpdateBudgeted);
+	m_utilityStorageDivisions = ParseXmlAttribute(element, "utilityStorageDivisions", m_utilityStorageDivisions);
+	m_sortTimerInSeconds = ParseXmlAttribute(element, "sortTimerInSeconds", m_sortTimerInSeconds);
+	m_agentCopyDestinationPositionRadius = ParseXmlAttribute(element, "agentCopyDestinationPositionRadius", m_agentCopyDestinationPositionRadius);
+	m_planningSliceBudgetInSeconds = ParseXmlAttribute(element, "planningSliceBudgetInSeconds", m_planningSliceBudgetInSeconds);
+	m_randomSeed = ParseXmlAttribute(element, "seed", m_randomSeed);
+	m_isDeterministic = ParseXmlAttribute(element, "isDeterministic", m_isDeterministic);
+	m_replayFilePath = ParseXmlAttribute(element, "replayFile", m_replayFilePath);
+	m_snapshotFilePath = ParseXmlAttribute(element, "snapshotFile", m_snapshotFilePath);
+
+	//playing a log back only makes sense if the sim can't drift from it
+	if (!IsStringNullOrEmpty(m_replayFilePath))
+		m_isDeterministic = true;
+
+	ASSERT_OR_DIE(m_utilityStorageDivisions > 0, Stringf("SIMULATION %s NEEDS AT LEAST ONE UTILITY STORAGE DIVISION", m_name.c_str()));
 
 	m_mapDefinition = MapDefinition::GetMapDefinitionByName(m_mapName);
 }
@@ -50,6 +66,20 @@ void SimulationDefinition::Initialize(const std::string& filePath)
 	DebuggerPrintf("Loaded map definitions!!!");
 }
 
+//  =============================================================================
+void SimulationDefinition::ApplyTunables() const
+{
+	g_utilityStorageDivisions = (uint)m_utilityStorageDivisions;
+	g_sortTimerInSeconds = m_sortTimerInSeconds;
+	g_agentCopyDestinationPositionRadius = m_agentCopyDestinationPositionRadius;
+
+	//budgeted sims spread replans across frames. deterministic sims can't, the split depends on the clock
+	if (m_isUpdateBudgeted && !m_isDeterministic)
+		g_perPlanningSliceHPCBudget = SecondsToPerformanceCounter(m_planningSliceBudgetInSeconds);
+	else
+		g_perPlanningSliceHPCBudget = 0;
+}
+
 //  =============================================================================
 SimulationDefinition* SimulationDefinition::GetSimulationByName(const std::string& definitionName)
 {
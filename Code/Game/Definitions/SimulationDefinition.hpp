@@ -14,6 +14,8 @@ public:
 	static void Initialize(const std::string& filePath);
 	static SimulationDefinition* GetSimulationByName(const std::string& definitionName);
 
+	void ApplyTunables() const;
+
 public:
 	std::string m_name = "default";
 	std::string m_mapName = "";
@@ -29,6 +31,22 @@ public:
 	bool m_isOptimized = false;
 	bool m_isUpdateBudgeted = false;
 
+	//tunables that used to be hard coded globals. applied to the globals when the sim's map is created
+	int m_utilityStorageDivisions = 100;
+	float m_sortTimerInSeconds = 0.5f;
+	float m_agentCopyDestinationPositionRadius = 0.5f;
+	float m_planningSliceBudgetInSeconds = 0.0002f; //only used by budgeted, non deterministic sims
+
+	//every random stream in the sim is derived from this so sims sharing a seed share a world
+	int m_randomSeed = 1;
+
+	//deterministic sims record a replay log. sims with a replay file play that log back instead of reading the clock
+	bool m_isDeterministic = false;
+	std::string m_replayFilePath = "";
+
+	//warmed up checkpoint to start from instead of a fresh map. must come from a sim with the same map and seed
+	std::string m_snapshotFilePath = "";
+
 	MapDefinition* m_mapDefinition = nullptr;
 
 	static std::vector<SimulationDefinition*> s_simulationDefinitions;
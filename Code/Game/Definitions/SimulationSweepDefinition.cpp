@@ -0,0 +1,153 @@
+#include "Engine\Core\ErrorWarningAssert.hpp"
+#include "Engine\Core\StringUtils.hpp"
+#include "Engine\Core\XMLUtilities.hpp"
+#include "Engine\Math\MathUtils.hpp"
+#include "Game\Definitions\SimulationSweepDefinition.hpp"
+#include "Game\Definitions\SimulationDefinition.hpp"
+#include <thread>
+
+std::vector<SimulationSweepDefinition*> SimulationSweepDefinition::s_sweepDefinitions;
+
+//  =============================================================================
+static void SplitSweepValues(const std::string& valueList, std::vector<std::string>& outValues)
+{
+	size_t startIndex = 0;
+	while (startIndex <= valueList.size())
+	{
+		size_t endIndex = valueList.find(',', startIndex);
+		if (endIndex == std::string::npos)
+			endIndex = valueList.size();
+
+		//trim spaces so "100, 500" reads the same as "100,500"
+		size_t valueStart = valueList.find_first_not_of(' ', startIndex);
+		size_t valueEnd = valueList.find_last_not_of(' ', endIndex - 1);
+		if (valueStart < endIndex && valueEnd != std::string::npos && valueEnd >= valueStart)
+			outValues.push_back(valueList.substr(valueStart, valueEnd - valueStart + 1));
+
+		startIndex = endIndex + 1;
+	}
+}
+
+//  =============================================================================
+SimulationSweepDefinition::SimulationSweepDefinition( const tinyxml2::XMLElement& element )
+{
+	m_name = ParseXmlAttribute(element, "name", m_name);
+	m_numWorkers = ParseXmlAttribute(element, "numWorkers", m_numWorkers);
+
+	//everything else is a simulation attribute with one or more values
+	std::vector<std::string> attributeNames;
+	std::vector<std::vector<std::string>> attributeValues;
+
+	for (const tinyxml2::XMLAttribute* attribute = element.FirstAttribute(); attribute; attribute = attribute->Next())
+	{
+		std::string attributeName = attribute->Name();
+		if (attributeName == "name" || attributeName == "numWorkers")
+			continue;
+
+		std::vector<std::string> values;
+		SplitSweepValues(attribute->Value(), values);
+		ASSERT_OR_DIE(values.size() > 0, Stringf("SWEEP %s HAS NO VALUES FOR %s", m_name.c_str(), attributeName.c_str()));
+
+		attributeNames.push_back(attributeName);
+		attributeValues.push_back(values);
+	}
+
+	ExpandDefinitions(attributeNames, attributeValues);
+}
+
+//  =========================================================================================
+SimulationSweepDefinition::~SimulationSweepDefinition()
+{
+	for (int definitionIndex = 0; definitionIndex < (int)m_definitions.size(); ++definitionIndex)
+	{
+		delete(m_definitions[definitionIndex]);
+		m_definitions[definitionIndex] = nullptr;
+	}
+
+	m_definitions.clear();
+}
+
+//  =============================================================================
+void SimulationSweepDefinition::Initialize(const std::string& filePath)
+{
+	tinyxml2::XMLDocument sweepDefDoc;
+	sweepDefDoc.LoadFile(filePath.c_str());
+
+	//sweeps are optional
+	tinyxml2::XMLElement* pRoot = sweepDefDoc.FirstChildElement();
+	if (pRoot == nullptr)
+		return;
+
+	for (const tinyxml2::XMLElement* definitionNode = pRoot->FirstChildElement(); definitionNode; definitionNode = definitionNode->NextSiblingElement())
+	{
+		SimulationSweepDefinition* newDef = new SimulationSweepDefinition(*definitionNode);
+		s_sweepDefinitions.push_back(newDef);
+	}
+
+	//debugger notification
+	DebuggerPrintf("Loaded sweep definitions!!!");
+}
+
+//  =============================================================================
+SimulationSweepDefinition* SimulationSweepDefinition::GetSweepByName(const std::string& sweepName)
+{
+	for (int sweepIndex = 0; sweepIndex < (int)s_sweepDefinitions.size(); ++sweepIndex)
+	{
+		if (s_sweepDefinitions[sweepIndex]->m_name == sweepName)
+		{
+			return s_sweepDefinitions[sweepIndex];
+		}
+	}
+
+	return nullptr;
+}
+
+//  =============================================================================
+void SimulationSweepDefinition::GetDefinitionsForWorker(int workerIndex, int numWorkers, std::vector<SimulationDefinition*>& outDefinitions) const
+{
+	//interleave so the expensive end of each parameter list is spread across workers
+	for (int definitionIndex = workerIndex; definitionIndex < (int)m_definitions.size(); definitionIndex += numWorkers)
+	{
+		outDefinitions.push_back(m_definitions[definitionIndex]);
+	}
+}
+
+//  =============================================================================
+int SimulationSweepDefinition::GetNumWorkers() const
+{
+	int numWorkers = m_numWorkers;
+	if (numWorkers <= 0)
+		numWorkers = (int)std::thread::hardware_concurrency();
+
+	return ClampInt(numWorkers, 1, (int)m_definitions.size());
+}
+
+//  =============================================================================
+void SimulationSweepDefinition::ExpandDefinitions(const std::vector<std::string>& attributeNames, const std::vector<std::vector<std::string>>& attributeValues)
+{
+	int numCombinations = 1;
+	for (int attributeIndex = 0; attributeIndex < (int)attributeValues.size(); ++attributeIndex)
+	{
+		numCombinations *= (int)attributeValues[attributeIndex].size();
+	}
+
+	//build each combination as a plain SimulationDefinition element so sweeps parse exactly like Simulations.xml
+	tinyxml2::XMLDocument scratchDoc;
+	for (int combinationIndex = 0; combinationIndex < numCombinations; ++combinationIndex)
+	{
+		tinyxml2::XMLElement* simulationElement = scratchDoc.NewElement("SimulationDefinition");
+		simulationElement->SetAttribute("name", Stringf("%s_%i", m_name.c_str(), combinationIndex).c_str());
+
+		//mixed radix walk. the last attribute changes fastest
+		int remainder = combinationIndex;
+		for (int attributeIndex = (int)attributeNames.size() - 1; attributeIndex >= 0; --attributeIndex)
+		{
+			int numValues = (int)attributeValues[attributeIndex].size();
+			simulationElement->SetAttribute(attributeNames[attributeIndex].c_str(), attributeValues[attributeIndex][remainder % numValues].c_str());
+			remainder /= numValues;
+		}
+
+		m_definitions.push_back(new SimulationDefinition(*simulationElement));
+		scratchDoc.DeleteNode(simulationElement);
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Engine\ThirdParty\tinyxml2\tinyxml2.h"
+
+class SimulationDefinition;
+
+//a grid of simulation parameters. every attribute can hold a comma separated list and the sweep expands to every combination
+class SimulationSweepDefinition
+{
+public:
+	explicit SimulationSweepDefinition( const tinyxml2::XMLElement& element );
+	~SimulationSweepDefinition();
+	static void Initialize(const std::string& filePath);
+	static SimulationSweepDefinition* GetSweepByName(const std::string& sweepName);
+
+	void GetDefinitionsForWorker(int workerIndex, int numWorkers, std::vector<SimulationDefinition*>& outDefinitions) const;
+	int GetNumWorkers() const;
+
+private:
+	void ExpandDefinitions(const std::vector<std::string>& attributeNames, const std::vector<std::vector<std::string>>& attributeValues);
+
+public:
+	std::string m_name = "default";
+
+	//worker processes to split the sweep across. zero uses one per core
+	int m_numWorkers = 0;
+
+	//owned. one per combination, named <sweep name>_<combination index>
+	std::vector<SimulationDefinition*> m_definitions;
+
+	static std::vector<SimulationSweepDefinition*> s_sweepDefinitions;
+};
+
@@ -53,4 +53,6 @@ std::string IsoSpriteAnimSetDefinition::GetAnimationIdBySimplifiedName(std::stri
 			return m_isoAnimSetStructs[animStructIndex].m_isoAnimId;
 		}
 	}
+
+	return "";
 }
@@ -4,8 +4,15 @@
 #include "Engine\Core\StringUtils.hpp"
 #include "Game\GameCommon.hpp"
 #include "Game\Definitions\TileDefinition.hpp"
+#include "Game\Entities\PointOfInterest.hpp"
 
 std::map< std::string, TileDefinition* > TileDefinition:: s_tileDefinitions;
+std::vector<TileDefinition*> TileDefinition::s_tileDefinitionsByIndex;
+TileDefinition* TileDefinition::s_groundDefinition = nullptr;
+TileDefinition* TileDefinition::s_fireDefinition = nullptr;
+TileDefinition* TileDefinition::s_buildingAccessDefinition = nullptr;
+TileDefinition* TileDefinition::s_defaultBuildingDefinition = nullptr;
+std::vector<TileDefinition*> TileDefinition::s_buildingDefinitionsByPointOfInterestType;
 
 TileDefinition::TileDefinition( const tinyxml2::XMLElement& element )
 {	
@@ -15,6 +22,9 @@ TileDefinition::TileDefinition( const tinyxml2::XMLElement& element )
 
 	m_allowsWalking = ParseXmlAttribute(element, "allowsWalking", m_allowsWalking);
 	m_allowsBuilding = ParseXmlAttribute(element, "allowsBuilding", m_allowsBuilding);
+	m_isFire = ParseXmlAttribute(element, "isFire", m_isFire);
+	m_isHazard = ParseXmlAttribute(element, "isHazard", m_isFire);
+	m_isBuilding = ParseXmlAttribute(element, "isBuilding", m_isBuilding);
 
 	//load spritesheet name and definition
 	std::string defaultSpriteSheetName = "Terrain_8x8.png";
@@ -42,9 +52,43 @@ void TileDefinition::Initialize(const std::string& filePath)
 	{
 		TileDefinition* newDef = new TileDefinition(*definitionNode);		
 
+		//tiles only have a byte for their definition
+		ASSERT_OR_DIE(s_tileDefinitionsByIndex.size() < 256, "TOO MANY TILE DEFINITIONS");
+		newDef->m_index = (uint8_t)s_tileDefinitionsByIndex.size();
+		s_tileDefinitionsByIndex.push_back(newDef);
+
 		s_tileDefinitions.insert(std::pair<std::string, TileDefinition*>(std::string(newDef->m_name), newDef));
 	}	
 
+	s_groundDefinition = GetDefinitionByName("Ground");
+	s_fireDefinition = GetDefinitionByName("Fire");
+	s_buildingAccessDefinition = GetDefinitionByName("BuildingAccess");
+	ASSERT_OR_DIE(s_groundDefinition != nullptr && s_fireDefinition != nullptr && s_buildingAccessDefinition != nullptr, "MISSING REQUIRED TILE DEFINITION");
+
+	s_defaultBuildingDefinition = GetDefinitionByName("Building");
+	s_buildingDefinitionsByPointOfInterestType.assign(NUM_POI_TYPES, s_defaultBuildingDefinition);
+	s_buildingDefinitionsByPointOfInterestType[ARMORY_POI_TYPE] = GetDefinitionByName("Armory");
+	s_buildingDefinitionsByPointOfInterestType[LUMBERYARD_POI_TYPE] = GetDefinitionByName("Lumberyard");
+	s_buildingDefinitionsByPointOfInterestType[MED_STATION_POI_TYPE] = GetDefinitionByName("MedStation");
+	s_buildingDefinitionsByPointOfInterestType[WELL_POI_TYPE] = GetDefinitionByName("Well");
+
 	//debugger notification
 	DebuggerPrintf("Loaded tile definitions!!!");
 }
+
+TileDefinition* TileDefinition::GetDefinitionByName(const std::string& name)
+{
+	std::map<std::string, TileDefinition*>::iterator definitionIterator = s_tileDefinitions.find(name);
+	if (definitionIterator == s_tileDefinitions.end())
+		return nullptr;
+
+	return definitionIterator->second;
+}
+
+TileDefinition* TileDefinition::GetBuildingDefinitionForPointOfInterestType(int poiType)
+{
+	if (poiType < 0 || poiType >= (int)s_buildingDefinitionsByPointOfInterestType.size())
+		return s_defaultBuildingDefinition;
+
+	return s_buildingDefinitionsByPointOfInterestType[poiType];
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include <map>
 #include <string>
+#include <vector>
+#include <stdint.h>
 #include "Engine\Core\XMLUtilities.hpp"
 #include "Engine\ThirdParty\tinyxml2\tinyxml2.h"
 #include "Engine\Core\Rgba.hpp"
@@ -12,6 +14,12 @@ class TileDefinition
 public:
 	explicit TileDefinition( const tinyxml2::XMLElement& element );
 	static void Initialize(const std::string& filePath);
+
+	//load time only. gameplay uses the interned definitions below or a tile's definition index
+	static TileDefinition* GetDefinitionByName(const std::string& name);
+
+	//falls back to the plain building for anything that isn't a poi type
+	static TileDefinition* GetBuildingDefinitionForPointOfInterestType(int poiType);
 public: 
 	//list of tile definition member variables
 	std::string m_name = "default";
@@ -24,7 +32,21 @@ public:
 
 	bool m_allowsWalking = false;
 	bool m_allowsBuilding = false;
+	bool m_isFire = false;
+	bool m_isHazard = false; //agents avoid walking into it. defaults to m_isFire
+	bool m_isBuilding = false;
+
+	//position in s_tileDefinitionsByIndex. tiles store this instead of a pointer
+	uint8_t m_index = 0;
 
 	//static variables
 	static std::map< std::string, TileDefinition* >	s_tileDefinitions;
+	static std::vector<TileDefinition*> s_tileDefinitionsByIndex;
+
+	//definitions the simulation places itself, looked up once after loading
+	static TileDefinition* s_groundDefinition;
+	static TileDefinition* s_fireDefinition;
+	static TileDefinition* s_buildingAccessDefinition;
+	static TileDefinition* s_defaultBuildingDefinition;
+	static std::vector<TileDefinition*> s_buildingDefinitionsByPointOfInterestType;
 };
@@ -1,25 +1,27 @@
 #include "Game\Entities\Bombardment.hpp"
 #include "Game\Game.hpp"
 #include "Game\GameCommon.hpp"
+#include "Game\Helpers\SimulationSnapshot.hpp"
 #include "Engine\Profiler\Profiler.hpp"
 #include "Engine\Renderer\Renderer.hpp"
 
 
 //  =========================================================================================
-Bombardment::Bombardment(const Vector2& position)
+Bombardment::Bombardment(const Vector2& position, TimingWheel* timingWheel)
 {
 	m_disc.center = position;
 	m_disc.radius = 0.f;
 
-	m_timer = new Stopwatch(GetGameClock());
-	m_timer->SetTimer(g_bombardmentExplosionTime);
+	m_timingWheel = timingWheel;
+	m_timer = m_timingWheel->CreateTimer();
+	m_timingWheel->StartTimer(m_timer, g_bombardmentExplosionTime, false);
 }
 
 //  =========================================================================================
 Bombardment::~Bombardment()
 {
-	delete(m_timer);
-	m_timer = nullptr;
+	m_timingWheel->DestroyTimer(m_timer);
+	m_timingWheel = nullptr;
 }
 
 //  =========================================================================================
@@ -27,7 +29,7 @@ void Bombardment::Update(float deltaSeconds)
 {
 	//PROFILER_PUSH();
 
-	float percentComplete = m_timer->GetNormalizedElapsedTimeInSeconds();
+	float percentComplete = m_timingWheel->GetNormalizedElapsedTime(m_timer);
 
 	m_disc.radius = g_bombardmentExplosionSize * percentComplete;
 }
@@ -47,5 +49,19 @@ void Bombardment::Render()
 //  =========================================================================================
 bool Bombardment::IsExplosionComplete()
 {
-	return m_timer->HasElapsed();
+	return m_timingWheel->HasElapsed(m_timer);
+}
+
+//  =========================================================================================
+void Bombardment::WriteSnapshot(SnapshotWriter& writer)
+{
+	writer.Write(m_disc);
+	writer.Write(m_timer);
+}
+
+//  =========================================================================================
+void Bombardment::ReadSnapshot(SnapshotReader& reader)
+{
+	reader.Read(m_disc);
+	reader.Read(m_timer);
 }
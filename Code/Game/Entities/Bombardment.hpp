@@ -1,20 +1,27 @@
 #pragma once
 #include "Engine\Math\Disc2.hpp"
-#include "Engine\Time\Stopwatch.hpp"
+#include "Game\Helpers\TimingWheel.hpp"
 #include "Engine\Math\Vector2.hpp"
 
+class SnapshotWriter;
+class SnapshotReader;
+
 class Bombardment
 {
 public:
-	Bombardment(const Vector2& position);
+	Bombardment(const Vector2& position, TimingWheel* timingWheel);
 	~Bombardment();
 
 	void Update(float deltaSeconds);
 	void Render();
 	bool IsExplosionComplete();
 
+	void WriteSnapshot(SnapshotWriter& writer);
+	void ReadSnapshot(SnapshotReader& reader);
+
 public:
 	Disc2 m_disc;
-	Stopwatch* m_timer = nullptr;
+	TimingWheel* m_timingWheel = nullptr;
+	TimerHandle m_timer = INVALID_TIMER_HANDLE;
 };
 
@@ -2,6 +2,8 @@
 #include "Engine\Renderer\Texture.hpp"
 #include "Engine\Core\EngineCommon.hpp"
 #include "Game\Map\Map.hpp"
+#include "Game\GameCommon.hpp"
+#include "Game\Helpers\SimulationSnapshot.hpp"
 
 int Fire::s_fireIdPosition = 0;
 
@@ -13,8 +15,7 @@ Fire::Fire(const IntVector2& coordinate, Map* map)
 	m_worldPosition = Vector2(coordinate) + Vector2(0.5f, 0.5f);
 	m_mapReference = map;
 
-	//determine access location
-
+	//access location is determined lazily (or in slack time) once the map grid includes this fire
 
 	s_fireIdPosition++;
 }
@@ -31,3 +32,62 @@ void Fire::Update(float deltaSeconds)
 	UNUSED(deltaSeconds);
 }
 
+//  =========================================================================================
+bool Fire::IsAccessPositionStale()
+{
+	return m_accessPositionMapGridVersion != m_mapReference->m_mapGridVersion;
+}
+
+//  =========================================================================================
+bool Fire::UpdateAccessPosition()
+{
+	if (!IsAccessPositionStale())
+		return false;
+
+	m_accessPositionMapGridVersion = m_mapReference->m_mapGridVersion;
+
+	//check each cardinal direction and take the first one we can stand on
+	Vector2 cardinalDirections[4] = { NORTH_VEC2, SOUTH_VEC2, EAST_VEC2, WEST_VEC2 };
+	for (int directionIndex = 0; directionIndex < 4; ++directionIndex)
+	{
+		Vector2 accessPosition = m_worldPosition + cardinalDirections[directionIndex];
+
+		IntVector2 tileCoordinate = m_mapReference->GetTileCoordinateOfPosition(accessPosition);
+		if (m_mapReference->CheckIsCoordinateValid(tileCoordinate) && !m_mapReference->IsTileBlockingAtCoordinate(tileCoordinate))
+		{
+			m_accessPosition = accessPosition;
+			m_hasAccessPosition = true;
+			return true;
+		}
+	}
+
+	//this fire is blocked in on all sides
+	m_accessPosition = m_worldPosition;
+	m_hasAccessPosition = false;
+	return true;
+}
+
+//  =========================================================================================
+const Vector2& Fire::GetAccessPosition()
+{
+	UpdateAccessPosition();
+	return m_accessPosition;
+}
+
+//  =========================================================================================
+void Fire::WriteSnapshot(SnapshotWriter& writer)
+{
+	writer.Write(m_id);
+	writer.Write(m_health);
+}
+
+//  =========================================================================================
+void Fire::ReadSnapshot(SnapshotReader& reader)
+{
+	reader.Read(m_id);
+	reader.Read(m_health);
+
+	//recomputed against the restored grid
+	m_hasAccessPosition = false;
+	m_accessPositionMapGridVersion = UINT32_MAX;
+}
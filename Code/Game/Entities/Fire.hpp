@@ -1,8 +1,11 @@
 #pragma once
 #include "Engine\Math\IntVector2.hpp"
 #include "Engine\Math\Vector2.hpp"
+#include "Engine\Core\EngineCommon.hpp"
 
 class Map;
+class SnapshotWriter;
+class SnapshotReader;
 
 class Fire
 {
@@ -12,13 +15,28 @@ public:
 	void Update(float deltaSeconds);
 	inline bool IsDead(){ return m_health <= 0 ? true : false;}
 
+	//access position is cached against the map grid version
+	bool IsAccessPositionStale();
+	bool UpdateAccessPosition();
+	const Vector2& GetAccessPosition();
+
+	void WriteSnapshot(SnapshotWriter& writer);
+	void ReadSnapshot(SnapshotReader& reader);
+
+	//ids keep counting across the sim so a restored sim has to pick up where the saved one left off
+	static int GetNextFireId() { return s_fireIdPosition; }
+	static void SetNextFireId(int fireId) { s_fireIdPosition = fireId; }
+
 public:
 	int m_id = -1;
 	int m_health = 100;
 	IntVector2 m_coordinate;
-	//IntVector2 m_accessCoordinate;
 	Vector2 m_worldPosition;
 
+	Vector2 m_accessPosition;
+	bool m_hasAccessPosition = false;
+	uint32_t m_accessPositionMapGridVersion = UINT32_MAX;
+
 	Map* m_mapReference = nullptr;
 
 private:
@@ -2,6 +2,7 @@
 #include "Game\GameCommon.hpp"
 #include "Game\Map\Map.hpp"
 #include "Game\Agents\Agent.hpp"
+#include "Game\Helpers\SimulationSnapshot.hpp"
 #include "Engine\Renderer\Renderer.hpp"
 #include "Engine\Window\Window.hpp"
 #include "Engine\Core\EngineCommon.hpp"
@@ -19,14 +20,14 @@ PointOfInterest::PointOfInterest(ePointOfInterestType poiType, const IntVector2&
 
 	m_id = m_map->m_pointsOfInterest.size();
 
-	//start stopwatch
-	m_refillTimer = new Stopwatch();
-	m_refillTimer->SetTimer(g_baseResourceRefillTimePerSecond);
+	//refill timer is started when an agent begins being served
+	m_refillTimer = m_map->m_timingWheel.CreateTimer();
 }
 
 //  =========================================================================================
 PointOfInterest::~PointOfInterest()
 {
+	m_map->m_timingWheel.DestroyTimer(m_refillTimer);
 	m_map = nullptr;
 }
 
@@ -123,3 +124,32 @@ IntVector2 PointOfInterest::GetCoordinateBoundsClosestToCoordinate(const IntVect
 
 	return closestCoordinate;
 }
+
+//  =========================================================================================
+void PointOfInterest::WriteSnapshot(SnapshotWriter& writer)
+{
+	writer.Write(m_id);
+	writer.Write(m_startingCoordinate);
+	writer.Write(m_health);
+	writer.Write(m_refillTimer);
+
+	int servingAgentId = m_agentCurrentlyServing != nullptr ? m_agentCurrentlyServing->m_id : -1;
+	writer.Write(servingAgentId);
+}
+
+//  =========================================================================================
+void PointOfInterest::ReadSnapshot(SnapshotReader& reader)
+{
+	int savedId = reader.Read<int>();
+	IntVector2 savedStartingCoordinate = reader.Read<IntVector2>();
+
+	//a different seed or poi count would put this poi somewhere else entirely
+	ASSERT_OR_DIE(savedId == m_id && savedStartingCoordinate.x == m_startingCoordinate.x && savedStartingCoordinate.y == m_startingCoordinate.y, "SNAPSHOT POINT OF INTEREST DOES NOT MATCH MAP");
+
+	reader.Read(m_health);
+	reader.Read(m_refillTimer);
+
+	//agents are restored before poi so this resolves
+	int servingAgentId = reader.Read<int>();
+	m_agentCurrentlyServing = m_map->GetAgentById(servingAgentId);
+}
@@ -1,11 +1,13 @@
 #pragma once
 #include "Engine\Math\IntVector2.hpp"
-#include "Engine\Time\Stopwatch.hpp"
+#include "Game\Helpers\TimingWheel.hpp"
 #include "Engine\Math\AABB2.hpp"
 
 //forward declarations
 class Map;
 class Agent;
+class SnapshotWriter;
+class SnapshotReader;
 
 enum ePointOfInterestType
 {
@@ -30,6 +32,10 @@ public:
 
 	IntVector2 GetCoordinateBoundsClosestToCoordinate(const IntVector2& coordinate);
 
+	//placement comes from the seed so only the changing state is saved
+	void WriteSnapshot(SnapshotWriter& writer);
+	void ReadSnapshot(SnapshotReader& reader);
+
 public:
 	int m_id = -1;
 	int m_health = 100;
@@ -40,8 +46,9 @@ public:
 	IntVector2 m_accessCoordinate;
 	Vector2 m_accessPosition;
 	ePointOfInterestType m_type;
+	int m_indexInPointOfInterestList = -1;
 
-	Stopwatch* m_refillTimer = new Stopwatch();
+	TimerHandle m_refillTimer = INVALID_TIMER_HANDLE;
 	Map* m_map = nullptr;
 
 	//for now all poi are 2x2 blocks with an access point randomly touching one
@@ -10,13 +10,19 @@
 #include "Game\GameStates\AnalysisSelectState.hpp"
 #include "Game\GameStates\AnalysisState.hpp"
 #include "Game\Definitions\SimulationDefinition.hpp"
+#include "Game\Definitions\PlanDefinition.hpp"
+#include "Game\Definitions\SimulationSweepDefinition.hpp"
+#include "Game\Helpers\SweepRunner.hpp"
 #include "Game\Helpers\AnalysisData.hpp"
+#include "Game\Helpers\AnalysisScope.hpp"
+#include "Game\Helpers\RenderSnapshot.hpp"
 #include "Engine\Renderer\Renderer.hpp"
 #include "Engine\Core\EngineCommon.hpp"
 #include "Engine\Window\Window.hpp"
 #include "Engine\Core\EngineCommon.hpp"
 #include "Engine\File\FIleHelpers.hpp"
 #include "Engine\Profiler\Profiler.hpp"
+#include "Engine\Core\DevConsole.hpp"
 #include <vector>
 #include <string>
 
@@ -48,6 +54,7 @@ Game::~Game()
 	m_gameCamera = nullptr;
 
 	//cleanup global members
+	AnalysisData::StopSampleWriter();
 
 	//add any other data to cleanup
 }
@@ -119,6 +126,16 @@ void Game::Initialize()
 	InitializeSimulationDefinitions();
 	InitializeAnalysisData();
 
+	RegisterCommand("run_sweep", CommandRegistration(RunSweep, ": Run a sweep from Sweeps.xml across worker processes (int sweepIndex)", ""));
+	RegisterCommand("benchmark_analysis_scopes", CommandRegistration(BenchmarkAnalysisScopes, ": Check that compiled out analysis timers cost nothing (int numIterations)", ""));
+	RegisterCommand("check_render_snapshots", CommandRegistration(CheckRenderSnapshots, ": Hand snapshots between two threads and check every one the consumer gets (int numTicks)", ""));
+
+	//sweep workers skip the menus and run their share of the sweep
+	if (IsSweepWorker())
+	{
+		StartSweepWorker();
+	}
+
 	// cleanup
 	theRenderer = nullptr;
 	theWindow = nullptr;
@@ -185,6 +202,8 @@ void Game::InitializeAgentDefinitions()
 void Game::InitializeSimulationDefinitions()
 {
 	SimulationDefinition::Initialize("Data/Simulations/Simulations.xml");
+	PlanDefinition::Initialize("Data/Simulations/PlanDefinitions.xml");
+	SimulationSweepDefinition::Initialize("Data/Simulations/Sweeps.xml");
 
 	//add all simulations to the current list
 	for (int simulationIndex = 0; simulationIndex < SimulationDefinition::s_simulationDefinitions.size(); ++simulationIndex)
@@ -193,6 +212,25 @@ void Game::InitializeSimulationDefinitions()
 	}
 }
 
+//  =========================================================================================
+void Game::StartSweepWorker()
+{
+	const SweepWorkerInfo& workerInfo = GetSweepWorkerInfo();
+	ASSERT_OR_DIE(workerInfo.m_sweepIndex < (int)SimulationSweepDefinition::s_sweepDefinitions.size(), Stringf("INVALID SWEEP INDEX: %i", workerInfo.m_sweepIndex));
+
+	m_selectedDefinitions.clear();
+	SimulationSweepDefinition::s_sweepDefinitions[workerInfo.m_sweepIndex]->GetDefinitionsForWorker(workerInfo.m_workerIndex, workerInfo.m_numWorkers, m_selectedDefinitions);
+
+	//more workers than combinations leaves some with nothing to do
+	if (m_selectedDefinitions.size() == 0)
+	{
+		g_isQuitting = true;
+		return;
+	}
+
+	GameState::TransitionGameStates(GameState::GetGameStateFromGlobalListByType(PLAYING_GAME_STATE));
+}
+
 //  =========================================================================================
 void Game::InitializeAnalysisData()
 {
@@ -223,6 +261,51 @@ void ToggleGamePaused(Command& cmd)
 	m_isPaused =  !m_isPaused;
 }
 
+// sweep command =============================================================================
+void RunSweep(Command& cmd)
+{
+	int sweepIndex = cmd.GetNextInt();
+	int numSweeps = (int)SimulationSweepDefinition::s_sweepDefinitions.size();
+
+	if (sweepIndex < 0 || sweepIndex >= numSweeps)
+	{
+		DevConsolePrintf(Rgba::RED, "Invalid sweep index %i (%i sweeps loaded)", sweepIndex, numSweeps);
+		return;
+	}
+
+	SimulationSweepDefinition* sweep = SimulationSweepDefinition::s_sweepDefinitions[sweepIndex];
+	int numLaunched = LaunchSweepWorkers(sweepIndex);
+
+	DevConsolePrintf(Rgba::GREEN, "Sweep %s: %i simulations across %i workers", sweep->m_name.c_str(), (int)sweep->m_definitions.size(), numLaunched);
+}
+
+// analysis scope benchmark command =============================================================================
+void BenchmarkAnalysisScopes(Command& cmd)
+{
+	int numIterations = cmd.GetNextInt();
+	if (numIterations <= 0)
+		numIterations = 10000000;
+
+	AnalysisScopeBenchmarkResults results = RunAnalysisScopeBenchmark(numIterations);
+	double overheadPercent = results.m_baselineSeconds > 0.0 ? ((results.m_skippedScopeSeconds / results.m_baselineSeconds) - 1.0) * 100.0 : 0.0;
+
+	DevConsolePrintf(Rgba::GREEN, "%i iterations: bare %fs, skipped timer %fs (%.2f%%)", numIterations, results.m_baselineSeconds, results.m_skippedScopeSeconds, overheadPercent);
+}
+
+// render snapshot check command =============================================================================
+void CheckRenderSnapshots(Command& cmd)
+{
+	int numTicks = cmd.GetNextInt();
+	if (numTicks <= 0)
+		numTicks = 100000;
+
+	RenderSnapshotCheckResults results = RunRenderSnapshotCheck(numTicks);
+	bool didPass = results.m_didSeeLastTick && results.m_numMismatched == 0 && results.m_numOutOfOrder == 0;
+
+	DevConsolePrintf(didPass ? Rgba::GREEN : Rgba::RED, "%s: %i published, %i acquired, %i mismatched, %i out of order", 
+		didPass ? "Passed" : "Failed", results.m_numPublished, results.m_numAcquired, results.m_numMismatched, results.m_numOutOfOrder);
+}
+
 //  =========================================================================================
 Clock* GetGameClock()
 {
@@ -9,6 +9,7 @@
 #include "Engine\ParticleSystem\ParticleEmitter.hpp"
 #include "Engine\Renderer\ForwardRenderingPath2D.hpp"
 #include "Engine\Math\RNG.hpp"
+#include "Engine\Core\Command.hpp"
 #include <vector>
 
 class Game
@@ -32,6 +33,7 @@ public:
 	void InitializeAgentDefinitions();
 	void InitializeSimulationDefinitions();
 	void InitializeAnalysisData();
+	void StartSweepWorker();
 
 public:  
 
@@ -45,6 +47,9 @@ public:
 	int m_currentSimDefinitionIndex = 0;
 };
 
+void RunSweep(Command& cmd);
+void BenchmarkAnalysisScopes(Command& cmd);
+void CheckRenderSnapshots(Command& cmd);
 Clock* GetGameClock();
 
 
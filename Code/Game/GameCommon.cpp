@@ -3,6 +3,7 @@
 #include "Game\Game.hpp"
 #include "Game\Definitions\SimulationDefinition.hpp"
 #include "Game\Helpers\AnalysisData.hpp"
+#include "Game\Helpers\RandomStream.hpp"
 #include "Engine\Window\Window.hpp"
 
 IntVector2 BUILDING_DIMENSIONS = IntVector2(2, 2);
@@ -53,6 +54,8 @@ uint64_t g_previousSortTime = 0;
 uint64_t g_previousFrameNonAgentUpdateTime = 0;
 uint64_t g_agentUpdateBudgetThisFrame = 0;
 int g_agentsUpdatedThisFrame = 0;
+uint64_t g_perPlanningSliceHPCBudget = 0; //0 evaluates every plan in one go
+int g_maxPlanningSlicesBeforeCommit = 4;
 
 //general globals
 int g_maxHealth = 100;
@@ -82,11 +85,11 @@ int g_bombardmentDamage = 10.f;
 float g_sortTimerInSeconds = 0.5f;
 float g_agentCopyDestinationPositionRadius = 0.5f;
 
-int g_numMemoizationStorageAccesses = 0;
-int g_numMemoizationUtilityCalls = 0;
+PerThreadCounter g_numMemoizationStorageAccesses;
+PerThreadCounter g_numMemoizationUtilityCalls;
 
-int g_numTestMemoizationExtremeUtilityCalls = 0;
-int g_numTestMemoizationStorageAccesses = 0;
+PerThreadCounter g_numTestMemoizationExtremeUtilityCalls;
+PerThreadCounter g_numTestMemoizationStorageAccesses;
 
 //threat globals
 float g_maxThreat = 500.f;
@@ -149,10 +152,8 @@ bool GetIsAgentUpdateBudgeted()
 }
 
 //  =========================================================================================
-void ShuffleList(std::vector<int>& list)
+void ShuffleList(std::vector<int>& list, RandomStream& randomStream)
 {
-	RNG* theRNG = Game::GetGlobalRNG();
-
 	//no need to shuffle
 	if(list.size() <= 1)
 		return;
@@ -162,8 +163,8 @@ void ShuffleList(std::vector<int>& list)
 	//not totally random would need to revisit this, but will do for now.
 	for (int shuffleCount = 0; shuffleCount < (int)list.size(); ++shuffleCount)
 	{
-		int swapVal = (int)theRNG->GetRandomUintInRange(0, maxIndex);
-		int swapVal2 = (int)theRNG->GetRandomUintInRange(0, maxIndex);
+		int swapVal = randomStream.GetNextIntInRange(0, maxIndex);
+		int swapVal2 = randomStream.GetNextIntInRange(0, maxIndex);
 
 		int tempVal = 0;
 		// swap cards around in array
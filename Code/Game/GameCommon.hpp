@@ -5,6 +5,7 @@
 #include "Engine\Math\Vector3.hpp"
 #include "Engine\Math\IntVector2.hpp"
 #include "Engine\Core\Rgba.hpp"
+#include "Game\Helpers\AnalysisSampleRing.hpp"
 #include <vector>
 
 #define ActionStackAnalysis
@@ -21,12 +22,13 @@
 class SimulationData;
 class SimulationDefinition;
 class AnalysisData;
+class RandomStream;
 
 bool GetIsOptimized();
 bool GetIsAgentUpdateBudgeted();
 
 //helper methods
-void ShuffleList(std::vector<int>& list);
+void ShuffleList(std::vector<int>& list, RandomStream& randomStream);
 Vector2 FloorPosition(const Vector2& position);
 
 constexpr float RANDOM_FIRE_THRESHOLD = 0.95f;
@@ -92,6 +94,8 @@ extern uint64_t g_previousSortTime;
 extern uint64_t g_previousFrameNonAgentUpdateTime;
 extern uint64_t g_agentUpdateBudgetThisFrame;
 extern int g_agentsUpdatedThisFrame;
+extern uint64_t g_perPlanningSliceHPCBudget;
+extern int g_maxPlanningSlicesBeforeCommit;
 
 //general globals
 extern int g_maxHealth;
@@ -121,11 +125,11 @@ extern int g_bombardmentDamage;
 extern float g_sortTimerInSeconds;
 extern float g_agentCopyDestinationPositionRadius;
 
-extern int g_numMemoizationUtilityCalls;
-extern int g_numMemoizationStorageAccesses;
+extern PerThreadCounter g_numMemoizationUtilityCalls;
+extern PerThreadCounter g_numMemoizationStorageAccesses;
 
-extern int g_numTestMemoizationExtremeUtilityCalls;
-extern int g_numTestMemoizationStorageAccesses;
+extern PerThreadCounter g_numTestMemoizationExtremeUtilityCalls;
+extern PerThreadCounter g_numTestMemoizationStorageAccesses;
 
 
 //threat globals
@@ -178,6 +182,11 @@ constexpr char* MAP_NAME_OUTPUT_TEXT = "MapName";
 constexpr char* STARTING_TIME_OUTPUT_TEXT = "StartingTime";
 constexpr char* OPTIMIZED_OUTPUT_TEXT = "IsOptimized";
 constexpr char* BUDGETED_OUTPUT_TEXT = "IsBudgeted";
+constexpr char* UTILITY_STORAGE_DIVISIONS_OUTPUT_TEXT = "UtilityStorageDivisions";
+constexpr char* SORT_TIMER_OUTPUT_TEXT = "SortTimerInSeconds";
+constexpr char* AGENT_COPY_RADIUS_OUTPUT_TEXT = "AgentCopyDestinationPositionRadius";
+constexpr char* PLANNING_SLICE_BUDGET_OUTPUT_TEXT = "PlanningSliceBudgetInSeconds";
+constexpr char* RANDOM_SEED_OUTPUT_TEXT = "Seed";
 constexpr char* NUM_UPDATE_PLAN_CALLS_OUTPUT_TEXT = "Num Update Plan Calls";
 constexpr char* NUM_PROCESS_ACTION_STACK_CALLS_OUTPUT_TEXT = "Num Process Action Stack Calls";
 constexpr char* NUM_AGENT_UPDATE_CALLS_OUTPUT_TEXT = "Num Agent Update Calls";
@@ -149,8 +149,13 @@ void AnalysisState::InitializeSimulationAnalysisData()
 		{
 			selectableForGraphCount++;
 
+			//percentiles are exported under the same file name in the Percentiles folder
+			std::string profiledFileName = "";
+			GetFileNameFromPathNoExtension(containedFilePaths[fileIndex], profiledFileName);
+			std::string percentilesFilePath = Stringf("%s%s%s%s", simulationDefinitionPaths[definitionIndex].c_str(), "\\Percentiles\\", profiledFileName.c_str(), ".csv");
+
 			//generate sim data
-			ImportedProfiledSimulationData* profiledData = GenerateProfiledSimulationDataFromFile(definitionName, containedFilePaths[fileIndex]);
+			ImportedProfiledSimulationData* profiledData = GenerateProfiledSimulationDataFromFile(definitionName, containedFilePaths[fileIndex], percentilesFilePath);
 
 			//add option to list of selectable sims
 			int optionIndex = (int)m_allSelectableOptions.size();
@@ -505,7 +510,7 @@ std::string AnalysisState::GetProfiledNameFromFileName(const std::string& filePa
 }
 
 //  =========================================================================================
-ImportedProfiledSimulationData* AnalysisState::GenerateProfiledSimulationDataFromFile(const std::string& definitionName, const std::string& filePath)
+ImportedProfiledSimulationData* AnalysisState::GenerateProfiledSimulationDataFromFile(const std::string& definitionName, const std::string& filePath, const std::string& percentilesFilePath)
 {
 	//perform calculation
 	ImportedProfiledSimulationData* simData = new ImportedProfiledSimulationData(definitionName, filePath);
@@ -524,10 +529,43 @@ ImportedProfiledSimulationData* AnalysisState::GenerateProfiledSimulationDataFro
 	}	
 
 	FillSimData(simData, contentAsFloats);
+	ReadLatencyPercentilesFromFile(simData, percentilesFilePath);
 
 	return simData;
 }
 
+//  =========================================================================================
+void AnalysisState::ReadLatencyPercentilesFromFile(ImportedProfiledSimulationData* simData, const std::string& percentilesFilePath)
+{
+	//older exports don't have percentiles
+	CSVEditor editor;
+	if (!editor.ReadFromFile(percentilesFilePath))
+		return;
+
+	//count, min, each percentile, max (see SimulationData::ExportLatencyPercentilesCSV)
+	int numExpectedEntries = NUM_LATENCY_PERCENTILES + 3;
+	if ((int)editor.m_content.size() < numExpectedEntries)
+		return;
+
+	std::vector<float> contentAsFloats;
+	for (int entryIndex = 0; entryIndex < numExpectedEntries; ++entryIndex)
+	{
+		float valueAsFloat = ConvertStringToFloat(editor.m_content[entryIndex]);
+		ASSERT_OR_DIE(valueAsFloat != FLOAT_MAX, "INVALID READ FOR LATENCY PERCENTILES FILE!!");
+
+		contentAsFloats.push_back(valueAsFloat);
+	}
+
+	simData->m_recordedCalls = (int)contentAsFloats[0];
+	simData->m_fastestCall = contentAsFloats[1];
+	for (int percentileIndex = 0; percentileIndex < NUM_LATENCY_PERCENTILES; ++percentileIndex)
+	{
+		simData->m_percentiles[percentileIndex] = contentAsFloats[percentileIndex + 2];
+	}
+	simData->m_slowestCall = contentAsFloats[NUM_LATENCY_PERCENTILES + 2];
+	simData->m_hasPercentiles = simData->m_recordedCalls > 0;
+}
+
 //  =========================================================================================
 void AnalysisState::GenerateSimulationGeneralInfoFromFile(SimulationDefinitionContents* outContents, const std::string& definitionName, const std::string& rootPath)
 {
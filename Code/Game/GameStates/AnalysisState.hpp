@@ -1,6 +1,7 @@
 #pragma once
 #include "Game\GameStates\GameState.hpp"
 #include "Game\Helpers\AnalysisGraph.hpp"
+#include "Game\Helpers\LatencyHistogram.hpp"
 #include "Engine\Core\Rgba.hpp"
 #include "Engine\Math\IntRange.hpp"
 #include "Engine\Core\StringUtils.hpp"
@@ -55,6 +56,17 @@ struct ImportedProfiledSimulationData
 		outContent.push_back(Stringf("Interval 95: %f", m_confidenceInterval95));
 		outContent.push_back(Stringf("Interval Low: %f", m_confidenceIntervalRangeLow));
 		outContent.push_back(Stringf("Interval High: %f", m_confidenceIntervalRangeHigh));
+
+		if (!m_hasPercentiles)
+			return;
+
+		outContent.push_back(Stringf("Recorded Calls: %i", m_recordedCalls));
+		outContent.push_back(Stringf("Fastest Call: %f", m_fastestCall));
+		for (int percentileIndex = 0; percentileIndex < NUM_LATENCY_PERCENTILES; ++percentileIndex)
+		{
+			outContent.push_back(Stringf("%s: %f", g_latencyPercentileNames[percentileIndex], m_percentiles[percentileIndex]));
+		}
+		outContent.push_back(Stringf("Slowest Call: %f", m_slowestCall));
 	}
 
 	std::string m_simulationDefinitionContentsNameKey;
@@ -71,6 +83,13 @@ struct ImportedProfiledSimulationData
 	float m_confidenceInterval95 = 0.f;
 	float m_confidenceIntervalRangeLow = 0.f;
 	float m_confidenceIntervalRangeHigh = 0.f;
+
+	//from the latency histogram of every call, not just the logged samples
+	bool m_hasPercentiles = false;
+	int m_recordedCalls = 0;
+	float m_fastestCall = 0.f;
+	float m_percentiles[NUM_LATENCY_PERCENTILES] = {};
+	float m_slowestCall = 0.f;
 };
 
 //  ----------------------------------------------
@@ -150,7 +169,8 @@ private:
 	std::string GetProfiledNameFromFileName(const std::string& filePath);
 
 	//profile generation
-	ImportedProfiledSimulationData* GenerateProfiledSimulationDataFromFile(const std::string& definitionName, const std::string& filePath);
+	ImportedProfiledSimulationData* GenerateProfiledSimulationDataFromFile(const std::string& definitionName, const std::string& filePath, const std::string& percentilesFilePath);
+	void ReadLatencyPercentilesFromFile(ImportedProfiledSimulationData* simData, const std::string& percentilesFilePath);
 	void GenerateSimulationGeneralInfoFromFile(SimulationDefinitionContents* outContents, const std::string& definitionName, const std::string& rootPath);
 
 	//computations
@@ -6,6 +6,7 @@
 #include "Game\UI\DebugInputBox.hpp"
 #include "Game\Helpers\AnalysisData.hpp"
 #include "Game\Helpers\AnalysisData.hpp"
+#include "Game\Helpers\SweepRunner.hpp"
 #include "Engine\Window\Window.hpp"
 #include "Engine\Debug\DebugRender.hpp"
 #include "Engine\Core\LightObject.hpp"
@@ -18,6 +19,7 @@
 #include "Engine\Renderer\Mesh.hpp"
 #include "Engine\Math\AABB2.hpp"
 #include "Engine\Time\SimpleTimer.hpp"
+#include "Engine\Time\Time.hpp"
 #include "Engine\Profiler\Profiler.hpp"
 #include <map>
 #include <string>
@@ -73,7 +75,7 @@ void PlayingState::Initialize()
 	//set game camera
 	m_camera = new Camera();
 	m_camera->SetColorTarget(theRenderer->GetDefaultRenderTarget());
-	m_camera->SetOrtho(0.f, 32.f, 0.f, 18.f, -1000.f, 1000.f);
+	m_camera->SetOrtho(m_cameraOrthoBounds.mins.x, m_cameraOrthoBounds.maxs.x, m_cameraOrthoBounds.mins.y, m_cameraOrthoBounds.maxs.y, -1000.f, 1000.f);
 	m_camera->SetView(Matrix44::IDENTITY);	
 
 	g_orthoZoom = 1.f;
@@ -86,6 +88,8 @@ void PlayingState::Initialize()
 	RegisterCommand("agent", CommandRegistration(DisectAgent, ": View information for given agent. (int agentId)", ""));
 	RegisterCommand("toggle_ids", CommandRegistration(ToggleAgentIds, ": View agent ids", ""));
 	RegisterCommand("toggle_blocks", CommandRegistration(ToggleBlockedData, ": View tile physics data", ""));
+	RegisterCommand("save_snapshot", CommandRegistration(SaveSnapshot, ": Save a checkpoint of the running simulation", ""));
+	RegisterCommand("load_snapshot", CommandRegistration(LoadSnapshot, ": Restore the last saved (or the definition's) checkpoint", ""));
 
 	//simulation setup
 	GenerateOutputDirectory();
@@ -124,17 +128,57 @@ void PlayingState::Update(float deltaSeconds)
 
 	if (!GetGameClock()->IsPaused())
 	{
+		//sweep workers run as fast as they can on a fixed step instead of following the clock
+		if (IsSweepWorker())
+		{
+			UpdateSweepSimulation();
+			return;
+		}
+
 		m_map->Update(deltaSeconds);
 
 		UpdateFPSCounters();
 
-		if (m_simulationTimer->ResetAndDecrementIfElapsed())
+		//replays run until the log is used up rather than for the recorded run's wall clock time
+		if (m_map->m_replayLog.IsPlayingBack())
+		{
+			if (m_map->m_replayLog.IsPlaybackFinished())
+				isResetingSimulation = true;
+		}
+		else if (m_simulationTimer->ResetAndDecrementIfElapsed())
 		{
 			isResetingSimulation = true;
 		}		
 	}
 }
 
+//  =============================================================================
+void PlayingState::UpdateSweepSimulation()
+{
+	//step for a slice of wall time then hand the frame back so the window keeps pumping messages
+	uint64_t endHPC = GetPerformanceCounter() + SecondsToPerformanceCounter(SWEEP_MAX_STEP_SECONDS_PER_FRAME);
+
+	while (GetPerformanceCounter() < endHPC)
+	{
+		m_map->Update(SWEEP_FIXED_DELTA_SECONDS);
+		m_map->DeleteDeadEntities();
+		m_simulatedSeconds += SWEEP_FIXED_DELTA_SECONDS;
+
+		//processTimerInSeconds is simulated time for sweeps
+		bool isFinished = false;
+		if (m_map->m_replayLog.IsPlayingBack())
+			isFinished = m_map->m_replayLog.IsPlaybackFinished();
+		else
+			isFinished = m_simulatedSeconds >= g_currentSimulationDefinition->m_totalProcessingTimeInSeconds;
+
+		if (isFinished)
+		{
+			isResetingSimulation = true;
+			return;
+		}
+	}
+}
+
 //  =============================================================================
 void PlayingState::PreRender()
 {
@@ -151,7 +195,9 @@ void PlayingState::PreRender()
 void PlayingState::Render()
 {
 	PROFILER_PUSH();
-	if (GameState::IsTransitioning())
+
+	//nobody is watching sweep workers
+	if (GameState::IsTransitioning() || IsSweepWorker())
 		return;
 
 	//this timer determines how much time we have for all of our agent update.
@@ -264,6 +310,7 @@ float PlayingState::UpdateFromInput(float deltaSeconds)
 	{
 		g_orthoZoom = Window::GetInstance()->GetClientHeight();
 		m_camera->SetProjectionOrtho(g_orthoZoom, CLIENT_ASPECT, -1000.f, 1000.f);
+		m_cameraOrthoBounds = AABB2(Vector2::ZERO, g_orthoZoom * CLIENT_ASPECT * 0.5f, g_orthoZoom * 0.5f);
 	}
 
 	// show tile data ----------------------------------------------
@@ -362,11 +409,23 @@ void PlayingState::RenderGame()
 
 	Renderer* theRenderer = Renderer::GetInstance();
 	theRenderer->SetCamera(m_camera);
+
+	//only what the camera can see builds vertices
+	m_map->SetViewBounds(GetCameraViewBounds());
 	m_map->Render();
 
 	theRenderer = nullptr;
 }
 
+//  =========================================================================================
+AABB2 PlayingState::GetCameraViewBounds() const
+{
+	Vector3 cameraPosition = m_camera->m_transform->GetWorldPosition();
+	Vector2 cameraOffset = Vector2(cameraPosition.x, cameraPosition.y);
+
+	return AABB2(m_cameraOrthoBounds.mins.x + cameraOffset.x, m_cameraOrthoBounds.mins.y + cameraOffset.y, m_cameraOrthoBounds.maxs.x + cameraOffset.x, m_cameraOrthoBounds.maxs.y + cameraOffset.y);
+}
+
 //  =========================================================================================
 void PlayingState::RenderDebugUI()
 {
@@ -425,12 +484,14 @@ void PlayingState::InitializeSimulation(SimulationDefinition* definition)
 {
 	//current sim definition
 	g_currentSimulationDefinition = definition;
+
 	InitializeSimulationData();
 
 	//re-adjust camera center
 	Vector2 mapCenter = -1.f * m_map->m_mapWorldBounds.GetCenter();
 	m_camera->SetPosition(Vector3(mapCenter.x, mapCenter.y, 0.f));	
 
+	m_simulatedSeconds = 0.f;
 	m_simulationTimer = new Stopwatch(GetGameClock());
 	m_simulationTimer->SetTimer(g_generalSimulationData->m_simulationDefinitionReference->m_totalProcessingTimeInSeconds);
 }
@@ -438,15 +499,27 @@ void PlayingState::InitializeSimulation(SimulationDefinition* definition)
 //  =============================================================================
 void PlayingState::CreateMapForSimulation(SimulationDefinition* definition)
 {
+	//tunables have to be in place before the map builds its planners and timers
+	definition->ApplyTunables();
+
 	//map creation
 	m_map = new Map(definition, "TestMap", m_renderScene2D);	
 	m_map->Initialize();
 	m_map->m_playingState = this;
+
+	//skip the warm up by starting from a checkpoint
+	m_snapshotFilePath = definition->m_snapshotFilePath;
+	if (!IsStringNullOrEmpty(m_snapshotFilePath))
+	{
+		bool success = m_map->LoadSnapshot(m_snapshotFilePath);
+		ASSERT_OR_DIE(success, Stringf("UNABLE TO LOAD SNAPSHOT (%s)", m_snapshotFilePath.c_str()).c_str());
+	}
 }
 
 //  =============================================================================
 void PlayingState::ResetMapForSimulation(SimulationDefinition* definition)
 {
+	definition->ApplyTunables();
 	m_map->Reload(definition);
 	m_map->m_playingState = this;
 }
@@ -528,11 +601,17 @@ void PlayingState::InitializeSimulationData()
 	g_testExtremeMemoizationAnalysisData->m_data = g_testExtremeMemoizationData;
 	g_testExtremeMemoizationAnalysisData->FullReset();
 #endif // TestExtremeMemoizationDataAnalysis
+
+	//samples move out of the per thread rings in the background while the sim runs
+	AnalysisData::StartSampleWriter();
 }
 
 //  =============================================================================
 void PlayingState::ResetCurrentSimulationData()
 {
+	//nothing can be draining into the data we are about to delete
+	AnalysisData::StopSampleWriter();
+
 	delete(g_generalSimulationData);
 	g_generalSimulationData = nullptr;
 
@@ -591,8 +670,8 @@ void PlayingState::ResetCurrentSimulationData()
 #endif
 
 	//reset memoization variables
-	g_numMemoizationUtilityCalls = 0;
-	g_numMemoizationStorageAccesses = 0;
+	g_numMemoizationUtilityCalls.Reset();
+	g_numMemoizationStorageAccesses.Reset();
 }
 
 //  =============================================================================
@@ -634,6 +713,11 @@ void PlayingState::LoadNextSim()
 		InitializeSimulation(definition);
 		//}		
 	}
+	else if (IsSweepWorker())
+	{
+		//worker is done with its share of the sweep
+		g_isQuitting = true;
+	}
 	else
 	{
 		ResetState();
@@ -647,6 +731,9 @@ void PlayingState::LoadNextSim()
 //  =============================================================================
 void PlayingState::ExportSimulationData()
 {
+	//flushes the last samples and call counts into the simulation data
+	AnalysisData::StopSampleWriter();
+
 	std::string newFolder = "";
 	bool isFolderValid = false;
 	int iterationCount = 0;
@@ -684,9 +771,24 @@ void PlayingState::ExportSimulationData()
 	bool success = g_generalSimulationData->ExportCSV(generalInfoFilePath, fileName.c_str());
 	ASSERT_OR_DIE(success, "General Info data broken");
 
+	//latency percentiles. same file names as the sample csvs so analysis can pair them up
+	std::string percentilesFolder = Stringf("%s%s", finalFilePath.c_str(), "Percentiles");
+	std::string percentilesFilePath = Stringf("%s%s", finalFilePath.c_str(), "Percentiles\\");
+	CreateFolder(percentilesFolder.c_str());
+
+	//replay log so this run can be played back with replayFile
+	if (m_map->m_replayLog.IsRecording())
+	{
+		fileName = Stringf("%sReplay_%s.replay", finalFilePath.c_str(), g_currentSimulationDefinition->m_name.c_str());
+		success = m_map->m_replayLog.WriteToFile(fileName);
+		ASSERT_OR_DIE(success, "Replay log broken");
+	}
+
 #ifdef ActionStackAnalysis
 	//export action stack data
 	fileName = Stringf("ActionStackAverageTimesPer_%s.csv", g_currentSimulationDefinition->m_name.c_str());
+	success = g_processActionStackData->ExportLatencyPercentilesCSV(percentilesFilePath, fileName.c_str());
+	ASSERT_OR_DIE(success, "Latency percentiles broken");
 	success = g_processActionStackData->ExportCSV(finalFilePath, fileName.c_str());
 	ASSERT_OR_DIE(success, "Action data broken");
 #endif
@@ -694,6 +796,8 @@ void PlayingState::ExportSimulationData()
 #ifdef UpdatePlanAnalysis
 	//export update plan data
 	fileName = Stringf("AgentUpdatePlanAverageTimesPer_%s.csv", g_currentSimulationDefinition->m_name.c_str());
+	success = g_updatePlanData->ExportLatencyPercentilesCSV(percentilesFilePath, fileName.c_str());
+	ASSERT_OR_DIE(success, "Latency percentiles broken");
 	success = g_updatePlanData->ExportCSV(finalFilePath, fileName.c_str());
 	ASSERT_OR_DIE(success, "Update plan data broken");
 #endif
@@ -701,6 +805,8 @@ void PlayingState::ExportSimulationData()
 #ifdef AgentUpdateAnalysis
 	//export agent update data
 	fileName = Stringf("AgentUpdateAverageTimes_%s.csv", g_currentSimulationDefinition->m_name.c_str());
+	success = g_agentUpdateData->ExportLatencyPercentilesCSV(percentilesFilePath, fileName.c_str());
+	ASSERT_OR_DIE(success, "Latency percentiles broken");
 	success = g_agentUpdateData->ExportCSV(finalFilePath, fileName.c_str());
 	ASSERT_OR_DIE(success, "Update data broken");
 #endif
@@ -708,6 +814,8 @@ void PlayingState::ExportSimulationData()
 #ifdef PathingDataAnalysis
 	//export stack data
 	fileName = Stringf("PathingDataAveragesTimesPer_%s.csv", g_currentSimulationDefinition->m_name.c_str());
+	success = g_pathingData->ExportLatencyPercentilesCSV(percentilesFilePath, fileName.c_str());
+	ASSERT_OR_DIE(success, "Latency percentiles broken");
 	success = g_pathingData->ExportCSV(finalFilePath, fileName.c_str());
 	ASSERT_OR_DIE(success, "Pathing data broken");
 #endif
@@ -715,18 +823,24 @@ void PlayingState::ExportSimulationData()
 #ifdef CopyPathAnalysis
 	//action stack data
 	fileName = Stringf("CopyPathAverageTimersPer_%s.csv", g_currentSimulationDefinition->m_name.c_str());
+	success = g_copyPathData->ExportLatencyPercentilesCSV(percentilesFilePath, fileName.c_str());
+	ASSERT_OR_DIE(success, "Latency percentiles broken");
 	success = g_copyPathData ->ExportCSV(finalFilePath, fileName.c_str());
 	ASSERT_OR_DIE(success, "Copy path data broken");
 #endif
 
 #ifdef QueueActionPathingDataAnalysis
 	fileName = Stringf("QueueActionPathingTimes_%s.csv", g_currentSimulationDefinition->m_name.c_str());
+	success = g_queueActionPathingData->ExportLatencyPercentilesCSV(percentilesFilePath, fileName.c_str());
+	ASSERT_OR_DIE(success, "Latency percentiles broken");
 	success = g_queueActionPathingData ->ExportCSV(finalFilePath, fileName.c_str());
 	ASSERT_OR_DIE(success, "Que action pathing broken");
 #endif
 
 #ifdef CollisionDataAnalysis
 	fileName = Stringf("CollisionCalculationTimes_%s.csv", g_currentSimulationDefinition->m_name.c_str());
+	success = g_collisionData->ExportLatencyPercentilesCSV(percentilesFilePath, fileName.c_str());
+	ASSERT_OR_DIE(success, "Latency percentiles broken");
 	success = g_collisionData ->ExportCSV(finalFilePath, fileName.c_str());
 	ASSERT_OR_DIE(success, "Collision data broken");
 #endif
@@ -734,12 +848,16 @@ void PlayingState::ExportSimulationData()
 
 #ifdef MemoizationDataAnalysis
 	fileName = Stringf("MemoizationCalculationTimes_%s.csv", g_currentSimulationDefinition->m_name.c_str());
+	success = g_memoizationData->ExportLatencyPercentilesCSV(percentilesFilePath, fileName.c_str());
+	ASSERT_OR_DIE(success, "Latency percentiles broken");
 	success = g_memoizationData->ExportCSV(finalFilePath, fileName.c_str());
 	ASSERT_OR_DIE(success, "Memoization data broken");
 #endif
 
 #ifdef TestExtremeMemoizationDataAnalysis
 	fileName = Stringf("ExtremeMemoizationTimes_%s.csv", g_currentSimulationDefinition->m_name.c_str());
+	success = g_testExtremeMemoizationData->ExportLatencyPercentilesCSV(percentilesFilePath, fileName.c_str());
+	ASSERT_OR_DIE(success, "Latency percentiles broken");
 	success = g_testExtremeMemoizationData->ExportCSV(finalFilePath, fileName.c_str());
 	ASSERT_OR_DIE(success, "Extreme Memoization data broken");
 #endif
@@ -748,6 +866,13 @@ void PlayingState::ExportSimulationData()
 //  =============================================================================
 void PlayingState::GenerateOutputDirectory()
 {
+	//every worker in a sweep shares the folder the launcher made
+	if (IsSweepWorker())
+	{
+		simDataOutputDirectory = GetSweepWorkerInfo().m_outputDirectory;
+		return;
+	}
+
 	std::string newFolderName = Stringf("SIMULATION_TEST_%s", GetCurrentDateTime().c_str());
 	std::string newPath =  Stringf("%s%s", "Data\\ExportedSimulationData\\", newFolderName.c_str());
 
@@ -795,20 +920,20 @@ void PlayingState::FinalizeGeneralSimulationData()
 
 #ifdef MemoizationCountDataAnalysis
 	//write counts for memoization
-	g_generalSimulationData->AddCell(Stringf("%s: %i", NUM_MEMOIZATION_STANDARD_CALLS_OUTPUT_TEXT, g_numMemoizationUtilityCalls));
+	g_generalSimulationData->AddCell(Stringf("%s: %i", NUM_MEMOIZATION_STANDARD_CALLS_OUTPUT_TEXT, (int)g_numMemoizationUtilityCalls.GetTotal()));
 	g_generalSimulationData->AddNewLine();
 
-	g_generalSimulationData->AddCell(Stringf("%s: %i", NUM_MEMOIZATION_OPTIMIZED_ACCESSES_OUTPUT_TEXT, g_numMemoizationStorageAccesses));
+	g_generalSimulationData->AddCell(Stringf("%s: %i", NUM_MEMOIZATION_OPTIMIZED_ACCESSES_OUTPUT_TEXT, (int)g_numMemoizationStorageAccesses.GetTotal()));
 	g_generalSimulationData->AddNewLine();
 	
 #endif
 
 #ifdef TestExtremeMemoizationDataAnalysis
 	//write counts for memoization
-	g_generalSimulationData->AddCell(Stringf("%s: %i", NUM_EXTREME_MEMOIZATION_STANDARD_CALLS_OUTPUT_TEXT, g_numTestMemoizationExtremeUtilityCalls));
+	g_generalSimulationData->AddCell(Stringf("%s: %i", NUM_EXTREME_MEMOIZATION_STANDARD_CALLS_OUTPUT_TEXT, (int)g_numTestMemoizationExtremeUtilityCalls.GetTotal()));
 	g_generalSimulationData->AddNewLine();
 
-	g_generalSimulationData->AddCell(Stringf("%s: %i", NUM_EXTREME_MEMOIZATION_OPTIMIZED_ACCESSES_OUTPUT_TEXT, g_numTestMemoizationStorageAccesses));
+	g_generalSimulationData->AddCell(Stringf("%s: %i", NUM_EXTREME_MEMOIZATION_OPTIMIZED_ACCESSES_OUTPUT_TEXT, (int)g_numTestMemoizationStorageAccesses.GetTotal()));
 	g_generalSimulationData->AddNewLine();
 #endif
 
@@ -858,6 +983,10 @@ Mesh* PlayingState::CreateUIDebugTextMesh()
 	AABB2 threatBox = AABB2(theWindow->GetClientWindow(), Vector2(0.8f, 0.7f), Vector2(0.95f, 0.8f));
 	builder.CreateText2DInAABB2(threatBox.GetCenter(), threatBox.GetDimensions(), 1.f, Stringf("Threat: %i/%i", (int)m_map->m_threat, (int)g_maxThreat), Rgba::WHITE);
 
+	//view culling ----------------------------------------------
+	AABB2 cullingBox = AABB2(theWindow->GetClientWindow(), Vector2(0.8f, 0.66f), Vector2(0.95f, 0.7f));
+	builder.CreateText2DInAABB2(cullingBox.GetCenter(), cullingBox.GetDimensions(), 1.f, Stringf("Culled: %i agents %i fires %i bombs", m_map->m_numAgentsCulled, m_map->m_numFiresCulled, m_map->m_numBombardmentsCulled), Rgba::WHITE);
+
 	//debug input ----------------------------------------------
 	DebugInputBox* theDebugInputBox = DebugInputBox::GetInstance();
 	std::string inputText = Stringf("> %s", theDebugInputBox->GetInput().c_str());
@@ -920,10 +1049,14 @@ Mesh* PlayingState::CreateDisectedAgentPathMesh()
 	Vector2 agentPosition = m_disectedAgent->m_position;
 
 	//get current index
-	uint8_t pathIndex = m_disectedAgent->m_currentPathIndex;
-	if(pathIndex == UINT8_MAX)
+	int pathIndex = m_disectedAgent->m_currentPathIndex;
+	if(pathIndex == INVALID_PATH_INDEX)
 		pathIndex = 0;
 
+	//nothing to draw until the agent has a path
+	if (m_disectedAgent->m_currentPath.empty())
+		return nullptr;
+
 	//build player to next position in path index
 	Vector2 nextTileCenter = m_disectedAgent->m_currentPath[pathIndex];
 	builder.CreateLine2D(agentPosition, nextTileCenter, Rgba::PINK);
@@ -1031,3 +1164,55 @@ void ToggleAgentIds(Command& cmd)
 {
 	g_isIdShown = !g_isIdShown;
 }
+
+//  =========================================================================================
+void SaveSnapshot(Command& cmd)
+{
+	GameState* currentState = GameState::GetCurrentGameState();
+	if (currentState->m_type != PLAYING_GAME_STATE)
+	{
+		DevConsolePrintf(Rgba::RED, "NO SIMULATION RUNNING!");
+		return;
+	}
+
+	PlayingState* playingState = (PlayingState*)currentState;
+
+	std::string filePath = Stringf("%sSnapshot_%s_%s.snapshot", simDataOutputDirectory.c_str(), g_currentSimulationDefinition->m_name.c_str(), GetCurrentDateTime().c_str());
+	if (!playingState->m_map->SaveSnapshot(filePath))
+	{
+		DevConsolePrintf(Rgba::RED, "UNABLE TO SAVE SNAPSHOT (%s)", filePath.c_str());
+		return;
+	}
+
+	playingState->m_snapshotFilePath = filePath;
+	DevConsolePrintf(Rgba::GREEN, "Saved snapshot %s", filePath.c_str());
+}
+
+//  =========================================================================================
+void LoadSnapshot(Command& cmd)
+{
+	GameState* currentState = GameState::GetCurrentGameState();
+	if (currentState->m_type != PLAYING_GAME_STATE)
+	{
+		DevConsolePrintf(Rgba::RED, "NO SIMULATION RUNNING!");
+		return;
+	}
+
+	PlayingState* playingState = (PlayingState*)currentState;
+	if (IsStringNullOrEmpty(playingState->m_snapshotFilePath))
+	{
+		DevConsolePrintf(Rgba::RED, "NO SNAPSHOT TO LOAD!");
+		return;
+	}
+
+	//restoring rebuilds every agent so drop anything pointing at the old ones
+	playingState->ClearDisectedAgent();
+
+	if (!playingState->m_map->LoadSnapshot(playingState->m_snapshotFilePath))
+	{
+		DevConsolePrintf(Rgba::RED, "SNAPSHOT DOES NOT MATCH THIS SIMULATION (%s)", playingState->m_snapshotFilePath.c_str());
+		return;
+	}
+
+	DevConsolePrintf(Rgba::GREEN, "Loaded snapshot %s", playingState->m_snapshotFilePath.c_str());
+}
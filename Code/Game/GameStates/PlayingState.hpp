@@ -32,9 +32,11 @@ public:
 	virtual void ResetState() override;
 
 	void UpdateFPSCounters();
+	void UpdateSweepSimulation();
 
 	void RenderGame();
 	void RenderDebugUI();
+	AABB2 GetCameraViewBounds() const;
 
 	//simulations
 	void InitializeSimulation(SimulationDefinition* definition);
@@ -64,13 +66,24 @@ public:
 
 	Stopwatch* m_simulationTimer = nullptr;
 
+	//fixed step time sweep workers have run the current sim for
+	float m_simulatedSeconds = 0.f;
+
+	//ortho extents last handed to m_camera, relative to its position
+	AABB2 m_cameraOrthoBounds = AABB2(0.f, 0.f, 32.f, 18.f);
+
 	bool m_isCameraLockedToAgent = false;
 	Agent* m_disectedAgent = nullptr;
 
 	Stopwatch* m_inputDelayTimer = nullptr;
+
+	//most recent checkpoint written or loaded this session
+	std::string m_snapshotFilePath = "";
 };
 
 void TogglePaused(Command& cmd);
 void DisectAgent(Command& cmd);
 void ToggleBlockedData(Command& cmd);
 void ToggleAgentIds(Command& cmd);
+void SaveSnapshot(Command& cmd);
+void LoadSnapshot(Command& cmd);
@@ -2,74 +2,205 @@
 #include "Game\SimulationData.hpp"
 #include "Engine\Time\Time.hpp"
 #include "Engine\Core\StringUtils.hpp"
+#include <thread>
+#include <chrono>
 
+constexpr int SAMPLE_WRITER_SLEEP_MILLISECONDS = 1;
 
+static std::vector<AnalysisData*> s_registeredAnalysisData;
+static std::thread s_sampleWriterThread;
+static std::atomic<bool> s_isSampleWriterRunning(false);
 
 //  =========================================================================================
 AnalysisData::AnalysisData(SimulationData* exportDataReferene, int iterationsBeforeLog)
 {
 	m_data = exportDataReferene;
 	m_iterationsBeforeLog = iterationsBeforeLog;
+
+	//analysis data is created before any simulation starts the writer
+	s_registeredAnalysisData.push_back(this);
 }
 
 //  =========================================================================================
 AnalysisData::~AnalysisData()
 {
+	for (int dataIndex = 0; dataIndex < (int)s_registeredAnalysisData.size(); ++dataIndex)
+	{
+		if (s_registeredAnalysisData[dataIndex] == this)
+		{
+			s_registeredAnalysisData.erase(s_registeredAnalysisData.begin() + dataIndex);
+			break;
+		}
+	}
+
+	for (int threadSlot = 0; threadSlot < MAX_ANALYSIS_THREADS; ++threadSlot)
+	{
+		AnalysisSampleRing* ring = m_threadStates[threadSlot].m_ring.load(std::memory_order_relaxed);
+		delete(ring);
+		m_threadStates[threadSlot].m_ring.store(nullptr, std::memory_order_relaxed);
+
+		delete(m_threadStates[threadSlot].m_histogram);
+		m_threadStates[threadSlot].m_histogram = nullptr;
+	}
+
 	m_data = nullptr;
 }
 
 //  =========================================================================================
-void AnalysisData::Reset()
+void AnalysisData::EnterScope()
 {
-	m_iterationStartHPC = GetPerformanceCounter();
-	m_currentIterationCount = 0;
-	m_timeAverage = 0.0;
+	AnalysisThreadState& threadState = m_threadStates[GetAnalysisThreadSlot()];
+	++threadState.m_scopeDepth;
 }
 
 //  =========================================================================================
-void AnalysisData::Start()
+void AnalysisData::ExitScope(uint64_t elapsedHPC)
 {
-	++m_currentIterationCount;
+	AnalysisThreadState& threadState = m_threadStates[GetAnalysisThreadSlot()];
 
-	m_startHPC = GetPerformanceCounter();
-}
+	//an inner scope of the same data is already inside the outer one's time
+	--threadState.m_scopeDepth;
+	if (threadState.m_scopeDepth > 0)
+		return;
 
-//  =========================================================================================
-void AnalysisData::End()
-{
 	//update count
-	++m_data->m_count;
+	threadState.m_numCalls.store(threadState.m_numCalls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	++threadState.m_currentIterationCount;
 
-	//check to see if we are at capacity. If so we can skip adding cells
-	if (m_data->IsAtCapacity())
-		return;
+	//the histogram keeps the tail the averages below smooth away
+	if (threadState.m_histogram == nullptr)
+		threadState.m_histogram = new LatencyHistogram();
+	threadState.m_histogram->RecordValue(elapsedHPC);
 
 	//we can skip cumulative average if iterations before log is only 1
 	if (m_iterationsBeforeLog == 1)
 	{
-		uint64_t endHPC = GetPerformanceCounter();
-		m_data->AddCell(Stringf("%f", (float)PerformanceCounterToSeconds(endHPC - m_startHPC)), true);
+		PushSample(threadState, elapsedHPC);
 	}
 	else
 	{
-		uint64_t totalHPC = GetPerformanceCounter() - m_startHPC;
-		m_timeAverage = ((m_timeAverage * (m_currentIterationCount - 1)) + totalHPC) / m_currentIterationCount;
-		if (m_currentIterationCount == m_iterationsBeforeLog)
-		{
-			float secondsAverage = (float)PerformanceCounterToSeconds(m_timeAverage);
-			m_data->AddCell(Stringf("%f", secondsAverage), true);
-		}
+		threadState.m_timeAverage = ((threadState.m_timeAverage * (threadState.m_currentIterationCount - 1)) + elapsedHPC) / threadState.m_currentIterationCount;
+		if (threadState.m_currentIterationCount < m_iterationsBeforeLog)
+			return;
+
+		PushSample(threadState, threadState.m_timeAverage);
 	}
 
 	//reset data
-	Reset();
+	threadState.m_currentIterationCount = 0;
+	threadState.m_timeAverage = 0;
+}
+
+//  =========================================================================================
+void AnalysisData::PushSample(AnalysisThreadState& threadState, uint64_t sampleHPC)
+{
+	AnalysisSampleRing* ring = threadState.m_ring.load(std::memory_order_relaxed);
+	if (ring == nullptr)
+	{
+		//first sample from this thread. published so the writer can start draining it
+		ring = new AnalysisSampleRing();
+		threadState.m_ring.store(ring, std::memory_order_release);
+	}
+
+	//raw hpc only. formatting waits for export
+	ring->TryPush(sampleHPC);
 }
 
 //  =========================================================================================
 void AnalysisData::FullReset()
 {
-	m_currentIterationCount = 0;
-	m_timeAverage = 0.0;
-	m_startHPC = 0.0;
-	m_iterationStartHPC = 0.0;
+	for (int threadSlot = 0; threadSlot < MAX_ANALYSIS_THREADS; ++threadSlot)
+	{
+		AnalysisThreadState& threadState = m_threadStates[threadSlot];
+		threadState.m_currentIterationCount = 0;
+		threadState.m_timeAverage = 0;
+		threadState.m_scopeDepth = 0;
+		threadState.m_numCalls.store(0, std::memory_order_relaxed);
+
+		AnalysisSampleRing* ring = threadState.m_ring.load(std::memory_order_relaxed);
+		if (ring != nullptr)
+			ring->Reset();
+
+		if (threadState.m_histogram != nullptr)
+			threadState.m_histogram->Reset();
+	}
+}
+
+//  =========================================================================================
+void AnalysisData::DrainSamples()
+{
+	if (m_data == nullptr)
+		return;
+
+	for (int threadSlot = 0; threadSlot < MAX_ANALYSIS_THREADS; ++threadSlot)
+	{
+		AnalysisSampleRing* ring = m_threadStates[threadSlot].m_ring.load(std::memory_order_acquire);
+		if (ring != nullptr)
+			ring->DrainInto(m_data->m_samples, MAX_SIMULATION_SAMPLES);
+	}
+}
+
+//  =========================================================================================
+void AnalysisData::FlushToData()
+{
+	if (m_data == nullptr)
+		return;
+
+	DrainSamples();
+
+	uint64_t numCalls = 0;
+	for (int threadSlot = 0; threadSlot < MAX_ANALYSIS_THREADS; ++threadSlot)
+	{
+		AnalysisThreadState& threadState = m_threadStates[threadSlot];
+		numCalls += threadState.m_numCalls.load(std::memory_order_relaxed);
+
+		//handed over so a second flush can't count them twice
+		if (threadState.m_histogram != nullptr)
+		{
+			m_data->m_latencyHistogram.Merge(*threadState.m_histogram);
+			threadState.m_histogram->Reset();
+		}
+	}
+
+	m_data->m_count = numCalls;
+}
+
+//  =========================================================================================
+void AnalysisData::StartSampleWriter()
+{
+	if (s_isSampleWriterRunning.load(std::memory_order_acquire))
+		return;
+
+	s_isSampleWriterRunning.store(true, std::memory_order_release);
+	s_sampleWriterThread = std::thread(&AnalysisData::RunSampleWriter);
+}
+
+//  =========================================================================================
+void AnalysisData::StopSampleWriter()
+{
+	if (!s_isSampleWriterRunning.load(std::memory_order_acquire))
+		return;
+
+	s_isSampleWriterRunning.store(false, std::memory_order_release);
+	s_sampleWriterThread.join();
+
+	//writer is gone so pick up whatever it didn't get to
+	for (int dataIndex = 0; dataIndex < (int)s_registeredAnalysisData.size(); ++dataIndex)
+	{
+		s_registeredAnalysisData[dataIndex]->FlushToData();
+	}
+}
+
+//  =========================================================================================
+void AnalysisData::RunSampleWriter()
+{
+	while (s_isSampleWriterRunning.load(std::memory_order_acquire))
+	{
+		for (int dataIndex = 0; dataIndex < (int)s_registeredAnalysisData.size(); ++dataIndex)
+		{
+			s_registeredAnalysisData[dataIndex]->DrainSamples();
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(SAMPLE_WRITER_SLEEP_MILLISECONDS));
+	}
 }
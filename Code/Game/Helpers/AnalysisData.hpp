@@ -1,28 +1,57 @@
 #pragma once
 #include "Engine\Core\EngineCommon.hpp"
+#include "Game\Helpers\AnalysisSampleRing.hpp"
+#include "Game\Helpers\LatencyHistogram.hpp"
 
 class SimulationData;
 
+//timing state for one thread. padded so threads timing the same section don't share a line
+struct alignas(ANALYSIS_CACHE_LINE_SIZE) AnalysisThreadState
+{
+	int m_currentIterationCount = 0;
+	uint64_t m_timeAverage = 0;
+
+	//scopes of this data currently open on the thread. only the outermost one records so recursion isn't double counted
+	int m_scopeDepth = 0;
+
+	//every outermost scope lands here, not just the logged averages. merged into m_data when the writer stops
+	LatencyHistogram* m_histogram = nullptr;
+
+	//read by the sample writer
+	std::atomic<uint64_t> m_numCalls{0};
+	std::atomic<AnalysisSampleRing*> m_ring{nullptr};
+};
+
 class AnalysisData
 {
 public:
 	AnalysisData(SimulationData* exportDataReference, int iterationsBeforeLog);
 	~AnalysisData();
 
-	void Reset();
-	void Start();
-	void End();
+	//driven by ScopedAnalysisTimer (see AnalysisScope.hpp)
+	void EnterScope();
+	void ExitScope(uint64_t elapsedHPC);
 
 	void FullReset();
 
+	//sample writer. runs while a simulation records and moves samples from the rings into m_data
+	static void StartSampleWriter();
+	static void StopSampleWriter();
+
+private:
+	void PushSample(AnalysisThreadState& threadState, uint64_t sampleHPC);
+	void DrainSamples();
+	void FlushToData();
+
+	static void RunSampleWriter();
+
 public:
-	int m_currentIterationCount = 0;
 	int m_iterationsBeforeLog = 1;
-	uint64_t m_timeAverage = 0.0;
-	uint64_t m_startHPC = 0.0;
-	uint64_t m_iterationStartHPC = 0.0;	
 
 	SimulationData* m_data = nullptr;
+
+private:
+	AnalysisThreadState m_threadStates[MAX_ANALYSIS_THREADS];
 };
 
 
@@ -26,17 +26,29 @@ void AnalysisGraph::GenerateGraph()
 	if (m_simulationDataContents.size() == 0)
 		return;
 
-	m_minConfidenceValue = m_simulationDataContents[0]->m_confidenceIntervalRangeLow;
-	m_maxConfidenceValue = m_simulationDataContents[0]->m_confidenceIntervalRangeHigh;
+	m_minGraphValue = m_simulationDataContents[0]->m_confidenceIntervalRangeLow;
+	m_maxGraphValue = m_simulationDataContents[0]->m_confidenceIntervalRangeHigh;
 
 	//get min and max values from data
 	for (int simDataIndex = 0; simDataIndex < (int)m_simulationDataContents.size(); ++simDataIndex)
 	{
-		if (m_simulationDataContents[simDataIndex]->m_confidenceIntervalRangeLow < m_minConfidenceValue)
-			m_minConfidenceValue = m_simulationDataContents[simDataIndex]->m_confidenceIntervalRangeLow;
+		ImportedProfiledSimulationData* data = m_simulationDataContents[simDataIndex];
 
-		if (m_simulationDataContents[simDataIndex]->m_confidenceIntervalRangeHigh > m_maxConfidenceValue)
-			m_maxConfidenceValue = m_simulationDataContents[simDataIndex]->m_confidenceIntervalRangeHigh;
+		if (data->m_confidenceIntervalRangeLow < m_minGraphValue)
+			m_minGraphValue = data->m_confidenceIntervalRangeLow;
+
+		if (data->m_confidenceIntervalRangeHigh > m_maxGraphValue)
+			m_maxGraphValue = data->m_confidenceIntervalRangeHigh;
+
+		//percentiles are sorted so the ends are enough
+		if (data->m_hasPercentiles)
+		{
+			if (data->m_percentiles[P50_LATENCY_PERCENTILE] < m_minGraphValue)
+				m_minGraphValue = data->m_percentiles[P50_LATENCY_PERCENTILE];
+
+			if (data->m_percentiles[P999_LATENCY_PERCENTILE] > m_maxGraphValue)
+				m_maxGraphValue = data->m_percentiles[P999_LATENCY_PERCENTILE];
+		}
 	}
 
 	//anything else goes here
@@ -84,7 +96,7 @@ void AnalysisGraph::Render()
 	//  ----------------------------------------------
 	//draw horizontal graph lines (always 10 for now)
 	float percentageSpacingBetweenHorizontalLines = 1.f/9.f;
-	float confidencePercentage = (m_maxConfidenceValue - m_minConfidenceValue) * percentageSpacingBetweenHorizontalLines;
+	float confidencePercentage = (m_maxGraphValue - m_minGraphValue) * percentageSpacingBetweenHorizontalLines;
 
 	//bottom -> top
 	for (int dataContentIndex = 0; dataContentIndex < 9; ++dataContentIndex)
@@ -115,7 +127,7 @@ void AnalysisGraph::Render()
 		//draw horizontal legend text
 		Vector2 drawPosition = Vector2(boundsBox.mins.x + (boundsBoxDimensions.x * 0.01f), yPosition - ((theWindow->m_clientHeight * 0.015f * 0.5f)));
 		theRenderer->DrawText2D(drawPosition,
-			Stringf("%f", m_minConfidenceValue + (confidencePercentage * (float)dataContentIndex)).c_str(),
+			Stringf("%f", m_minGraphValue + (confidencePercentage * (float)dataContentIndex)).c_str(),
 			theWindow->m_clientHeight * 0.015f,
 			Rgba::BLACK,
 			1.f,
@@ -140,9 +152,9 @@ void AnalysisGraph::Render()
 		float xPosition = graphBox.mins.x + (graphBoxDimensions.x * percentageSpacingBetweenVerticalLines * ((float)dataContentIndex + 1.f));
 
 		//get y range
-		float lowYPercentage = RangeMapFloat(data->m_confidenceIntervalRangeLow, m_minConfidenceValue, m_maxConfidenceValue, 0.f, 1.f);
-		float averageYPercentage = RangeMapFloat(data->m_average, m_minConfidenceValue, m_maxConfidenceValue, 0.f, 1.f);
-		float highYPercentage = RangeMapFloat(data->m_confidenceIntervalRangeHigh, m_minConfidenceValue, m_maxConfidenceValue, 0.f, 1.f);
+		float lowYPercentage = RangeMapFloat(data->m_confidenceIntervalRangeLow, m_minGraphValue, m_maxGraphValue, 0.f, 1.f);
+		float averageYPercentage = RangeMapFloat(data->m_average, m_minGraphValue, m_maxGraphValue, 0.f, 1.f);
+		float highYPercentage = RangeMapFloat(data->m_confidenceIntervalRangeHigh, m_minGraphValue, m_maxGraphValue, 0.f, 1.f);
 
 		Vector2 lineStart = Vector2(xPosition, graphBox.mins.y + (lowYPercentage * graphBoxDimensions.y));
 		Vector2 lineEnd = Vector2(xPosition, graphBox.mins.y + (highYPercentage * graphBoxDimensions.y));
@@ -165,6 +177,38 @@ void AnalysisGraph::Render()
 		theRenderer->DrawAABB(averageConfidencePoint, drawColor);
 		theRenderer->DrawAABB(highConfidencePoint, drawColor);
 
+		//percentile ladder beside the interval so the tail the average hides is visible
+		if (data->m_hasPercentiles)
+		{
+			float percentileXPosition = xPosition + (graphBoxDimensions.x * percentageSpacingBetweenVerticalLines * 0.2f);
+			float percentileYPositions[NUM_LATENCY_PERCENTILES];
+			for (int percentileIndex = 0; percentileIndex < NUM_LATENCY_PERCENTILES; ++percentileIndex)
+			{
+				float percentileYPercentage = RangeMapFloat(data->m_percentiles[percentileIndex], m_minGraphValue, m_maxGraphValue, 0.f, 1.f);
+				percentileYPositions[percentileIndex] = graphBox.mins.y + (percentileYPercentage * graphBoxDimensions.y);
+			}
+
+			theRenderer->DrawLineWithColor(Vector2(percentileXPosition, percentileYPositions[P50_LATENCY_PERCENTILE]), Vector2(percentileXPosition, percentileYPositions[P999_LATENCY_PERCENTILE]), drawColor);
+
+			for (int percentileIndex = 0; percentileIndex < NUM_LATENCY_PERCENTILES; ++percentileIndex)
+			{
+				AABB2 percentilePoint = AABB2(Vector2(percentileXPosition, percentileYPositions[percentileIndex]), pointRadiusX, pointRadiusY);
+				theRenderer->DrawAABB(percentilePoint, drawColor);
+			}
+
+			//text swaps the texture so it goes after the points
+			float percentileTextHeight = theWindow->m_clientHeight * 0.01f;
+			for (int percentileIndex = 0; percentileIndex < NUM_LATENCY_PERCENTILES; ++percentileIndex)
+			{
+				theRenderer->DrawText2D(Vector2(percentileXPosition + (pointRadiusX * 2.f), percentileYPositions[percentileIndex] - (percentileTextHeight * 0.5f)),
+					g_latencyPercentileNames[percentileIndex],
+					percentileTextHeight,
+					drawColor,
+					1.f,
+					Renderer::GetInstance()->CreateOrGetBitmapFont("SquirrelFixedFont"));
+			}
+		}
+
 		//draw text
 		theRenderer->DrawText2DCentered(Vector2(xPosition, graphBox.mins.y - (boundsBoxDimensions.y * 0.1f * 0.5f)),
 			Stringf("%s", m_simulationDataContents[dataContentIndex]->m_simulationDefinitionContentsNameKey.c_str()).c_str(),
@@ -21,8 +21,9 @@ public:
 	inline int GetDataCount() { return (int)m_simulationDataContents.size(); }
 
 private:
-	float m_minConfidenceValue = 0.f;
-	float m_maxConfidenceValue = 0.f;
+	//vertical range. covers every confidence interval and percentile being drawn
+	float m_minGraphValue = 0.f;
+	float m_maxGraphValue = 0.f;
 
 	std::vector<ImportedProfiledSimulationData*> m_simulationDataContents;
 };
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "Game\Helpers\AnalysisSampleRing.hpp"
+#include "Engine\Core\ErrorWarningAssert.hpp"
+
+static std::atomic<int> s_numAnalysisThreadSlots(0);
+
+//  =========================================================================================
+int AcquireAnalysisThreadSlot()
+{
+	int threadSlot = s_numAnalysisThreadSlots.fetch_add(1, std::memory_order_relaxed);
+	ASSERT_OR_DIE(threadSlot < MAX_ANALYSIS_THREADS, "TOO MANY THREADS RECORDING ANALYSIS DATA");
+
+	return threadSlot;
+}
+
+//  =========================================================================================
+bool AnalysisSampleRing::TryPush(uint64_t sample)
+{
+	uint32_t head = m_head.load(std::memory_order_relaxed);
+	uint32_t tail = m_tail.load(std::memory_order_acquire);
+
+	//full
+	if (head - tail == ANALYSIS_SAMPLE_RING_SIZE)
+		return false;
+
+	m_samples[head & ANALYSIS_SAMPLE_RING_MASK] = sample;
+	m_head.store(head + 1, std::memory_order_release);
+
+	return true;
+}
+
+//  =========================================================================================
+int AnalysisSampleRing::DrainInto(std::vector<uint64_t>& outSamples, size_t maxSamples)
+{
+	uint32_t tail = m_tail.load(std::memory_order_relaxed);
+	uint32_t head = m_head.load(std::memory_order_acquire);
+
+	int numDrained = (int)(head - tail);
+	for (; tail != head; ++tail)
+	{
+		if (outSamples.size() < maxSamples)
+			outSamples.push_back(m_samples[tail & ANALYSIS_SAMPLE_RING_MASK]);
+	}
+
+	//give the slots back to the producer
+	m_tail.store(tail, std::memory_order_release);
+
+	return numDrained;
+}
+
+//  =========================================================================================
+void AnalysisSampleRing::Reset()
+{
+	m_head.store(0, std::memory_order_relaxed);
+	m_tail.store(0, std::memory_order_relaxed);
+}
+
+//  =========================================================================================
+uint64_t PerThreadCounter::GetTotal() const
+{
+	uint64_t total = 0;
+	for (int slotIndex = 0; slotIndex < MAX_ANALYSIS_THREADS; ++slotIndex)
+	{
+		total += m_slots[slotIndex].m_count.load(std::memory_order_relaxed);
+	}
+
+	return total;
+}
+
+//  =========================================================================================
+void PerThreadCounter::Reset()
+{
+	for (int slotIndex = 0; slotIndex < MAX_ANALYSIS_THREADS; ++slotIndex)
+	{
+		m_slots[slotIndex].m_count.store(0, std::memory_order_relaxed);
+	}
+}
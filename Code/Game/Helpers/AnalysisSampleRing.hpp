@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+constexpr int ANALYSIS_CACHE_LINE_SIZE = 64;
+constexpr int MAX_ANALYSIS_THREADS = 16;
+constexpr uint32_t ANALYSIS_SAMPLE_RING_SIZE = 16384; //must be a power of two
+constexpr uint32_t ANALYSIS_SAMPLE_RING_MASK = ANALYSIS_SAMPLE_RING_SIZE - 1;
+
+//hands the calling thread the next free slot. only called once per thread (see GetAnalysisThreadSlot)
+int AcquireAnalysisThreadSlot();
+
+//small stable index for the calling thread used to pick its own ring and counter slot
+inline int GetAnalysisThreadSlot()
+{
+	static thread_local int s_threadSlot = AcquireAnalysisThreadSlot();
+	return s_threadSlot;
+}
+
+//  ----------------------------------------------
+/*
+single producer single consumer ring of raw hpc samples. the measured thread pushes, the sample writer drains.
+head and tail live on their own cache lines so the two sides never share a line they write to. when the writer
+falls behind a full ring drops the sample rather than making the measured code wait.
+*/
+class AnalysisSampleRing
+{
+public:
+	//producer side
+	bool TryPush(uint64_t sample);
+
+	//consumer side. appends everything pushed so far to outSamples, dropping what won't fit under maxSamples
+	int DrainInto(std::vector<uint64_t>& outSamples, size_t maxSamples);
+
+	//only safe while nothing is pushing or draining
+	void Reset();
+
+private:
+	alignas(ANALYSIS_CACHE_LINE_SIZE) std::atomic<uint32_t> m_head{0};
+	alignas(ANALYSIS_CACHE_LINE_SIZE) std::atomic<uint32_t> m_tail{0};
+	alignas(ANALYSIS_CACHE_LINE_SIZE) uint64_t m_samples[ANALYSIS_SAMPLE_RING_SIZE];
+};
+
+//  ----------------------------------------------
+//call counter where each thread bumps its own padded slot. slots are only summed when the total is read
+class PerThreadCounter
+{
+public:
+	void Increment()
+	{
+		std::atomic<uint64_t>& count = m_slots[GetAnalysisThreadSlot()].m_count;
+		count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	uint64_t GetTotal() const;
+	void Reset();
+
+private:
+	struct alignas(ANALYSIS_CACHE_LINE_SIZE) CounterSlot
+	{
+		std::atomic<uint64_t> m_count{0};
+	};
+
+	CounterSlot m_slots[MAX_ANALYSIS_THREADS];
+};
@@ -0,0 +1,45 @@
+#include "Game\Helpers\AnalysisScope.hpp"
+
+//keeps the benchmark loops from being thrown away
+static volatile float s_analysisBenchmarkSink = 0.f;
+
+//  =========================================================================================
+static float RunBaselineBenchmarkLoop(int numIterations)
+{
+	float value = s_analysisBenchmarkSink;
+	for (int iteration = 0; iteration < numIterations; ++iteration)
+	{
+		value = (value * 0.999f) + 0.5f;
+	}
+
+	return value;
+}
+
+//  =========================================================================================
+static float RunSkippedScopeBenchmarkLoop(int numIterations)
+{
+	float value = s_analysisBenchmarkSink;
+	for (int iteration = 0; iteration < numIterations; ++iteration)
+	{
+		ScopedAnalysisTimer<SkipAnalysisPolicy> analysisTimer(g_updatePlanAnalysisData);
+		value = (value * 0.999f) + 0.5f;
+	}
+
+	return value;
+}
+
+//  =========================================================================================
+AnalysisScopeBenchmarkResults RunAnalysisScopeBenchmark(int numIterations)
+{
+	AnalysisScopeBenchmarkResults results;
+
+	uint64_t startHPC = GetPerformanceCounter();
+	s_analysisBenchmarkSink = RunBaselineBenchmarkLoop(numIterations);
+	results.m_baselineSeconds = PerformanceCounterToSeconds(GetPerformanceCounter() - startHPC);
+
+	startHPC = GetPerformanceCounter();
+	s_analysisBenchmarkSink = RunSkippedScopeBenchmarkLoop(numIterations);
+	results.m_skippedScopeSeconds = PerformanceCounterToSeconds(GetPerformanceCounter() - startHPC);
+
+	return results;
+}
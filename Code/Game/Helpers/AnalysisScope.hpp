@@ -0,0 +1,151 @@
+#pragma once
+#include "Game\GameCommon.hpp"
+#include "Game\Helpers\AnalysisData.hpp"
+#include "Engine\Time\Time.hpp"
+#include <type_traits>
+
+/*
+instrumentation policies. each measured section gets a policy typedef below, picked by its *Analysis define in
+GameCommon.hpp, and measuring a function is one line:
+
+	ScopedAnalysisTimer<PathingAnalysisPolicy> analysisTimer(g_pathingAnalysisData);
+
+the timer records on every exit from the scope (early returns included). with SkipAnalysisPolicy it is an empty
+object with inline no-op members, so a disabled section compiles to exactly what it would be without it
+*/
+
+// policies ----------------------------------------------
+struct RecordAnalysisPolicy
+{
+	static inline void IncrementCounter(PerThreadCounter& counter)
+	{
+		counter.Increment();
+	}
+};
+
+//  ----------------------------------------------
+struct SkipAnalysisPolicy
+{
+	static inline void IncrementCounter(PerThreadCounter& counter)
+	{
+		UNUSED(counter);
+	}
+};
+
+// scoped timer ----------------------------------------------
+template <typename AnalysisPolicy>
+class ScopedAnalysisTimer;
+
+//  ----------------------------------------------
+template <>
+class ScopedAnalysisTimer<RecordAnalysisPolicy>
+{
+public:
+	explicit ScopedAnalysisTimer(AnalysisData* analysisData)
+	{
+		m_analysisData = analysisData;
+		m_analysisData->EnterScope();
+		m_startHPC = GetPerformanceCounter();
+	}
+
+	~ScopedAnalysisTimer()
+	{
+		m_analysisData->ExitScope(GetPerformanceCounter() - m_startHPC);
+	}
+
+	ScopedAnalysisTimer(const ScopedAnalysisTimer&) = delete;
+	ScopedAnalysisTimer& operator=(const ScopedAnalysisTimer&) = delete;
+
+private:
+	AnalysisData* m_analysisData = nullptr;
+	uint64_t m_startHPC = 0;
+};
+
+//  ----------------------------------------------
+template <>
+class ScopedAnalysisTimer<SkipAnalysisPolicy>
+{
+public:
+	explicit ScopedAnalysisTimer(AnalysisData* analysisData)
+	{
+		UNUSED(analysisData);
+	}
+
+	ScopedAnalysisTimer(const ScopedAnalysisTimer&) = delete;
+	ScopedAnalysisTimer& operator=(const ScopedAnalysisTimer&) = delete;
+};
+
+//nothing to store and nothing to run on scope exit
+static_assert(std::is_empty<ScopedAnalysisTimer<SkipAnalysisPolicy>>::value, "disabled analysis timer must hold no state");
+static_assert(std::is_trivially_destructible<ScopedAnalysisTimer<SkipAnalysisPolicy>>::value, "disabled analysis timer must have no destructor");
+
+// per section policies ----------------------------------------------
+#ifdef ActionStackAnalysis
+typedef RecordAnalysisPolicy ActionStackAnalysisPolicy;
+#else
+typedef SkipAnalysisPolicy ActionStackAnalysisPolicy;
+#endif
+
+#ifdef UpdatePlanAnalysis
+typedef RecordAnalysisPolicy UpdatePlanAnalysisPolicy;
+#else
+typedef SkipAnalysisPolicy UpdatePlanAnalysisPolicy;
+#endif
+
+#ifdef AgentUpdateAnalysis
+typedef RecordAnalysisPolicy AgentUpdateAnalysisPolicy;
+#else
+typedef SkipAnalysisPolicy AgentUpdateAnalysisPolicy;
+#endif
+
+#ifdef PathingDataAnalysis
+typedef RecordAnalysisPolicy PathingAnalysisPolicy;
+#else
+typedef SkipAnalysisPolicy PathingAnalysisPolicy;
+#endif
+
+#ifdef CopyPathAnalysis
+typedef RecordAnalysisPolicy CopyPathAnalysisPolicy;
+#else
+typedef SkipAnalysisPolicy CopyPathAnalysisPolicy;
+#endif
+
+#ifdef QueueActionPathingDataAnalysis
+typedef RecordAnalysisPolicy QueueActionPathingAnalysisPolicy;
+#else
+typedef SkipAnalysisPolicy QueueActionPathingAnalysisPolicy;
+#endif
+
+#ifdef CollisionDataAnalysis
+typedef RecordAnalysisPolicy CollisionAnalysisPolicy;
+#else
+typedef SkipAnalysisPolicy CollisionAnalysisPolicy;
+#endif
+
+#ifdef MemoizationCountDataAnalysis
+typedef RecordAnalysisPolicy MemoizationCountAnalysisPolicy;
+#else
+typedef SkipAnalysisPolicy MemoizationCountAnalysisPolicy;
+#endif
+
+#ifdef MemoizationDataAnalysis
+typedef RecordAnalysisPolicy MemoizationAnalysisPolicy;
+#else
+typedef SkipAnalysisPolicy MemoizationAnalysisPolicy;
+#endif
+
+#ifdef TestExtremeMemoizationDataAnalysis
+typedef RecordAnalysisPolicy TestExtremeMemoizationAnalysisPolicy;
+#else
+typedef SkipAnalysisPolicy TestExtremeMemoizationAnalysisPolicy;
+#endif
+
+// benchmark ----------------------------------------------
+struct AnalysisScopeBenchmarkResults
+{
+	double m_baselineSeconds = 0.0;
+	double m_skippedScopeSeconds = 0.0;
+};
+
+//times the same loop bare and with a SkipAnalysisPolicy timer in its body. the two should match
+AnalysisScopeBenchmarkResults RunAnalysisScopeBenchmark(int numIterations);
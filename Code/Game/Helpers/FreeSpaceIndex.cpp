@@ -0,0 +1,197 @@
+#include "Game\Helpers\FreeSpaceIndex.hpp"
+#include "Game\Helpers\RandomStream.hpp"
+#include "Game\Map\Map.hpp"
+#include "Game\GameCommon.hpp"
+
+const IntVector2 BUILDING_ACCESS_OFFSETS[NUM_BUILDING_ACCESS_OFFSETS] =
+{
+	IntVector2(0, -1),
+	IntVector2(1, -1),
+	IntVector2(2, 0),
+	IntVector2(2, 1),
+	IntVector2(1, 2),
+	IntVector2(0, 2),
+	IntVector2(-1, 1),
+	IntVector2(-1, 0)
+};
+
+//  =========================================================================================
+void FreeSpaceIndex::Rebuild(const Map& map)
+{
+	m_dimensions = map.m_dimensions;
+	int numTiles = m_dimensions.x * m_dimensions.y;
+
+	m_buildingTileIndices.clear();
+	m_walkableTileIndices.clear();
+	m_buildingListPositions.assign(numTiles, -1);
+	m_walkableListPositions.assign(numTiles, -1);
+
+	//summed area table of buildable tiles with a zero row and column in front
+	int tableWidth = m_dimensions.x + 1;
+	std::vector<int> buildableSums((m_dimensions.y + 1) * tableWidth, 0);
+	for (int yCoordinate = 0; yCoordinate < m_dimensions.y; ++yCoordinate)
+	{
+		int rowSum = 0;
+		for (int xCoordinate = 0; xCoordinate < m_dimensions.x; ++xCoordinate)
+		{
+			const Tile* tile = map.GetTileAtCoordinate(IntVector2(xCoordinate, yCoordinate));
+			rowSum += tile->AllowsBuilding() ? 1 : 0;
+			buildableSums[(xCoordinate + 1) + ((yCoordinate + 1) * tableWidth)] = buildableSums[(xCoordinate + 1) + (yCoordinate * tableWidth)] + rowSum;
+
+			if (tile->AllowsWalking())
+				SetIsInList(m_walkableTileIndices, m_walkableListPositions, xCoordinate + (yCoordinate * m_dimensions.x), true);
+		}
+	}
+
+	//footprints are checked in O(1) off the table. only the survivors pay for the access ring
+	int footprintArea = BUILDING_DIMENSIONS.x * BUILDING_DIMENSIONS.y;
+	for (int yCoordinate = OUTER_WALL_THICKNESS; yCoordinate <= m_dimensions.y - OUTER_WALL_THICKNESS - BUILDING_DIMENSIONS.y; ++yCoordinate)
+	{
+		for (int xCoordinate = OUTER_WALL_THICKNESS; xCoordinate <= m_dimensions.x - OUTER_WALL_THICKNESS - BUILDING_DIMENSIONS.x; ++xCoordinate)
+		{
+			int minX = xCoordinate;
+			int minY = yCoordinate;
+			int maxX = xCoordinate + BUILDING_DIMENSIONS.x;
+			int maxY = yCoordinate + BUILDING_DIMENSIONS.y;
+
+			int numBuildable = buildableSums[maxX + (maxY * tableWidth)] - buildableSums[minX + (maxY * tableWidth)] - buildableSums[maxX + (minY * tableWidth)] + buildableSums[minX + (minY * tableWidth)];
+			if (numBuildable != footprintArea)
+				continue;
+
+			IntVector2 coordinate = IntVector2(xCoordinate, yCoordinate);
+			if (IsValidBuildingCoordinate(map, coordinate))
+				SetIsInList(m_buildingTileIndices, m_buildingListPositions, xCoordinate + (yCoordinate * m_dimensions.x), true);
+		}
+	}
+
+	m_isBuilt = true;
+}
+
+//  =========================================================================================
+void FreeSpaceIndex::Clear()
+{
+	m_isBuilt = false;
+
+	m_buildingTileIndices.clear();
+	m_buildingListPositions.clear();
+	m_walkableTileIndices.clear();
+	m_walkableListPositions.clear();
+}
+
+//  =========================================================================================
+void FreeSpaceIndex::UpdateTile(const Map& map, const IntVector2& coordinate)
+{
+	if (!m_isBuilt)
+		return;
+
+	int tileIndex = coordinate.x + (coordinate.y * m_dimensions.x);
+	SetIsInList(m_walkableTileIndices, m_walkableListPositions, tileIndex, map.GetTileAtCoordinate(coordinate)->AllowsWalking());
+
+	//buildings whose footprint covers the tile
+	for (int offsetY = 0; offsetY < BUILDING_DIMENSIONS.y; ++offsetY)
+	{
+		for (int offsetX = 0; offsetX < BUILDING_DIMENSIONS.x; ++offsetX)
+		{
+			UpdateBuildingCoordinate(map, IntVector2(coordinate.x - offsetX, coordinate.y - offsetY));
+		}
+	}
+
+	//buildings that could use the tile for access
+	for (int offsetIndex = 0; offsetIndex < NUM_BUILDING_ACCESS_OFFSETS; ++offsetIndex)
+	{
+		UpdateBuildingCoordinate(map, IntVector2(coordinate.x - BUILDING_ACCESS_OFFSETS[offsetIndex].x, coordinate.y - BUILDING_ACCESS_OFFSETS[offsetIndex].y));
+	}
+}
+
+//  =========================================================================================
+bool FreeSpaceIndex::GetRandomBuildingCoordinate(RandomStream& stream, IntVector2& outCoordinate) const
+{
+	if (m_buildingTileIndices.size() == 0)
+		return false;
+
+	int tileIndex = m_buildingTileIndices[stream.GetNextIntInRange(0, (int)m_buildingTileIndices.size() - 1)];
+	outCoordinate = IntVector2(tileIndex % m_dimensions.x, tileIndex / m_dimensions.x);
+	return true;
+}
+
+//  =========================================================================================
+bool FreeSpaceIndex::GetRandomWalkableCoordinate(RandomStream& stream, IntVector2& outCoordinate) const
+{
+	if (m_walkableTileIndices.size() == 0)
+		return false;
+
+	int tileIndex = m_walkableTileIndices[stream.GetNextIntInRange(0, (int)m_walkableTileIndices.size() - 1)];
+	outCoordinate = IntVector2(tileIndex % m_dimensions.x, tileIndex / m_dimensions.x);
+	return true;
+}
+
+//  =========================================================================================
+bool FreeSpaceIndex::IsValidBuildingCoordinate(const Map& map, const IntVector2& coordinate)
+{
+	//keep buildings off the outer wall band
+	if (coordinate.x < OUTER_WALL_THICKNESS || coordinate.x > map.m_dimensions.x - OUTER_WALL_THICKNESS - BUILDING_DIMENSIONS.x
+		|| coordinate.y < OUTER_WALL_THICKNESS || coordinate.y > map.m_dimensions.y - OUTER_WALL_THICKNESS - BUILDING_DIMENSIONS.y)
+	{
+		return false;
+	}
+
+	if (!map.GetTileAtCoordinate(coordinate)->AllowsWalking())
+		return false;
+
+	for (int offsetY = 0; offsetY < BUILDING_DIMENSIONS.y; ++offsetY)
+	{
+		for (int offsetX = 0; offsetX < BUILDING_DIMENSIONS.x; ++offsetX)
+		{
+			if (!map.GetTileAtCoordinate(IntVector2(coordinate.x + offsetX, coordinate.y + offsetY))->AllowsBuilding())
+				return false;
+		}
+	}
+
+	for (int offsetIndex = 0; offsetIndex < NUM_BUILDING_ACCESS_OFFSETS; ++offsetIndex)
+	{
+		if (IsValidBuildingAccessCoordinate(map, IntVector2(coordinate.x + BUILDING_ACCESS_OFFSETS[offsetIndex].x, coordinate.y + BUILDING_ACCESS_OFFSETS[offsetIndex].y)))
+			return true;
+	}
+
+	return false;
+}
+
+//  =========================================================================================
+bool FreeSpaceIndex::IsValidBuildingAccessCoordinate(const Map& map, const IntVector2& coordinate)
+{
+	const Tile* tile = map.GetTileAtCoordinate(coordinate);
+	return tile != nullptr && tile->AllowsBuilding();
+}
+
+//  =========================================================================================
+void FreeSpaceIndex::SetIsInList(std::vector<int>& tileIndices, std::vector<int>& listPositions, int tileIndex, bool isInList)
+{
+	int listPosition = listPositions[tileIndex];
+	if (isInList == (listPosition != -1))
+		return;
+
+	if (isInList)
+	{
+		listPositions[tileIndex] = (int)tileIndices.size();
+		tileIndices.push_back(tileIndex);
+		return;
+	}
+
+	//swap the last entry into the hole
+	int lastTileIndex = tileIndices.back();
+	tileIndices[listPosition] = lastTileIndex;
+	listPositions[lastTileIndex] = listPosition;
+
+	tileIndices.pop_back();
+	listPositions[tileIndex] = -1;
+}
+
+//  =========================================================================================
+void FreeSpaceIndex::UpdateBuildingCoordinate(const Map& map, const IntVector2& coordinate)
+{
+	if (coordinate.x < 0 || coordinate.y < 0 || coordinate.x >= m_dimensions.x || coordinate.y >= m_dimensions.y)
+		return;
+
+	int tileIndex = coordinate.x + (coordinate.y * m_dimensions.x);
+	SetIsInList(m_buildingTileIndices, m_buildingListPositions, tileIndex, IsValidBuildingCoordinate(map, coordinate));
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include "Engine\Core\EngineCommon.hpp"
+#include "Engine\Math\IntVector2.hpp"
+#include <vector>
+
+class Map;
+class RandomStream;
+
+//tiles around a building's bottom left corner that can hold its access tile
+constexpr int NUM_BUILDING_ACCESS_OFFSETS = 8;
+extern const IntVector2 BUILDING_ACCESS_OFFSETS[NUM_BUILDING_ACCESS_OFFSETS];
+
+//  ----------------------------------------------
+/*
+lists of every coordinate a building or an agent can currently be placed at so placement is one random pick
+instead of rejection sampling. built from a summed area table of buildable tiles, then kept current a tile at a
+time as the map changes. list order only depends on the order of changes so picks stay deterministic.
+*/
+class FreeSpaceIndex
+{
+public:
+	void Rebuild(const Map& map);
+	void Clear();
+	bool IsBuilt() const { return m_isBuilt; }
+
+	//rechecks every building coordinate whose footprint or access ring covers the tile
+	void UpdateTile(const Map& map, const IntVector2& coordinate);
+
+	//false when nothing is free
+	bool GetRandomBuildingCoordinate(RandomStream& stream, IntVector2& outCoordinate) const;
+	bool GetRandomWalkableCoordinate(RandomStream& stream, IntVector2& outCoordinate) const;
+
+	int GetNumBuildingCoordinates() const { return (int)m_buildingTileIndices.size(); }
+	int GetNumWalkableCoordinates() const { return (int)m_walkableTileIndices.size(); }
+
+	static bool IsValidBuildingCoordinate(const Map& map, const IntVector2& coordinate);
+	static bool IsValidBuildingAccessCoordinate(const Map& map, const IntVector2& coordinate);
+
+private:
+	void SetIsInList(std::vector<int>& tileIndices, std::vector<int>& listPositions, int tileIndex, bool isInList);
+	void UpdateBuildingCoordinate(const Map& map, const IntVector2& coordinate);
+
+private:
+	IntVector2 m_dimensions;
+	bool m_isBuilt = false;
+
+	//tile indices plus where each tile sits in its list (-1 when absent) for O(1) swap removal
+	std::vector<int> m_buildingTileIndices;
+	std::vector<int> m_buildingListPositions;
+	std::vector<int> m_walkableTileIndices;
+	std::vector<int> m_walkableListPositions;
+};
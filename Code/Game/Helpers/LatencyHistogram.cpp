@@ -0,0 +1,122 @@
+#include "Game\Helpers\LatencyHistogram.hpp"
+#include <intrin.h>
+#include <math.h>
+#include <algorithm>
+
+const double g_latencyPercentileValues[NUM_LATENCY_PERCENTILES] = { 50.0, 90.0, 99.0, 99.9 };
+const char* g_latencyPercentileNames[NUM_LATENCY_PERCENTILES] = { "p50", "p90", "p99", "p99.9" };
+
+//  =========================================================================================
+static int GetHighestSetBitIndex(uint64_t value)
+{
+	//split in two so win32 builds don't need the 64 bit intrinsic
+	unsigned long bitIndex = 0;
+	uint32_t highBits = (uint32_t)(value >> 32);
+	if (highBits != 0)
+	{
+		_BitScanReverse(&bitIndex, highBits);
+		return (int)bitIndex + 32;
+	}
+
+	_BitScanReverse(&bitIndex, (uint32_t)value);
+	return (int)bitIndex;
+}
+
+//  =========================================================================================
+LatencyHistogram::LatencyHistogram()
+{
+	m_bucketCounts.resize(LATENCY_HISTOGRAM_NUM_BUCKETS, 0);
+}
+
+//  =========================================================================================
+void LatencyHistogram::RecordValue(uint64_t value)
+{
+	++m_bucketCounts[GetBucketIndexForValue(value)];
+	++m_totalCount;
+
+	if (value < m_minValue)
+		m_minValue = value;
+	if (value > m_maxValue)
+		m_maxValue = value;
+}
+
+//  =========================================================================================
+void LatencyHistogram::Merge(const LatencyHistogram& other)
+{
+	if (other.m_totalCount == 0)
+		return;
+
+	for (int bucketIndex = 0; bucketIndex < LATENCY_HISTOGRAM_NUM_BUCKETS; ++bucketIndex)
+	{
+		m_bucketCounts[bucketIndex] += other.m_bucketCounts[bucketIndex];
+	}
+
+	m_totalCount += other.m_totalCount;
+
+	if (other.m_minValue < m_minValue)
+		m_minValue = other.m_minValue;
+	if (other.m_maxValue > m_maxValue)
+		m_maxValue = other.m_maxValue;
+}
+
+//  =========================================================================================
+void LatencyHistogram::Reset()
+{
+	std::fill(m_bucketCounts.begin(), m_bucketCounts.end(), 0);
+	m_totalCount = 0;
+	m_minValue = UINT64_MAX;
+	m_maxValue = 0;
+}
+
+//  =========================================================================================
+uint64_t LatencyHistogram::GetValueAtPercentile(double percentile) const
+{
+	if (m_totalCount == 0)
+		return 0;
+
+	//smallest count that covers the percentile
+	uint64_t targetCount = (uint64_t)ceil((percentile / 100.0) * (double)m_totalCount);
+	if (targetCount < 1)
+		targetCount = 1;
+
+	uint64_t runningCount = 0;
+	for (int bucketIndex = 0; bucketIndex < LATENCY_HISTOGRAM_NUM_BUCKETS; ++bucketIndex)
+	{
+		runningCount += m_bucketCounts[bucketIndex];
+		if (runningCount >= targetCount)
+		{
+			//report the top of the bucket but never past anything we actually saw
+			uint64_t highestValue = GetHighestValueInBucket(bucketIndex);
+			return highestValue < m_maxValue ? highestValue : m_maxValue;
+		}
+	}
+
+	return m_maxValue;
+}
+
+//  =========================================================================================
+int LatencyHistogram::GetBucketIndexForValue(uint64_t value)
+{
+	if (value < LATENCY_HISTOGRAM_EXACT_BUCKETS)
+		return (int)value;
+
+	//shift keeps the top PRECISION_BITS of the value. the leading one is implied so half of those are the sub bucket
+	int shift = GetHighestSetBitIndex(value) - LATENCY_HISTOGRAM_PRECISION_BITS + 1;
+	int subBucketIndex = (int)(value >> shift) - LATENCY_HISTOGRAM_SUB_BUCKETS;
+
+	return LATENCY_HISTOGRAM_EXACT_BUCKETS + ((shift - 1) * LATENCY_HISTOGRAM_SUB_BUCKETS) + subBucketIndex;
+}
+
+//  =========================================================================================
+uint64_t LatencyHistogram::GetHighestValueInBucket(int bucketIndex)
+{
+	if (bucketIndex < LATENCY_HISTOGRAM_EXACT_BUCKETS)
+		return (uint64_t)bucketIndex;
+
+	int logBucketIndex = bucketIndex - LATENCY_HISTOGRAM_EXACT_BUCKETS;
+	int shift = (logBucketIndex / LATENCY_HISTOGRAM_SUB_BUCKETS) + 1;
+	uint64_t subBucketIndex = (uint64_t)(logBucketIndex % LATENCY_HISTOGRAM_SUB_BUCKETS);
+
+	uint64_t lowestValue = (subBucketIndex + LATENCY_HISTOGRAM_SUB_BUCKETS) << shift;
+	return lowestValue + ((uint64_t)1 << shift) - 1;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+
+//values below 2^LATENCY_HISTOGRAM_PRECISION_BITS get an exact bucket. above that every power of two is split
+//into 2^(bits - 1) linear buckets, so any recorded value is reported within 1/64th of itself
+constexpr int LATENCY_HISTOGRAM_PRECISION_BITS = 7;
+constexpr int LATENCY_HISTOGRAM_EXACT_BUCKETS = 1 << LATENCY_HISTOGRAM_PRECISION_BITS;
+constexpr int LATENCY_HISTOGRAM_SUB_BUCKETS = LATENCY_HISTOGRAM_EXACT_BUCKETS >> 1;
+constexpr int LATENCY_HISTOGRAM_NUM_BUCKETS = LATENCY_HISTOGRAM_EXACT_BUCKETS + ((64 - LATENCY_HISTOGRAM_PRECISION_BITS) * LATENCY_HISTOGRAM_SUB_BUCKETS);
+
+//the percentiles we export and graph for every profiled scope
+enum eLatencyPercentile
+{
+	P50_LATENCY_PERCENTILE,
+	P90_LATENCY_PERCENTILE,
+	P99_LATENCY_PERCENTILE,
+	P999_LATENCY_PERCENTILE,
+	NUM_LATENCY_PERCENTILES
+};
+
+extern const double g_latencyPercentileValues[NUM_LATENCY_PERCENTILES];
+extern const char* g_latencyPercentileNames[NUM_LATENCY_PERCENTILES];
+
+//  ----------------------------------------------
+/*
+hdr style log-linear histogram of hpc durations. fixed size and allocation free to record into, so every
+sample of a profiled scope can be kept instead of a running mean. one per thread, merged before export
+*/
+class LatencyHistogram
+{
+public:
+	LatencyHistogram();
+
+	void RecordValue(uint64_t value);
+	void Merge(const LatencyHistogram& other);
+	void Reset();
+
+	uint64_t GetValueAtPercentile(double percentile) const;
+	uint64_t GetTotalCount() const { return m_totalCount; }
+	uint64_t GetMinValue() const { return m_totalCount == 0 ? 0 : m_minValue; }
+	uint64_t GetMaxValue() const { return m_maxValue; }
+
+private:
+	static int GetBucketIndexForValue(uint64_t value);
+	static uint64_t GetHighestValueInBucket(int bucketIndex);
+
+private:
+	std::vector<uint64_t> m_bucketCounts;
+	uint64_t m_totalCount = 0;
+	uint64_t m_minValue = UINT64_MAX;
+	uint64_t m_maxValue = 0;
+};
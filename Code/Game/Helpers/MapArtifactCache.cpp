@@ -0,0 +1,78 @@
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include "Game\Helpers\MapArtifactCache.hpp"
+#include "Game\Helpers\SimulationSnapshot.hpp"
+#include "Engine\Core\StringUtils.hpp"
+#include "Engine\File\FileHelpers.hpp"
+#include <fstream>
+
+//  =========================================================================================
+uint64_t HashArtifactBytes(const void* data, size_t numBytes, uint64_t hash)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+	for (size_t byteIndex = 0; byteIndex < numBytes; ++byteIndex)
+	{
+		hash ^= bytes[byteIndex];
+		hash *= MAP_ARTIFACT_HASH_PRIME;
+	}
+
+	return hash;
+}
+
+//  =========================================================================================
+uint64_t HashArtifactString(const std::string& value, uint64_t hash)
+{
+	//length first so neighboring strings can't run together
+	uint32_t length = (uint32_t)value.size();
+	hash = HashArtifactBytes(&length, sizeof(length), hash);
+
+	return HashArtifactBytes(value.data(), value.size(), hash);
+}
+
+//  =========================================================================================
+bool HashArtifactFile(const std::string& filePath, uint64_t& inOutHash)
+{
+	std::ifstream file(filePath.c_str(), std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	char buffer[4096];
+	while (file)
+	{
+		file.read(buffer, sizeof(buffer));
+		inOutHash = HashArtifactBytes(buffer, (size_t)file.gcount(), inOutHash);
+	}
+
+	return true;
+}
+
+//  =========================================================================================
+std::string GetMapArtifactPath(uint64_t key)
+{
+	return Stringf("Data\\Cache\\Maps\\%016llx.map", key);
+}
+
+//  =========================================================================================
+bool WriteMapArtifactFile(const SnapshotWriter& writer, uint64_t key)
+{
+	CreateFolder("Data\\Cache");
+	CreateFolder("Data\\Cache\\Maps");
+
+	std::string artifactPath = GetMapArtifactPath(key);
+	std::string tempPath = Stringf("%s.%u.tmp", artifactPath.c_str(), (unsigned int)GetCurrentProcessId());
+
+	if (!writer.WriteToFile(tempPath))
+	{
+		DeleteFileA(tempPath.c_str());
+		return false;
+	}
+
+	//someone else finishing first is fine. the contents are the same
+	if (!MoveFileExA(tempPath.c_str(), artifactPath.c_str(), 0))
+	{
+		DeleteFileA(tempPath.c_str());
+		return false;
+	}
+
+	return true;
+}
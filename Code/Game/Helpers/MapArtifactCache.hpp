@@ -0,0 +1,26 @@
+#pragma once
+#include "Engine\Core\EngineCommon.hpp"
+#include <string>
+
+class SnapshotWriter;
+
+/*
+generated tile layouts are cached in Data\Cache\Maps and keyed by a hash of everything that feeds generation:
+the map definition xml, the seed, any files a gen step reads and MAP_ARTIFACT_VERSION.
+bump the version whenever a gen step changes what it produces or old layouts will keep being picked up.
+*/
+constexpr uint32_t MAP_ARTIFACT_MAGIC = 0x5041504D; //"MPAP"
+constexpr uint32_t MAP_ARTIFACT_VERSION = 2;
+
+//fnv-1a
+constexpr uint64_t MAP_ARTIFACT_HASH_OFFSET = 14695981039346656037ULL;
+constexpr uint64_t MAP_ARTIFACT_HASH_PRIME = 1099511628211ULL;
+
+uint64_t HashArtifactBytes(const void* data, size_t numBytes, uint64_t hash);
+uint64_t HashArtifactString(const std::string& value, uint64_t hash);
+bool HashArtifactFile(const std::string& filePath, uint64_t& inOutHash);
+
+std::string GetMapArtifactPath(uint64_t key);
+
+//writes beside the artifact and renames so sweep workers building the same map never see half a file
+bool WriteMapArtifactFile(const SnapshotWriter& writer, uint64_t key);
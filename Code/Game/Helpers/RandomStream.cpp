@@ -0,0 +1,62 @@
+#include "Game\Helpers\RandomStream.hpp"
+
+//  =========================================================================================
+RandomStream::RandomStream(uint64_t seed, uint64_t streamId)
+{
+	Reseed(seed, streamId);
+}
+
+//  =========================================================================================
+void RandomStream::Reseed(uint64_t seed, uint64_t streamId)
+{
+	//hash the stream id first so neighboring ids don't produce neighboring keys
+	m_key = Mix(seed ^ Mix(streamId + 0x9E3779B97F4A7C15ULL));
+	m_counter = 0;
+}
+
+//  =========================================================================================
+uint32_t RandomStream::GetNextUint()
+{
+	uint64_t value = Mix(m_key + (m_counter * 0x9E3779B97F4A7C15ULL));
+	++m_counter;
+
+	return (uint32_t)(value >> 32);
+}
+
+//  =========================================================================================
+float RandomStream::GetNextFloatZeroToOne()
+{
+	//top 24 bits fill a float mantissa exactly
+	return (float)(GetNextUint() >> 8) * (1.f / 16777215.f);
+}
+
+//  =========================================================================================
+float RandomStream::GetNextFloatInRange(float minInclusive, float maxInclusive)
+{
+	return minInclusive + ((maxInclusive - minInclusive) * GetNextFloatZeroToOne());
+}
+
+//  =========================================================================================
+int RandomStream::GetNextIntInRange(int minInclusive, int maxInclusive)
+{
+	if (maxInclusive <= minInclusive)
+		return minInclusive;
+
+	uint64_t range = (uint64_t)((int64_t)maxInclusive - (int64_t)minInclusive) + 1;
+
+	//multiply shift keeps the bias below 1 / 2^32
+	return minInclusive + (int)(((uint64_t)GetNextUint() * range) >> 32);
+}
+
+//  =========================================================================================
+uint64_t RandomStream::Mix(uint64_t value)
+{
+	//splitmix64 finalizer
+	value ^= value >> 30;
+	value *= 0xBF58476D1CE4E5B9ULL;
+	value ^= value >> 27;
+	value *= 0x94D049BB133111EBULL;
+	value ^= value >> 31;
+
+	return value;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "Engine\Core\EngineCommon.hpp"
+
+//every subsystem that needs randomness draws from its own stream so adding draws in one place can't shift another
+enum eRandomStreamType
+{
+	MAP_GENERATION_RANDOM_STREAM,
+	POINT_OF_INTEREST_RANDOM_STREAM,
+	AGENT_SPAWN_RANDOM_STREAM,
+	BOMBARDMENT_RANDOM_STREAM,
+	FIRE_RANDOM_STREAM,
+	NUM_RANDOM_STREAMS
+};
+
+//agents are keyed after the map streams by their id
+constexpr uint64_t AGENT_RANDOM_STREAM_OFFSET = NUM_RANDOM_STREAMS;
+constexpr uint64_t PLANNER_TEST_RANDOM_STREAM_OFFSET = 1ULL << 32;
+
+//  ----------------------------------------------
+//counter based. draw n is a pure hash of (seed, stream, n) so any stream can be rebuilt from its seed and counter
+class RandomStream
+{
+public:
+	RandomStream() {};
+	RandomStream(uint64_t seed, uint64_t streamId);
+
+	void Reseed(uint64_t seed, uint64_t streamId);
+
+	uint32_t GetNextUint();
+	float GetNextFloatZeroToOne();
+	float GetNextFloatInRange(float minInclusive, float maxInclusive);
+	int GetNextIntInRange(int minInclusive, int maxInclusive);
+
+	uint64_t GetCounter() const { return m_counter; }
+
+private:
+	static uint64_t Mix(uint64_t value);
+
+private:
+	uint64_t m_key = 0;
+	uint64_t m_counter = 0;
+};
@@ -0,0 +1,125 @@
+#include "Game\Helpers\RenderSnapshot.hpp"
+#include <thread>
+
+//  =========================================================================================
+void RenderSnapshot::Clear()
+{
+	//keep capacity so steady state ticks don't allocate
+	m_tick = 0;
+	m_agents.clear();
+	m_fireCenters.clear();
+	m_bombardmentDiscs.clear();
+}
+
+//  =========================================================================================
+static void FillCheckSnapshot(RenderSnapshot& snapshot, uint64_t tick)
+{
+	snapshot.Clear();
+	snapshot.m_tick = tick;
+
+	//counts and ids come from the tick so a snapshot mixing two ticks can't pass the check
+	int numAgents = (int)(tick % 32) + 1;
+	for (int agentIndex = 0; agentIndex < numAgents; ++agentIndex)
+	{
+		AgentRenderState agentState;
+		agentState.m_position = Vector2((float)agentIndex, 0.f);
+		agentState.m_id = (int)tick;
+		agentState.m_planType = agentIndex;
+		snapshot.m_agents.push_back(agentState);
+	}
+
+	int numFires = (int)(tick % 7);
+	for (int fireIndex = 0; fireIndex < numFires; ++fireIndex)
+	{
+		snapshot.m_fireCenters.push_back(Vector2((float)fireIndex, (float)(tick % 1024)));
+	}
+
+	int numBombardments = (int)(tick % 3);
+	for (int bombardmentIndex = 0; bombardmentIndex < numBombardments; ++bombardmentIndex)
+	{
+		snapshot.m_bombardmentDiscs.push_back(Disc2((float)bombardmentIndex, (float)(tick % 1024), 1.f));
+	}
+}
+
+//  =========================================================================================
+static bool IsCheckSnapshotValid(const RenderSnapshot& snapshot)
+{
+	uint64_t tick = snapshot.m_tick;
+	if ((int)snapshot.m_agents.size() != (int)(tick % 32) + 1
+		|| (int)snapshot.m_fireCenters.size() != (int)(tick % 7)
+		|| (int)snapshot.m_bombardmentDiscs.size() != (int)(tick % 3))
+	{
+		return false;
+	}
+
+	for (int agentIndex = 0; agentIndex < (int)snapshot.m_agents.size(); ++agentIndex)
+	{
+		const AgentRenderState& agentState = snapshot.m_agents[agentIndex];
+		if (agentState.m_id != (int)tick || agentState.m_planType != agentIndex || agentState.m_position.x != (float)agentIndex)
+			return false;
+	}
+
+	for (int fireIndex = 0; fireIndex < (int)snapshot.m_fireCenters.size(); ++fireIndex)
+	{
+		if (snapshot.m_fireCenters[fireIndex].y != (float)(tick % 1024))
+			return false;
+	}
+
+	for (int bombardmentIndex = 0; bombardmentIndex < (int)snapshot.m_bombardmentDiscs.size(); ++bombardmentIndex)
+	{
+		if (snapshot.m_bombardmentDiscs[bombardmentIndex].center.y != (float)(tick % 1024))
+			return false;
+	}
+
+	return true;
+}
+
+//  =========================================================================================
+static void RunRenderSnapshotCheckProducer(RenderSnapshotBuffer* snapshots, int numTicks)
+{
+	for (int tick = 1; tick <= numTicks; ++tick)
+	{
+		FillCheckSnapshot(snapshots->GetWriteSlot(), (uint64_t)tick);
+		snapshots->PublishWriteSlot();
+	}
+}
+
+//  =========================================================================================
+RenderSnapshotCheckResults RunRenderSnapshotCheck(int numTicks)
+{
+	RenderSnapshotCheckResults results;
+	if (numTicks < 1)
+		numTicks = 1;
+
+	results.m_numPublished = numTicks;
+
+	RenderSnapshotBuffer snapshots;
+	std::thread producerThread(RunRenderSnapshotCheckProducer, &snapshots, numTicks);
+
+	//the last publish stays flagged until taken so the consumer always gets to see it
+	uint64_t lastTick = 0;
+	while (!results.m_didSeeLastTick)
+	{
+		if (!snapshots.HasNewSlot())
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		const RenderSnapshot& snapshot = snapshots.AcquireReadSlot();
+		++results.m_numAcquired;
+
+		if (!IsCheckSnapshotValid(snapshot))
+			++results.m_numMismatched;
+
+		if (snapshot.m_tick <= lastTick)
+			++results.m_numOutOfOrder;
+
+		lastTick = snapshot.m_tick;
+		results.m_didSeeLastTick = snapshot.m_tick == (uint64_t)numTicks;
+	}
+
+	producerThread.join();
+
+	return results;
+}
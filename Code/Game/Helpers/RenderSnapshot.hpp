@@ -0,0 +1,57 @@
+#pragma once
+#include "Engine\Math\Vector2.hpp"
+#include "Engine\Math\Disc2.hpp"
+#include "Game\Helpers\TripleBuffer.hpp"
+#include <stdint.h>
+#include <vector>
+
+class Sprite;
+
+//what the agent quad and id label need. uvs are resolved on the main thread so the worker never touches a sprite
+struct AgentRenderState
+{
+	Vector2 m_position;
+	Vector2 m_uvMins;
+	Vector2 m_uvMaxs;
+
+	//main thread only. picks the texture for the agent mesh
+	Sprite* m_sprite = nullptr;
+
+	int m_id = -1;
+	int m_planType = -1;
+	float m_size = 1.f;
+};
+
+//immutable copy of everything dynamic the map draws, taken at the end of a simulation tick
+struct RenderSnapshot
+{
+	void Clear();
+
+	uint64_t m_tick = 0;
+
+	//in y list order, which is also draw order
+	std::vector<AgentRenderState> m_agents;
+	std::vector<Vector2> m_fireCenters;
+	std::vector<Disc2> m_bombardmentDiscs;
+};
+
+//the simulation (producer) publishes one snapshot per tick. the render vertex worker (consumer) builds from the newest
+typedef TripleBuffer<RenderSnapshot> RenderSnapshotBuffer;
+
+//  ----------------------------------------------
+struct RenderSnapshotCheckResults
+{
+	int m_numPublished = 0;
+	int m_numAcquired = 0;
+
+	//snapshots whose contents didn't match their tick (torn or handed over twice)
+	int m_numMismatched = 0;
+
+	//acquired snapshots that were older than one already seen
+	int m_numOutOfOrder = 0;
+
+	bool m_didSeeLastTick = false;
+};
+
+//publishes numTicks snapshots from a producer thread while this thread consumes them and checks each one it gets. no renderer needed
+RenderSnapshotCheckResults RunRenderSnapshotCheck(int numTicks);
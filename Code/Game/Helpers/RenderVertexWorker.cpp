@@ -0,0 +1,292 @@
+#include "Game\Helpers\RenderVertexWorker.hpp"
+#include "Game\GameCommon.hpp"
+#include "Game\Agents\Planner.hpp"
+#include <chrono>
+
+constexpr int RENDER_VERTEX_WORKER_SLEEP_MILLISECONDS = 1;
+
+//  =========================================================================================
+void RenderViewState::Clear()
+{
+	m_bounds = AABB2();
+	m_isCulled = false;
+}
+
+//  =========================================================================================
+void RenderVertexFrame::Clear()
+{
+	m_tick = 0;
+	m_visibleAgents.clear();
+	m_agentBuilder.FlushBuilder();
+	m_agentVertexSlots.clear();
+	m_numVerticesPerAgentQuad = 0;
+	m_fireBuilder.FlushBuilder();
+	m_bombardmentBuilder.FlushBuilder();
+	m_numAgentsCulled = 0;
+	m_numFiresCulled = 0;
+	m_numBombardmentsCulled = 0;
+}
+
+//  =========================================================================================
+static void FlushBuilderKeepingCapacity(MeshBuilder& builder)
+{
+	//the flush may hand the storage back. the busiest frame so far is a good guess for the next one
+	size_t vertexCapacity = builder.m_vertices.capacity();
+	builder.FlushBuilder();
+	builder.m_vertices.reserve(vertexCapacity);
+}
+
+//  =========================================================================================
+static bool IsBoxInView(const RenderViewState& view, const Vector2& center, float radiusX, float radiusY)
+{
+	if (!view.m_isCulled)
+		return true;
+
+	return center.x + radiusX >= view.m_bounds.mins.x
+		&& center.x - radiusX <= view.m_bounds.maxs.x
+		&& center.y + radiusY >= view.m_bounds.mins.y
+		&& center.y - radiusY <= view.m_bounds.maxs.y;
+}
+
+//  =========================================================================================
+static const Rgba& GetAgentTintForPlanType(int planType)
+{
+	static Rgba s_planTypeTints[NUM_PLAN_TYPE];
+	static bool s_areTintsInitialized = false;
+
+	//tint globals are only safe to read once main has started. only the worker thread reads this table
+	if (!s_areTintsInitialized)
+	{
+		for (int planTypeIndex = 0; planTypeIndex < NUM_PLAN_TYPE; ++planTypeIndex)
+		{
+			s_planTypeTints[planTypeIndex] = Rgba::WHITE;
+		}
+
+		s_planTypeTints[GATHER_ARROWS_PLAN_TYPE] = GATHER_ARROWS_TINT;
+		s_planTypeTints[GATHER_LUMBER_PLAN_TYPE] = GATHER_LUMBER_TINT;
+		s_planTypeTints[GATHER_BANDAGES_PLAN_TYPE] = GATHER_BANDAGES_TINT;
+		s_planTypeTints[GATHER_WATER_PLAN_TYPE] = GATHER_WATER_TINT;
+		s_planTypeTints[SHOOT_PLAN_TYPE] = SHOOT_TINT;
+		s_planTypeTints[REPAIR_PLAN_TYPE] = REPAIR_TINT;
+		s_planTypeTints[HEAL_PLAN_TYPE] = HEAL_TINT;
+		s_planTypeTints[FIGHT_FIRE_PLAN_TYPE] = PUT_OUT_FIRE_TINT;
+		s_areTintsInitialized = true;
+	}
+
+	if (planType < 0 || planType >= NUM_PLAN_TYPE)
+		return Rgba::WHITE;
+
+	return s_planTypeTints[planType];
+}
+
+//  =========================================================================================
+RenderVertexWorker::~RenderVertexWorker()
+{
+	Stop();
+	m_snapshots = nullptr;
+}
+
+//  =========================================================================================
+void RenderVertexWorker::Start(RenderSnapshotBuffer* snapshots)
+{
+	if (IsRunning())
+		return;
+
+	m_snapshots = snapshots;
+	m_isRunning.store(true, std::memory_order_release);
+	m_thread = std::thread(&RenderVertexWorker::Run, this);
+}
+
+//  =========================================================================================
+void RenderVertexWorker::Stop()
+{
+	if (!IsRunning())
+		return;
+
+	m_isRunning.store(false, std::memory_order_release);
+	m_thread.join();
+}
+
+//  =========================================================================================
+void RenderVertexWorker::SetViewBounds(const AABB2& viewBounds)
+{
+	RenderViewState& view = m_viewStates.GetWriteSlot();
+	view.m_bounds = viewBounds;
+	view.m_isCulled = true;
+
+	m_viewStates.PublishWriteSlot();
+}
+
+//  =========================================================================================
+void RenderVertexWorker::Run()
+{
+	while (IsRunning())
+	{
+		//nothing changed since the last frame we built
+		if (!m_snapshots->HasNewSlot() && !m_viewStates.HasNewSlot())
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(RENDER_VERTEX_WORKER_SLEEP_MILLISECONDS));
+			continue;
+		}
+
+		const RenderSnapshot& snapshot = m_snapshots->AcquireReadSlot();
+		const RenderViewState& view = m_viewStates.AcquireReadSlot();
+
+		RenderVertexFrame& frame = m_frames.GetWriteSlot();
+		BuildFrame(snapshot, view, frame);
+		m_frames.PublishWriteSlot();
+	}
+}
+
+//  =========================================================================================
+void RenderVertexWorker::BuildFrame(const RenderSnapshot& snapshot, const RenderViewState& view, RenderVertexFrame& frame)
+{
+	frame.m_tick = snapshot.m_tick;
+
+	UpdateVisibleAgents(snapshot, view, frame);
+	BuildAgentVertices(frame);
+	BuildFireVertices(snapshot, view, frame);
+	BuildBombardmentVertices(snapshot, view, frame);
+}
+
+//  =========================================================================================
+void RenderVertexWorker::UpdateVisibleAgents(const RenderSnapshot& snapshot, const RenderViewState& view, RenderVertexFrame& frame)
+{
+	frame.m_visibleAgents.clear();
+
+	const std::vector<AgentRenderState>& agents = snapshot.m_agents;
+	if (!view.m_isCulled)
+	{
+		frame.m_visibleAgents = agents;
+		frame.m_numAgentsCulled = 0;
+		return;
+	}
+
+	//the y list is only sorted periodically (never under search pathing) so it can't be binary searched. test every agent and keep snapshot order for drawing
+	float minY = view.m_bounds.mins.y - VIEW_CULL_MARGIN;
+	float maxY = view.m_bounds.maxs.y + VIEW_CULL_MARGIN;
+	float minX = view.m_bounds.mins.x - VIEW_CULL_MARGIN;
+	float maxX = view.m_bounds.maxs.x + VIEW_CULL_MARGIN;
+
+	for (int agentIndex = 0; agentIndex < (int)agents.size(); ++agentIndex)
+	{
+		const AgentRenderState& agent = agents[agentIndex];
+		if (agent.m_position.x >= minX && agent.m_position.x <= maxX
+			&& agent.m_position.y >= minY && agent.m_position.y <= maxY)
+		{
+			frame.m_visibleAgents.push_back(agent);
+		}
+	}
+
+	frame.m_numAgentsCulled = (int)agents.size() - (int)frame.m_visibleAgents.size();
+}
+
+//  =========================================================================================
+void RenderVertexWorker::BuildAgentVertices(RenderVertexFrame& frame)
+{
+	MeshBuilder& agentBuilder = frame.m_agentBuilder;
+
+	//agent count changes (including agents crossing the view edge) and fresh frames lay every slot out again
+	int numAgents = (int)frame.m_visibleAgents.size();
+	bool isFullRebuild = (int)frame.m_agentVertexSlots.size() != numAgents
+		|| (int)agentBuilder.m_vertices.size() != numAgents * frame.m_numVerticesPerAgentQuad
+		|| frame.m_numVerticesPerAgentQuad == 0;
+
+	if (isFullRebuild)
+	{
+		FlushBuilderKeepingCapacity(agentBuilder);
+		frame.m_agentVertexSlots.clear();
+		frame.m_agentVertexSlots.resize(numAgents);
+	}
+
+	//slots follow the snapshot order so draw order is kept. the y list changes order slowly so only a few slots change hands per frame
+	for (int agentIndex = 0; agentIndex < numAgents; ++agentIndex)
+	{
+		const AgentRenderState& agent = frame.m_visibleAgents[agentIndex];
+		const Vector2& uvMins = agent.m_uvMins;
+		const Vector2& uvMaxs = agent.m_uvMaxs;
+		int planType = agent.m_planType;
+		float agentSize = agent.m_size;
+
+		AgentVertexSlot& slot = frame.m_agentVertexSlots[agentIndex];
+		if (!isFullRebuild
+			&& slot.m_agentId == agent.m_id
+			&& slot.m_uvMins == uvMins
+			&& slot.m_uvMaxs == uvMaxs
+			&& slot.m_planType == planType
+			&& slot.m_size == agentSize
+			&& slot.m_position.x == agent.m_position.x
+			&& slot.m_position.y == agent.m_position.y)
+		{
+			continue;
+		}
+
+		slot.m_agentId = agent.m_id;
+		slot.m_uvMins = uvMins;
+		slot.m_uvMaxs = uvMaxs;
+		slot.m_planType = planType;
+		slot.m_size = agentSize;
+		slot.m_position = agent.m_position;
+
+		if (isFullRebuild)
+		{
+			agentBuilder.CreateTexturedQuad2D(agent.m_position, Vector2(agentSize, agentSize), uvMins, uvMaxs, GetAgentTintForPlanType(planType));
+			continue;
+		}
+
+		//build the one quad on the side and copy its vertices over the slot. indices never change
+		m_agentQuadBuilder.FlushBuilder();
+		m_agentQuadBuilder.CreateTexturedQuad2D(agent.m_position, Vector2(agentSize, agentSize), uvMins, uvMaxs, GetAgentTintForPlanType(planType));
+
+		int firstVertexIndex = agentIndex * frame.m_numVerticesPerAgentQuad;
+		for (int vertexIndex = 0; vertexIndex < frame.m_numVerticesPerAgentQuad; ++vertexIndex)
+		{
+			agentBuilder.m_vertices[firstVertexIndex + vertexIndex] = m_agentQuadBuilder.m_vertices[vertexIndex];
+		}
+	}
+
+	if (isFullRebuild && numAgents > 0)
+		frame.m_numVerticesPerAgentQuad = (int)agentBuilder.m_vertices.size() / numAgents;
+}
+
+//  =========================================================================================
+void RenderVertexWorker::BuildFireVertices(const RenderSnapshot& snapshot, const RenderViewState& view, RenderVertexFrame& frame)
+{
+	FlushBuilderKeepingCapacity(frame.m_fireBuilder);
+	frame.m_numFiresCulled = 0;
+
+	const std::vector<Vector2>& fireCenters = snapshot.m_fireCenters;
+	for (int fireIndex = 0; fireIndex < (int)fireCenters.size(); ++fireIndex)
+	{
+		const Vector2& fireCenter = fireCenters[fireIndex];
+		if (!IsBoxInView(view, fireCenter, 0.5f, 0.5f))
+		{
+			++frame.m_numFiresCulled;
+			continue;
+		}
+
+		AABB2 fireBox = AABB2(fireCenter, 0.5f, 0.5f);
+		frame.m_fireBuilder.CreateTexturedQuad2D(fireBox.GetCenter(), fireBox.GetDimensions(), Vector2::ZERO, Vector2::ONE, Rgba(1.f, 1.f, 1.f, 0.7f));
+	}
+}
+
+//  =========================================================================================
+void RenderVertexWorker::BuildBombardmentVertices(const RenderSnapshot& snapshot, const RenderViewState& view, RenderVertexFrame& frame)
+{
+	FlushBuilderKeepingCapacity(frame.m_bombardmentBuilder);
+	frame.m_numBombardmentsCulled = 0;
+
+	const std::vector<Disc2>& bombardmentDiscs = snapshot.m_bombardmentDiscs;
+	for (int bombardmentIndex = 0; bombardmentIndex < (int)bombardmentDiscs.size(); ++bombardmentIndex)
+	{
+		const Disc2& disc = bombardmentDiscs[bombardmentIndex];
+		if (!IsBoxInView(view, disc.center, disc.radius, disc.radius))
+		{
+			++frame.m_numBombardmentsCulled;
+			continue;
+		}
+
+		AABB2 bombardmentBox = AABB2(disc.center, disc.radius, disc.radius);
+		frame.m_bombardmentBuilder.CreateTexturedQuad2D(disc.center, bombardmentBox.GetDimensions(), Vector2::ZERO, Vector2::ONE, Rgba(1.f, 1.f, 1.f, .5f));
+	}
+}
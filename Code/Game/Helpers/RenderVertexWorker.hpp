@@ -0,0 +1,99 @@
+#pragma once
+#include "Game\Helpers\RenderSnapshot.hpp"
+#include "Game\Helpers\TripleBuffer.hpp"
+#include "Engine\Math\AABB2.hpp"
+#include "Engine\Renderer\MeshBuilder.hpp"
+#include <atomic>
+#include <thread>
+
+//slack around the camera rect. covers the largest agent quad and the id labels above it
+constexpr float VIEW_CULL_MARGIN = 2.f;
+
+//world rect the camera sees. nothing is culled until the playing state hands one over
+struct RenderViewState
+{
+	void Clear();
+
+	AABB2 m_bounds;
+	bool m_isCulled = false;
+};
+
+//what was last written into an agent's quad. the quad is only rebuilt when one of these changes
+struct AgentVertexSlot
+{
+	int m_agentId = -1;
+	Vector2 m_uvMins;
+	Vector2 m_uvMaxs;
+	Vector2 m_position;
+	float m_size = 0.f;
+	int m_planType = -1;
+};
+
+//cpu side geometry for one snapshot. built on the worker, the main thread only uploads and draws it
+struct RenderVertexFrame
+{
+	void Clear();
+
+	uint64_t m_tick = 0;
+
+	//agents inside the view in snapshot order. the id labels are built from these on the main thread
+	std::vector<AgentRenderState> m_visibleAgents;
+
+	//one quad per visible agent. slots remember what each quad holds so unchanged quads are skipped
+	MeshBuilder m_agentBuilder;
+	std::vector<AgentVertexSlot> m_agentVertexSlots;
+	int m_numVerticesPerAgentQuad = 0;
+
+	MeshBuilder m_fireBuilder;
+	MeshBuilder m_bombardmentBuilder;
+
+	//left out of this frame
+	int m_numAgentsCulled = 0;
+	int m_numFiresCulled = 0;
+	int m_numBombardmentsCulled = 0;
+};
+
+//  ----------------------------------------------
+/*
+consumer of the render snapshots. a thread takes the newest snapshot (or a new view), culls it and builds the agent,
+fire and bombardment vertices into a frame. frames go back to the main thread through a second triple buffer so the
+only mesh work left there is the gpu upload, which needs the renderer's context
+*/
+class RenderVertexWorker
+{
+public:
+	~RenderVertexWorker();
+
+	void Start(RenderSnapshotBuffer* snapshots);
+	void Stop();
+	bool IsRunning() const { return m_isRunning.load(std::memory_order_acquire); }
+
+	//main thread
+	void SetViewBounds(const AABB2& viewBounds);
+	bool HasNewFrame() const { return m_frames.HasNewSlot(); }
+	RenderVertexFrame& AcquireFrame() { return m_frames.AcquireReadSlot(); }
+
+private:
+	void Run();
+
+	void BuildFrame(const RenderSnapshot& snapshot, const RenderViewState& view, RenderVertexFrame& frame);
+	void UpdateVisibleAgents(const RenderSnapshot& snapshot, const RenderViewState& view, RenderVertexFrame& frame);
+	void BuildAgentVertices(RenderVertexFrame& frame);
+	void BuildFireVertices(const RenderSnapshot& snapshot, const RenderViewState& view, RenderVertexFrame& frame);
+	void BuildBombardmentVertices(const RenderSnapshot& snapshot, const RenderViewState& view, RenderVertexFrame& frame);
+
+private:
+	RenderSnapshotBuffer* m_snapshots = nullptr;
+
+	//main thread -> worker
+	TripleBuffer<RenderViewState> m_viewStates;
+
+	//worker -> main thread
+	TripleBuffer<RenderVertexFrame> m_frames;
+
+	//scratch for rebuilding a single agent quad
+	MeshBuilder m_agentQuadBuilder;
+
+	std::thread m_thread;
+	std::atomic<bool> m_isRunning{false};
+};
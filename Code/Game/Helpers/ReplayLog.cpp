@@ -0,0 +1,124 @@
+#include "Game\Helpers\ReplayLog.hpp"
+#include "Engine\Core\ErrorWarningAssert.hpp"
+#include "Engine\Core\StringUtils.hpp"
+#include <fstream>
+
+constexpr uint32_t REPLAY_LOG_MAGIC = 0x52504C47; //"RPLG"
+constexpr uint32_t REPLAY_LOG_VERSION = 1;
+
+//  =========================================================================================
+void ReplayLog::BeginRecording(int seed)
+{
+	m_mode = RECORDING_REPLAY_MODE;
+	m_seed = seed;
+	m_frames.clear();
+	m_playbackFrameIndex = 0;
+}
+
+//  =========================================================================================
+void ReplayLog::BeginPlayback(const std::string& filePath, int seed)
+{
+	bool success = ReadFromFile(filePath);
+	ASSERT_OR_DIE(success, Stringf("UNABLE TO READ REPLAY LOG (%s)", filePath.c_str()).c_str());
+
+	//a log from another seed would replay inputs against a different world
+	ASSERT_OR_DIE(m_seed == seed, Stringf("REPLAY LOG SEED MISMATCH (%s)", filePath.c_str()).c_str());
+
+	m_mode = PLAYBACK_REPLAY_MODE;
+	m_playbackFrameIndex = 0;
+}
+
+//  =========================================================================================
+void ReplayLog::Stop()
+{
+	m_mode = NO_REPLAY_MODE;
+	m_frames.clear();
+	m_playbackFrameIndex = 0;
+}
+
+//  =========================================================================================
+void ReplayLog::RecordFrame(const ReplayFrame& frame)
+{
+	m_frames.push_back(frame);
+}
+
+//  =========================================================================================
+bool ReplayLog::ReadNextFrame(ReplayFrame& outFrame)
+{
+	if (m_playbackFrameIndex >= (int)m_frames.size())
+		return false;
+
+	outFrame = m_frames[m_playbackFrameIndex];
+	++m_playbackFrameIndex;
+
+	return true;
+}
+
+//  =========================================================================================
+bool ReplayLog::WriteToFile(const std::string& filePath) const
+{
+	std::ofstream file(filePath.c_str(), std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	uint32_t numFrames = (uint32_t)m_frames.size();
+
+	file.write((const char*)&REPLAY_LOG_MAGIC, sizeof(uint32_t));
+	file.write((const char*)&REPLAY_LOG_VERSION, sizeof(uint32_t));
+	file.write((const char*)&m_seed, sizeof(int));
+	file.write((const char*)&numFrames, sizeof(uint32_t));
+
+	//fields are written one at a time so struct padding never ends up in the file
+	for (uint32_t frameIndex = 0; frameIndex < numFrames; ++frameIndex)
+	{
+		const ReplayFrame& frame = m_frames[frameIndex];
+		uint8_t didSort = frame.m_didSortByPriority ? 1 : 0;
+
+		file.write((const char*)&frame.m_deltaSeconds, sizeof(float));
+		file.write((const char*)&frame.m_numFullAgentUpdates, sizeof(int));
+		file.write((const char*)&didSort, sizeof(uint8_t));
+	}
+
+	return file.good();
+}
+
+//  =========================================================================================
+bool ReplayLog::ReadFromFile(const std::string& filePath)
+{
+	std::ifstream file(filePath.c_str(), std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t numFrames = 0;
+
+	file.read((char*)&magic, sizeof(uint32_t));
+	file.read((char*)&version, sizeof(uint32_t));
+	file.read((char*)&m_seed, sizeof(int));
+	file.read((char*)&numFrames, sizeof(uint32_t));
+
+	if (!file.good() || magic != REPLAY_LOG_MAGIC || version != REPLAY_LOG_VERSION)
+		return false;
+
+	m_frames.clear();
+	m_frames.reserve(numFrames);
+
+	for (uint32_t frameIndex = 0; frameIndex < numFrames; ++frameIndex)
+	{
+		ReplayFrame frame;
+		uint8_t didSort = 0;
+
+		file.read((char*)&frame.m_deltaSeconds, sizeof(float));
+		file.read((char*)&frame.m_numFullAgentUpdates, sizeof(int));
+		file.read((char*)&didSort, sizeof(uint8_t));
+
+		if (!file.good())
+			return false;
+
+		frame.m_didSortByPriority = didSort != 0;
+		m_frames.push_back(frame);
+	}
+
+	return true;
+}
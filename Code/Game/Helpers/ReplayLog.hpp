@@ -0,0 +1,46 @@
+#pragma once
+#include "Engine\Core\EngineCommon.hpp"
+#include <string>
+#include <vector>
+
+enum eReplayMode
+{
+	NO_REPLAY_MODE,
+	RECORDING_REPLAY_MODE,
+	PLAYBACK_REPLAY_MODE,
+	NUM_REPLAY_MODES
+};
+
+//everything the sim reads from outside itself in a frame. the seed covers the rest
+struct ReplayFrame
+{
+	float m_deltaSeconds = 0.f;
+	int m_numFullAgentUpdates = -1;		//budgeted sims only. agents past this count got a quick update
+	bool m_didSortByPriority = false;	//budgeted sims only
+};
+
+//  ----------------------------------------------
+class ReplayLog
+{
+public:
+	void BeginRecording(int seed);
+	void BeginPlayback(const std::string& filePath, int seed);
+	void Stop();
+
+	void RecordFrame(const ReplayFrame& frame);
+	bool ReadNextFrame(ReplayFrame& outFrame);
+
+	bool IsRecording() const { return m_mode == RECORDING_REPLAY_MODE; }
+	bool IsPlayingBack() const { return m_mode == PLAYBACK_REPLAY_MODE; }
+	bool IsActive() const { return m_mode != NO_REPLAY_MODE; }
+	bool IsPlaybackFinished() const { return IsPlayingBack() && m_playbackFrameIndex >= (int)m_frames.size(); }
+
+	bool WriteToFile(const std::string& filePath) const;
+	bool ReadFromFile(const std::string& filePath);
+
+public:
+	eReplayMode m_mode = NO_REPLAY_MODE;
+	int m_seed = 0;
+	std::vector<ReplayFrame> m_frames;
+	int m_playbackFrameIndex = 0;
+};
@@ -0,0 +1,107 @@
+#pragma once
+#include "Game\Map\Map.hpp"
+#include "Game\Agents\Agent.hpp"
+#include "Game\Agents\Planner.hpp"
+#include "Game\Helpers\UtilityStorage.hpp"
+#include "Engine\Utility\Grid.hpp"
+
+/*
+policies are chosen ONCE per simulation (see Map::SelectAgentUpdateFunction) and passed down
+the agent update as template arguments so the hot loops carry no GetIsOptimized() branches.
+
+instrumentation follows the same idea with the analysis policies in AnalysisScope.hpp
+*/
+
+// utility memoization ----------------------------------------------
+struct MemoizedUtilityPolicy
+{
+	static inline bool TryGetStoredUtility(UtilityStorage* storage, float input, float& outValue, int& outIndex)
+	{
+		return storage->DoesValueExistForInput(input, outValue, outIndex);
+	}
+
+	static inline void StoreUtility(UtilityStorage* storage, float utility, int index)
+	{
+		storage->StoreValueForInputAtIndex(utility, index);
+	}
+};
+
+//  ----------------------------------------------
+struct UnmemoizedUtilityPolicy
+{
+	static inline bool TryGetStoredUtility(UtilityStorage* storage, float input, float& outValue, int& outIndex)
+	{
+		UNUSED(storage);
+		UNUSED(input);
+		UNUSED(outValue);
+		UNUSED(outIndex);
+		return false;
+	}
+
+	static inline void StoreUtility(UtilityStorage* storage, float utility, int index)
+	{
+		UNUSED(storage);
+		UNUSED(utility);
+		UNUSED(index);
+	}
+};
+
+// pathing ----------------------------------------------
+struct CopyPathPolicy
+{
+	//borrow a nearby agent's path before paying for an A*
+	static inline bool QueuePath(Planner* planner, const Vector2& endPosition)
+	{
+		return planner->FindAgentAndCopyPath(endPosition);
+	}
+
+	//the map keeps its grid up to date so we can search it directly
+	static inline Grid<int>* GetPathingGrid(Map* map, Grid<int>& scratchGrid)
+	{
+		UNUSED(scratchGrid);
+		return map->m_mapAsGrid;
+	}
+
+	//path copying relies on the x/y sorted lists
+	static inline void UpdateSortedAgentLists(Map* map)
+	{
+		if (map->m_timingWheel.ConsumeExpirations(map->m_sortTimer) > 0)
+		{
+			map->SortAgentsByX();
+			map->SortAgentsByY();
+		}
+	}
+};
+
+//  ----------------------------------------------
+struct SearchPathPolicy
+{
+	static inline bool QueuePath(Planner* planner, const Vector2& endPosition)
+	{
+		return planner->m_agent->GetPathToDestination<SearchPathPolicy>(endPosition);
+	}
+
+	//build a fresh grid for every search
+	static inline Grid<int>* GetPathingGrid(Map* map, Grid<int>& scratchGrid)
+	{
+		map->GetAsGrid(scratchGrid);
+		return &scratchGrid;
+	}
+
+	static inline void UpdateSortedAgentLists(Map* map)
+	{
+		UNUSED(map);
+	}
+};
+
+// simulation ----------------------------------------------
+template <typename UtilityPolicyType, typename PathingPolicyType>
+struct SimulationPolicy
+{
+	typedef UtilityPolicyType UtilityPolicy;
+	typedef PathingPolicyType PathingPolicy;
+};
+
+typedef SimulationPolicy<MemoizedUtilityPolicy, CopyPathPolicy> OptimizedSimulationPolicy;
+typedef SimulationPolicy<UnmemoizedUtilityPolicy, SearchPathPolicy> UnoptimizedSimulationPolicy;
+
@@ -0,0 +1,166 @@
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include "Game\Helpers\SimulationSnapshot.hpp"
+#include <fstream>
+#include <cstring>
+
+//  =========================================================================================
+void SnapshotWriter::WriteString(const std::string& value)
+{
+	Write((uint32_t)value.size());
+	WriteBytes(value.data(), value.size());
+}
+
+//  =========================================================================================
+void SnapshotWriter::WriteBytes(const void* data, size_t numBytes)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+	m_buffer.insert(m_buffer.end(), bytes, bytes + numBytes);
+}
+
+//  =========================================================================================
+bool SnapshotWriter::WriteToFile(const std::string& filePath) const
+{
+	std::ofstream file(filePath.c_str(), std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	file.write((const char*)m_buffer.data(), m_buffer.size());
+	return file.good();
+}
+
+//  =========================================================================================
+SnapshotReader::~SnapshotReader()
+{
+	CloseFile();
+}
+
+//  =========================================================================================
+bool SnapshotReader::ReadFromFile(const std::string& filePath)
+{
+	CloseFile();
+
+	std::ifstream file(filePath.c_str(), std::ios::binary | std::ios::ate);
+	if (!file.is_open())
+		return false;
+
+	std::streamsize fileSize = file.tellg();
+	file.seekg(0, std::ios::beg);
+
+	m_buffer.resize((size_t)fileSize);
+	m_cursor = 0;
+	m_isValid = true;
+
+	if (fileSize > 0)
+		file.read((char*)m_buffer.data(), fileSize);
+
+	m_data = m_buffer.data();
+	m_size = m_buffer.size();
+
+	return file.good();
+}
+
+//  =========================================================================================
+bool SnapshotReader::MapFile(const std::string& filePath)
+{
+	CloseFile();
+
+	HANDLE fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+	{
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mappingHandle == nullptr)
+	{
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	const void* view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if (view == nullptr)
+	{
+		CloseHandle(mappingHandle);
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	m_fileHandle = fileHandle;
+	m_mappingHandle = mappingHandle;
+	m_data = (const unsigned char*)view;
+	m_size = (size_t)fileSize.QuadPart;
+	m_cursor = 0;
+	m_isValid = true;
+
+	return true;
+}
+
+//  =========================================================================================
+void SnapshotReader::CloseFile()
+{
+	if (m_mappingHandle != nullptr)
+	{
+		UnmapViewOfFile(m_data);
+		CloseHandle((HANDLE)m_mappingHandle);
+		CloseHandle((HANDLE)m_fileHandle);
+
+		m_mappingHandle = nullptr;
+		m_fileHandle = nullptr;
+	}
+
+	m_buffer.clear();
+	m_data = nullptr;
+	m_size = 0;
+	m_cursor = 0;
+}
+
+//  =========================================================================================
+std::string SnapshotReader::ReadString()
+{
+	uint32_t length = Read<uint32_t>();
+	if (!CanRead(length))
+	{
+		m_isValid = false;
+		return "";
+	}
+
+	std::string value((const char*)m_data + m_cursor, length);
+	m_cursor += length;
+
+	return value;
+}
+
+//  =========================================================================================
+void SnapshotReader::ReadBytes(void* outData, size_t numBytes)
+{
+	if (!CanRead(numBytes))
+	{
+		m_isValid = false;
+		memset(outData, 0, numBytes);
+		return;
+	}
+
+	memcpy(outData, m_data + m_cursor, numBytes);
+	m_cursor += numBytes;
+}
+
+//  =========================================================================================
+const unsigned char* SnapshotReader::ReadInPlace(size_t numBytes)
+{
+	if (!CanRead(numBytes))
+	{
+		m_isValid = false;
+		return nullptr;
+	}
+
+	const unsigned char* data = m_data + m_cursor;
+	m_cursor += numBytes;
+
+	return data;
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include "Engine\Core\EngineCommon.hpp"
+#include <string>
+#include <vector>
+
+//bump whenever anything written by a WriteSnapshot changes. plain structs are written as raw bytes so the layout is tied to the build
+constexpr uint32_t SIMULATION_SNAPSHOT_MAGIC = 0x50414E53; //"SNAP"
+constexpr uint32_t SIMULATION_SNAPSHOT_VERSION = 3;
+
+//  ----------------------------------------------
+class SnapshotWriter
+{
+public:
+	template <typename T>
+	void Write(const T& value) { WriteBytes(&value, sizeof(T)); }
+
+	template <typename T>
+	void WriteVector(const std::vector<T>& values)
+	{
+		Write((uint32_t)values.size());
+		if (values.size() > 0)
+			WriteBytes(values.data(), sizeof(T) * values.size());
+	}
+
+	void WriteString(const std::string& value);
+	void WriteBytes(const void* data, size_t numBytes);
+
+	bool WriteToFile(const std::string& filePath) const;
+
+public:
+	std::vector<unsigned char> m_buffer;
+};
+
+//  ----------------------------------------------
+//the file is either pulled in with one read or memory mapped, then parsed in place. reads past the end zero fill and flag the reader as bad
+class SnapshotReader
+{
+public:
+	SnapshotReader() {};
+	~SnapshotReader();
+
+	bool ReadFromFile(const std::string& filePath);
+	bool MapFile(const std::string& filePath);
+	void CloseFile();
+
+	template <typename T>
+	T Read()
+	{
+		T value;
+		ReadBytes(&value, sizeof(T));
+		return value;
+	}
+
+	template <typename T>
+	void Read(T& outValue) { ReadBytes(&outValue, sizeof(T)); }
+
+	template <typename T>
+	void ReadVector(std::vector<T>& outValues)
+	{
+		uint32_t count = Read<uint32_t>();
+		if (!CanRead(sizeof(T) * (size_t)count))
+		{
+			m_isValid = false;
+			outValues.clear();
+			return;
+		}
+
+		outValues.resize(count);
+		if (count > 0)
+			ReadBytes(outValues.data(), sizeof(T) * count);
+	}
+
+	std::string ReadString();
+	void ReadBytes(void* outData, size_t numBytes);
+
+	//points straight into the file so big blocks can be copied out without a staging buffer. nullptr when there isn't enough left
+	const unsigned char* ReadInPlace(size_t numBytes);
+
+	inline bool CanRead(size_t numBytes) const { return m_cursor + numBytes <= m_size; }
+	inline bool IsValid() const { return m_isValid; }
+
+private:
+	//readers own a mapping so they can't be copied
+	SnapshotReader(const SnapshotReader& reader) = delete;
+	SnapshotReader& operator=(const SnapshotReader& reader) = delete;
+
+public:
+	std::vector<unsigned char> m_buffer;
+	const unsigned char* m_data = nullptr;
+	size_t m_size = 0;
+	size_t m_cursor = 0;
+	bool m_isValid = true;
+
+private:
+	void* m_fileHandle = nullptr;
+	void* m_mappingHandle = nullptr;
+};
@@ -0,0 +1,56 @@
+#include "Game\Helpers\SlackTaskQueue.hpp"
+#include "Engine\Time\Time.hpp"
+#include "Engine\Profiler\Profiler.hpp"
+
+//  =========================================================================================
+void SlackTaskQueue::AddTask(SlackTaskCallback callback)
+{
+	SlackTask task;
+	task.m_callback = callback;
+
+	m_tasks.push_back(task);
+}
+
+//  =========================================================================================
+void SlackTaskQueue::Clear()
+{
+	m_tasks.clear();
+	m_currentTaskIndex = 0;
+}
+
+//  =========================================================================================
+void SlackTaskQueue::ResetCursors()
+{
+	for (int taskIndex = 0; taskIndex < (int)m_tasks.size(); ++taskIndex)
+	{
+		m_tasks[taskIndex].m_cursor = 0;
+	}
+
+	m_currentTaskIndex = 0;
+}
+
+//  =========================================================================================
+void SlackTaskQueue::RunUntil(Map* map, uint64_t deadlineHPC)
+{
+	PROFILER_PUSH();
+
+	int numTasks = (int)m_tasks.size();
+	if (numTasks == 0)
+		return;
+
+	//stop once every task has finished a pass this frame so idle tasks don't spin until the deadline
+	int numPassesCompleted = 0;
+	while (numPassesCompleted < numTasks && GetPerformanceCounter() < deadlineHPC)
+	{
+		SlackTask& task = m_tasks[m_currentTaskIndex];
+
+		if (task.m_callback(map, task.m_cursor, deadlineHPC) == PASS_COMPLETE_SLACK_TASK_RESULT)
+		{
+			task.m_cursor = 0;
+			++numPassesCompleted;
+
+			//move on to the next task once this one reaches the end of its data
+			m_currentTaskIndex = (m_currentTaskIndex + 1) % numTasks;
+		}
+	}
+}
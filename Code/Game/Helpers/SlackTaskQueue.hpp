@@ -0,0 +1,37 @@
+#pragma once
+#include "Engine\Core\EngineCommon.hpp"
+#include <vector>
+
+class Map;
+
+enum eSlackTaskResult
+{
+	WORKING_SLACK_TASK_RESULT,		//did one chunk and there is more to do
+	PASS_COMPLETE_SLACK_TASK_RESULT,	//reached the end of its data this pass
+	NUM_SLACK_TASK_RESULTS
+};
+
+//each call should only do one small chunk of work (ex: one agent, one table entry) so we can stop at the deadline.
+//tasks that skip over entries inside a call check the deadline themselves and return WORKING when it passes
+typedef eSlackTaskResult (*SlackTaskCallback)(Map* map, int& inOutCursor, uint64_t deadlineHPC);
+
+struct SlackTask
+{
+	SlackTaskCallback m_callback = nullptr;
+	int m_cursor = 0;
+};
+
+//  ----------------------------------------------
+class SlackTaskQueue
+{
+public:
+	void AddTask(SlackTaskCallback callback);
+	void Clear();
+	void ResetCursors();
+
+	void RunUntil(Map* map, uint64_t deadlineHPC);
+
+public:
+	std::vector<SlackTask> m_tasks;
+	int m_currentTaskIndex = 0;
+};
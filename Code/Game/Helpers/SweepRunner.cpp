@@ -0,0 +1,135 @@
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include "Game\Helpers\SweepRunner.hpp"
+#include "Game\Definitions\SimulationSweepDefinition.hpp"
+#include "Engine\Core\ErrorWarningAssert.hpp"
+#include "Engine\Core\StringUtils.hpp"
+#include "Engine\File\FileHelpers.hpp"
+#include <vector>
+#include <stdlib.h>
+
+static SweepWorkerInfo s_sweepWorkerInfo;
+
+//  =============================================================================
+static void TokenizeCommandLine(const std::string& commandLine, std::vector<std::string>& outTokens)
+{
+	std::string token = "";
+	bool isInQuotes = false;
+
+	for (int charIndex = 0; charIndex < (int)commandLine.size(); ++charIndex)
+	{
+		char character = commandLine[charIndex];
+		if (character == '"')
+		{
+			isInQuotes = !isInQuotes;
+		}
+		else if (character == ' ' && !isInQuotes)
+		{
+			if (!token.empty())
+				outTokens.push_back(token);
+			token.clear();
+		}
+		else
+		{
+			token.push_back(character);
+		}
+	}
+
+	if (!token.empty())
+		outTokens.push_back(token);
+}
+
+//  =============================================================================
+void ParseSweepWorkerCommandLine(const std::string& commandLine)
+{
+	std::vector<std::string> tokens;
+	TokenizeCommandLine(commandLine, tokens);
+
+	for (int tokenIndex = 0; tokenIndex + 1 < (int)tokens.size(); ++tokenIndex)
+	{
+		const std::string& option = tokens[tokenIndex];
+		const std::string& value = tokens[tokenIndex + 1];
+
+		if (option == "-sweep")
+			s_sweepWorkerInfo.m_sweepIndex = atoi(value.c_str());
+		else if (option == "-worker")
+			s_sweepWorkerInfo.m_workerIndex = atoi(value.c_str());
+		else if (option == "-workers")
+			s_sweepWorkerInfo.m_numWorkers = atoi(value.c_str());
+		else if (option == "-output")
+			s_sweepWorkerInfo.m_outputDirectory = Stringf("%s\\", value.c_str());
+		else
+			continue;
+
+		//skip the value we just consumed
+		++tokenIndex;
+	}
+
+	if (!IsSweepWorker())
+		return;
+
+	ASSERT_OR_DIE(s_sweepWorkerInfo.m_numWorkers > 0, "SWEEP WORKER NEEDS AT LEAST ONE WORKER");
+	ASSERT_OR_DIE(s_sweepWorkerInfo.m_workerIndex >= 0 && s_sweepWorkerInfo.m_workerIndex < s_sweepWorkerInfo.m_numWorkers, "SWEEP WORKER INDEX OUT OF RANGE");
+	ASSERT_OR_DIE(!IsStringNullOrEmpty(s_sweepWorkerInfo.m_outputDirectory), "SWEEP WORKER HAS NO OUTPUT FOLDER");
+}
+
+//  =============================================================================
+bool IsSweepWorker()
+{
+	return s_sweepWorkerInfo.m_sweepIndex >= 0;
+}
+
+//  =============================================================================
+const SweepWorkerInfo& GetSweepWorkerInfo()
+{
+	return s_sweepWorkerInfo;
+}
+
+//  =============================================================================
+int LaunchSweepWorkers(int sweepIndex)
+{
+	if (sweepIndex < 0 || sweepIndex >= (int)SimulationSweepDefinition::s_sweepDefinitions.size())
+		return 0;
+
+	SimulationSweepDefinition* sweep = SimulationSweepDefinition::s_sweepDefinitions[sweepIndex];
+	int numWorkers = sweep->GetNumWorkers();
+
+	//every worker exports into the same tree
+	std::string outputFolder = Stringf("Data\\ExportedSimulationData\\SIMULATION_SWEEP_%s_%s", sweep->m_name.c_str(), GetCurrentDateTime().c_str());
+	bool success = CreateFolder(outputFolder.c_str());
+	ASSERT_OR_DIE(success, Stringf("UNABLE TO CREATE FOLDER (%s)", outputFolder.c_str()).c_str());
+
+	char executablePath[MAX_PATH];
+	GetModuleFileNameA(nullptr, executablePath, MAX_PATH);
+
+	int numLaunched = 0;
+	for (int workerIndex = 0; workerIndex < numWorkers; ++workerIndex)
+	{
+		std::string commandLine = Stringf("\"%s\" -sweep %i -worker %i -workers %i -output \"%s\"", executablePath, sweepIndex, workerIndex, numWorkers, outputFolder.c_str());
+
+		//CreateProcess may write to the command line so hand it a copy
+		std::vector<char> commandLineBuffer(commandLine.begin(), commandLine.end());
+		commandLineBuffer.push_back('\0');
+
+		STARTUPINFOA startupInfo;
+		ZeroMemory(&startupInfo, sizeof(startupInfo));
+		startupInfo.cb = sizeof(startupInfo);
+
+		//workers don't need to be looked at
+		startupInfo.dwFlags = STARTF_USESHOWWINDOW;
+		startupInfo.wShowWindow = SW_SHOWMINNOACTIVE;
+
+		PROCESS_INFORMATION processInfo;
+		ZeroMemory(&processInfo, sizeof(processInfo));
+
+		//inherit the working directory so Data\ paths resolve the same as ours
+		if (CreateProcessA(executablePath, commandLineBuffer.data(), nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startupInfo, &processInfo))
+		{
+			CloseHandle(processInfo.hThread);
+			CloseHandle(processInfo.hProcess);
+			++numLaunched;
+		}
+	}
+
+	return numLaunched;
+}
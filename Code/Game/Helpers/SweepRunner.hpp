@@ -0,0 +1,32 @@
+#pragma once
+#include <string>
+
+/*
+sweeps run in worker processes rather than threads. the sim leans on globals (current definition, analysis data,
+shared utility storages, optimization flag) so a process per core is the only way to keep each Map isolated.
+
+workers are launched with: -sweep <sweepIndex> -worker <workerIndex> -workers <numWorkers> -output "<folder>"
+*/
+
+//fixed step sweep workers advance by so results don't depend on how busy the machine is
+constexpr float SWEEP_FIXED_DELTA_SECONDS = 1.f / 60.f;
+
+//wall time a worker spends stepping before handing the frame back to the window
+constexpr double SWEEP_MAX_STEP_SECONDS_PER_FRAME = 0.1;
+
+struct SweepWorkerInfo
+{
+	int m_sweepIndex = -1;
+	int m_workerIndex = 0;
+	int m_numWorkers = 1;
+
+	//shared by every worker in the sweep. includes the trailing slash
+	std::string m_outputDirectory = "";
+};
+
+void ParseSweepWorkerCommandLine(const std::string& commandLine);
+bool IsSweepWorker();
+const SweepWorkerInfo& GetSweepWorkerInfo();
+
+//creates the shared output folder and starts one process per worker. returns the number started
+int LaunchSweepWorkers(int sweepIndex);
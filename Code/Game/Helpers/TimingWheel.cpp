@@ -0,0 +1,252 @@
+#include "Game\Helpers\TimingWheel.hpp"
+#include "Game\Helpers\SimulationSnapshot.hpp"
+#include "Engine\Core\ErrorWarningAssert.hpp"
+#include "Engine\Profiler\Profiler.hpp"
+
+//  =========================================================================================
+TimingWheel::TimingWheel()
+{
+	for (int slotIndex = 0; slotIndex < TIMING_WHEEL_NUM_SLOTS; ++slotIndex)
+	{
+		m_slotHeads[slotIndex] = -1;
+	}
+}
+
+//  =========================================================================================
+TimerHandle TimingWheel::CreateTimer()
+{
+	int timerIndex = -1;
+
+	//reuse a free entry before growing
+	if (m_freeTimerIndices.size() > 0)
+	{
+		timerIndex = m_freeTimerIndices.back();
+		m_freeTimerIndices.pop_back();
+		m_timers[timerIndex] = TimingWheelTimer();
+	}
+	else
+	{
+		timerIndex = (int)m_timers.size();
+		m_timers.push_back(TimingWheelTimer());
+	}
+
+	m_timers[timerIndex].m_isAllocated = true;
+	return timerIndex;
+}
+
+//  =========================================================================================
+void TimingWheel::DestroyTimer(TimerHandle& handle)
+{
+	if (handle == INVALID_TIMER_HANDLE)
+		return;
+
+	UnlinkTimer(handle);
+	m_timers[handle].m_isAllocated = false;
+	m_freeTimerIndices.push_back(handle);
+
+	handle = INVALID_TIMER_HANDLE;
+}
+
+//  =========================================================================================
+void TimingWheel::StartTimer(TimerHandle handle, float seconds, bool isRepeating)
+{
+	ASSERT_OR_DIE(m_timers[handle].m_isAllocated, "STARTING TIMER THAT WAS NEVER CREATED");
+
+	UnlinkTimer(handle);
+
+	TimingWheelTimer& timer = m_timers[handle];
+	uint64_t durationTicks = ConvertSecondsToTicks(seconds);
+
+	timer.m_startTick = m_currentTick;
+	timer.m_expirationTick = m_currentTick + durationTicks;
+	timer.m_intervalTicks = isRepeating ? durationTicks : 0;
+	timer.m_expiredCount = 0;
+
+	LinkTimer(handle);
+}
+
+//  =========================================================================================
+void TimingWheel::StopTimer(TimerHandle handle)
+{
+	UnlinkTimer(handle);
+	m_timers[handle].m_expiredCount = 0;
+}
+
+//  =========================================================================================
+int TimingWheel::ConsumeExpirations(TimerHandle handle)
+{
+	int expiredCount = m_timers[handle].m_expiredCount;
+	m_timers[handle].m_expiredCount = 0;
+
+	return expiredCount;
+}
+
+//  =========================================================================================
+float TimingWheel::GetNormalizedElapsedTime(TimerHandle handle)
+{
+	TimingWheelTimer& timer = m_timers[handle];
+	if (timer.m_expiredCount > 0 || timer.m_expirationTick <= timer.m_startTick)
+		return 1.f;
+
+	return (float)(m_currentTick - timer.m_startTick) / (float)(timer.m_expirationTick - timer.m_startTick);
+}
+
+//  =========================================================================================
+void TimingWheel::Advance(float deltaSeconds)
+{
+	PROFILER_PUSH();
+
+	m_unprocessedSeconds += deltaSeconds;
+
+	while (m_unprocessedSeconds >= TIMING_WHEEL_TICK_SECONDS)
+	{
+		m_unprocessedSeconds -= TIMING_WHEEL_TICK_SECONDS;
+		++m_currentTick;
+
+		//level 0 wrapped. pull the next span of level 1 down before expiring
+		int levelZeroSlot = (int)(m_currentTick & TIMING_WHEEL_SLOT_MASK);
+		if (levelZeroSlot == 0)
+		{
+			int levelOneSlot = (int)((m_currentTick >> TIMING_WHEEL_SLOT_BITS) & TIMING_WHEEL_SLOT_MASK);
+			CascadeSlot(TIMING_WHEEL_SLOTS_PER_LEVEL + levelOneSlot);
+		}
+
+		ExpireSlot(levelZeroSlot);
+	}
+}
+
+//  =========================================================================================
+uint64_t TimingWheel::ConvertSecondsToTicks(float seconds)
+{
+	//guard against rates of zero (infinite timers) so the float to int conversion stays defined
+	float maxSeconds = 60.f * 60.f * 24.f;
+	if (!(seconds < maxSeconds))
+		seconds = maxSeconds;
+
+	uint64_t ticks = (uint64_t)((seconds / TIMING_WHEEL_TICK_SECONDS) + 0.5f);
+
+	//always wait at least one tick so a timer can't expire on the frame it starts
+	return ticks > 0 ? ticks : 1;
+}
+
+//  =========================================================================================
+void TimingWheel::LinkTimer(int timerIndex)
+{
+	TimingWheelTimer& timer = m_timers[timerIndex];
+	uint64_t ticksUntilExpiration = timer.m_expirationTick - m_currentTick;
+
+	int slotIndex = 0;
+	if (ticksUntilExpiration < TIMING_WHEEL_SLOTS_PER_LEVEL)
+	{
+		slotIndex = (int)(timer.m_expirationTick & TIMING_WHEEL_SLOT_MASK);
+	}
+	else
+	{
+		//anything past the end of level 1 sits in the furthest span and is relinked when it cascades
+		uint64_t maxLevelOneTicks = (uint64_t)(TIMING_WHEEL_SLOTS_PER_LEVEL - 1) << TIMING_WHEEL_SLOT_BITS;
+		uint64_t linkTick = ticksUntilExpiration < maxLevelOneTicks ? timer.m_expirationTick : m_currentTick + maxLevelOneTicks;
+
+		slotIndex = TIMING_WHEEL_SLOTS_PER_LEVEL + (int)((linkTick >> TIMING_WHEEL_SLOT_BITS) & TIMING_WHEEL_SLOT_MASK);
+	}
+
+	timer.m_slotIndex = slotIndex;
+	timer.m_previous = -1;
+	timer.m_next = m_slotHeads[slotIndex];
+
+	if (m_slotHeads[slotIndex] != -1)
+		m_timers[m_slotHeads[slotIndex]].m_previous = timerIndex;
+
+	m_slotHeads[slotIndex] = timerIndex;
+}
+
+//  =========================================================================================
+void TimingWheel::UnlinkTimer(int timerIndex)
+{
+	TimingWheelTimer& timer = m_timers[timerIndex];
+	if (timer.m_slotIndex == -1)
+		return;
+
+	if (timer.m_previous != -1)
+		m_timers[timer.m_previous].m_next = timer.m_next;
+	else
+		m_slotHeads[timer.m_slotIndex] = timer.m_next;
+
+	if (timer.m_next != -1)
+		m_timers[timer.m_next].m_previous = timer.m_previous;
+
+	timer.m_slotIndex = -1;
+	timer.m_previous = -1;
+	timer.m_next = -1;
+}
+
+//  =========================================================================================
+void TimingWheel::CascadeSlot(int slotIndex)
+{
+	//detach the whole list first so relinking can't land back in the slot we're walking
+	int timerIndex = m_slotHeads[slotIndex];
+	m_slotHeads[slotIndex] = -1;
+
+	while (timerIndex != -1)
+	{
+		int nextIndex = m_timers[timerIndex].m_next;
+
+		m_timers[timerIndex].m_slotIndex = -1;
+		LinkTimer(timerIndex);
+
+		timerIndex = nextIndex;
+	}
+}
+
+//  =========================================================================================
+void TimingWheel::ExpireSlot(int slotIndex)
+{
+	int timerIndex = m_slotHeads[slotIndex];
+	m_slotHeads[slotIndex] = -1;
+
+	while (timerIndex != -1)
+	{
+		TimingWheelTimer& timer = m_timers[timerIndex];
+		int nextIndex = timer.m_next;
+		timer.m_slotIndex = -1;
+
+		if (timer.m_expirationTick <= m_currentTick)
+		{
+			++timer.m_expiredCount;
+
+			//repeating timers go straight back in for their next interval
+			if (timer.m_intervalTicks > 0)
+			{
+				timer.m_startTick = m_currentTick;
+				timer.m_expirationTick = m_currentTick + timer.m_intervalTicks;
+				LinkTimer(timerIndex);
+			}
+		}
+		else
+		{
+			//not this lap around the wheel
+			LinkTimer(timerIndex);
+		}
+
+		timerIndex = nextIndex;
+	}
+}
+
+//  =========================================================================================
+void TimingWheel::WriteSnapshot(SnapshotWriter& writer)
+{
+	writer.WriteVector(m_timers);
+	writer.WriteVector(m_freeTimerIndices);
+	writer.WriteBytes(m_slotHeads, sizeof(m_slotHeads));
+	writer.Write(m_currentTick);
+	writer.Write(m_unprocessedSeconds);
+}
+
+//  =========================================================================================
+void TimingWheel::ReadSnapshot(SnapshotReader& reader)
+{
+	reader.ReadVector(m_timers);
+	reader.ReadVector(m_freeTimerIndices);
+	reader.ReadBytes(m_slotHeads, sizeof(m_slotHeads));
+	reader.Read(m_currentTick);
+	reader.Read(m_unprocessedSeconds);
+}
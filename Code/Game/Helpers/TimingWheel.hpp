@@ -0,0 +1,70 @@
+#pragma once
+#include "Engine\Core\EngineCommon.hpp"
+#include <vector>
+
+class SnapshotWriter;
+class SnapshotReader;
+
+typedef int TimerHandle;
+constexpr TimerHandle INVALID_TIMER_HANDLE = -1;
+
+//level 0 holds the next 256 ticks. level 1 holds 256 spans of 256 ticks and cascades down as level 0 wraps
+constexpr int TIMING_WHEEL_SLOT_BITS = 8;
+constexpr int TIMING_WHEEL_SLOTS_PER_LEVEL = 1 << TIMING_WHEEL_SLOT_BITS;
+constexpr int TIMING_WHEEL_SLOT_MASK = TIMING_WHEEL_SLOTS_PER_LEVEL - 1;
+constexpr int TIMING_WHEEL_NUM_SLOTS = TIMING_WHEEL_SLOTS_PER_LEVEL * 2;
+constexpr float TIMING_WHEEL_TICK_SECONDS = 1.f / 120.f;
+
+struct TimingWheelTimer
+{
+	uint64_t m_startTick = 0;
+	uint64_t m_expirationTick = 0;
+	uint64_t m_intervalTicks = 0;	//0 for one shot timers
+
+	int m_expiredCount = 0;		//set by the wheel, consumed by the owner
+	bool m_isAllocated = false;
+
+	//intrusive slot list
+	int m_slotIndex = -1;
+	int m_previous = -1;
+	int m_next = -1;
+};
+
+//  ----------------------------------------------
+class TimingWheel
+{
+public:
+	TimingWheel();
+
+	TimerHandle CreateTimer();
+	void DestroyTimer(TimerHandle& handle);
+
+	void StartTimer(TimerHandle handle, float seconds, bool isRepeating);
+	void StopTimer(TimerHandle handle);
+
+	inline bool HasElapsed(TimerHandle handle) { return m_timers[handle].m_expiredCount > 0; }
+	int ConsumeExpirations(TimerHandle handle);
+	float GetNormalizedElapsedTime(TimerHandle handle);
+
+	//only the slots we tick through are touched so cost is O(expirations) not O(timers)
+	void Advance(float deltaSeconds);
+
+	//handles are indices so restoring the whole wheel keeps every saved handle valid
+	void WriteSnapshot(SnapshotWriter& writer);
+	void ReadSnapshot(SnapshotReader& reader);
+
+private:
+	uint64_t ConvertSecondsToTicks(float seconds);
+	void LinkTimer(int timerIndex);
+	void UnlinkTimer(int timerIndex);
+	void CascadeSlot(int slotIndex);
+	void ExpireSlot(int slotIndex);
+
+private:
+	std::vector<TimingWheelTimer> m_timers;
+	std::vector<int> m_freeTimerIndices;
+	int m_slotHeads[TIMING_WHEEL_NUM_SLOTS];
+
+	uint64_t m_currentTick = 0;
+	float m_unprocessedSeconds = 0.f;
+};
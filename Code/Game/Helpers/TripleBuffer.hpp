@@ -0,0 +1,85 @@
+#pragma once
+#include <atomic>
+
+//  ----------------------------------------------
+/*
+lock free triple buffer between one producer thread and one consumer thread. the producer always has a slot to
+write, the consumer always has a slot to read and the third slot is handed across with one atomic swap, so neither
+side ever waits on the other. the consumer sees the newest finished slot and skips any it missed.
+T needs a Clear() for Reset
+*/
+template <typename T>
+class TripleBuffer
+{
+public:
+	TripleBuffer();
+
+	//producer side
+	T& GetWriteSlot() { return m_slots[m_writeIndex]; }
+	void PublishWriteSlot();
+
+	//consumer side. returns the newest published slot (the previous one again when nothing new was published)
+	T& AcquireReadSlot();
+	bool HasNewSlot() const { return (m_sharedState.load(std::memory_order_acquire) & NEW_SLOT_FLAG) != 0; }
+
+	//neither side may be using the buffer
+	void Reset();
+
+private:
+	static constexpr int NUM_SLOTS = 3;
+	static constexpr int SLOT_INDEX_MASK = 0x3;
+	static constexpr int NEW_SLOT_FLAG = 0x4;
+
+	T m_slots[NUM_SLOTS];
+
+	//only touched by their own side
+	int m_writeIndex = 0;
+	int m_readIndex = 1;
+
+	//index of the slot in the middle plus NEW_SLOT_FLAG when the producer has put a slot there the consumer hasn't taken
+	std::atomic<int> m_sharedState;
+};
+
+//  =========================================================================================
+template <typename T>
+TripleBuffer<T>::TripleBuffer()
+{
+	m_sharedState.store(2, std::memory_order_relaxed);
+}
+
+//  =========================================================================================
+template <typename T>
+void TripleBuffer<T>::PublishWriteSlot()
+{
+	//hand the finished slot over and take back whatever was in the middle
+	int previousState = m_sharedState.exchange(m_writeIndex | NEW_SLOT_FLAG, std::memory_order_acq_rel);
+	m_writeIndex = previousState & SLOT_INDEX_MASK;
+}
+
+//  =========================================================================================
+template <typename T>
+T& TripleBuffer<T>::AcquireReadSlot()
+{
+	if (!HasNewSlot())
+		return m_slots[m_readIndex];
+
+	//swap our slot into the middle and take the newest one
+	int previousState = m_sharedState.exchange(m_readIndex, std::memory_order_acq_rel);
+	m_readIndex = previousState & SLOT_INDEX_MASK;
+
+	return m_slots[m_readIndex];
+}
+
+//  =========================================================================================
+template <typename T>
+void TripleBuffer<T>::Reset()
+{
+	for (int slotIndex = 0; slotIndex < NUM_SLOTS; ++slotIndex)
+	{
+		m_slots[slotIndex].Clear();
+	}
+
+	m_writeIndex = 0;
+	m_readIndex = 1;
+	m_sharedState.store(2, std::memory_order_release);
+}
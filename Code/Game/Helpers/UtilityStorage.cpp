@@ -1,4 +1,6 @@
 #include "Game\Helpers\UtilityStorage.hpp"
+#include "Game\Helpers\SimulationSnapshot.hpp"
+#include "Engine\Math\MathUtils.hpp"
 
 //  =============================================================================
 UtilityStorage::UtilityStorage(const float min, const float max, uint divisions)
@@ -67,3 +69,30 @@ void UtilityStorage::ResetData()
 		m_storage[storageIndex] = FLT_MAX;
 	}
 }
+
+//  =============================================================================
+float UtilityStorage::GetInputForIndex(int index)
+{
+	//aim for the middle of the division so float error can't floor us into the previous index
+	float input = m_min + (((float)index + 0.5f) * ((m_max - m_min) / (float)(m_divisions - 1)));
+	return Clamp(input, m_min, m_max);
+}
+
+//  =============================================================================
+void UtilityStorage::WriteSnapshot(SnapshotWriter& writer)
+{
+	writer.WriteVector(m_storage);
+}
+
+//  =============================================================================
+void UtilityStorage::ReadSnapshot(SnapshotReader& reader)
+{
+	std::vector<float> storage;
+	reader.ReadVector(storage);
+
+	//a table from a different division count can't be indexed the same way
+	if (storage.size() == m_storage.size())
+		m_storage = storage;
+	else
+		ResetData();
+}
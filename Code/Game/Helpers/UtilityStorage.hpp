@@ -2,6 +2,9 @@
 #include "Engine\Core\EngineCommon.hpp"
 #include <vector>
 
+class SnapshotWriter;
+class SnapshotReader;
+
 class UtilityStorage
 {
 public:
@@ -11,6 +14,15 @@ public:
 	void StoreValueForInputAtIndex(const float calculatedValue, int index);
 	void ResetData();
 
+	//warming helpers
+	inline int GetNumDivisions() { return (int)m_divisions; }
+	inline bool IsValueStoredAtIndex(int index) { return m_storage[index] != FLT_MAX; }
+	float GetInputForIndex(int index);
+
+	//memoized values are part of a warmed up sim
+	void WriteSnapshot(SnapshotWriter& writer);
+	void ReadSnapshot(SnapshotReader& reader);
+
 private:
 	int CalculateIndexForInput(const float input);
 	
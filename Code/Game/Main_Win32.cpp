@@ -8,6 +8,7 @@
 #include "Game\Game.hpp"
 #include "Game\GameCommon.hpp"
 #include "Game\EngineBuildPreferences.hpp"
+#include "Game\Helpers\SweepRunner.hpp"
 
 #include "Engine\Window\Window.hpp"
 #include "Engine\Core\EngineCommon.hpp"
@@ -163,8 +164,10 @@ void Shutdown()
 //-----------------------------------------------------------------------------------------------
 int WINAPI WinMain( HINSTANCE applicationInstanceHandle, HINSTANCE, LPSTR commandLineString, int )
  {
-	UNUSED( commandLineString );
 	UNUSED(applicationInstanceHandle);
+
+	//sweep workers are launched with their slice of the sweep on the command line
+	ParseSweepWorkerCommandLine(commandLineString);
 	Initialize();
 
 	// Program main loop; keep running frames until it's time to quit
@@ -13,18 +13,34 @@
 #include "Game\Entities\Fire.hpp"
 #include "Game\GameStates\PlayingState.hpp"
 #include "Game\SimulationData.hpp"
-#include "Game\Helpers\AnalysisData.hpp"
+#include "Game\Helpers\AnalysisScope.hpp"
+#include "Game\Helpers\SimulationPolicies.hpp"
+#include "Game\Helpers\SimulationSnapshot.hpp"
+#include "Game\Helpers\MapArtifactCache.hpp"
+#include "Game\Definitions\PlanDefinition.hpp"
 #include "Engine\Window\Window.hpp"
+#include "Engine\Core\StringUtils.hpp"
 #include "Engine\Time\Stopwatch.hpp"
 #include "Engine\Math\MathUtils.hpp"
 #include "Engine\Profiler\Profiler.hpp"
 #include "Engine\Renderer\MeshBuilder.hpp"
 #include "Engine\Renderer\Mesh.hpp"
 #include "Engine\Time\SimpleTimer.hpp"
+#include "Engine\Time\Time.hpp"
+#include "Engine\Utility\AStar.hpp"
 #include "Engine\Math\MathUtils.hpp"
+#include <math.h>
+#include <stdio.h>
+#include <algorithm>
 
 int g_fireIdMarker = 0;
 
+//slack tasks
+template <typename SimulationPolicy>
+eSlackTaskResult PrefetchAgentPathSlackTask(Map* map, int& inOutCursor, uint64_t deadlineHPC);
+eSlackTaskResult WarmUtilityStorageSlackTask(Map* map, int& inOutCursor, uint64_t deadlineHPC);
+eSlackTaskResult UpdateFireAccessPositionSlackTask(Map* map, int& inOutCursor, uint64_t deadlineHPC);
+
 //  =========================================================================================
 Map::Map(SimulationDefinition* simulationDefinition, const std::string & mapName, RenderScene2D* renderScene)
 {
@@ -32,38 +48,23 @@ Map::Map(SimulationDefinition* simulationDefinition, const std::string & mapName
 	m_mapDefinition = simulationDefinition->m_mapDefinition;
 	m_activeSimulationDefinition = simulationDefinition;
 
-	int numTilesX = GetRandomIntInRange(m_mapDefinition->m_width.min, m_mapDefinition->m_width.max);
-	int numTilesY = GetRandomIntInRange(m_mapDefinition->m_height.min, m_mapDefinition->m_height.max);
+	SeedRandomStreams();
+	BeginReplay();
+
+	RandomStream& mapGenerationStream = GetRandomStream(MAP_GENERATION_RANDOM_STREAM);
+	int numTilesX = mapGenerationStream.GetNextIntInRange(m_mapDefinition->m_width.min, m_mapDefinition->m_width.max);
+	int numTilesY = mapGenerationStream.GetNextIntInRange(m_mapDefinition->m_height.min, m_mapDefinition->m_height.max);
 
 	m_dimensions = IntVector2(numTilesX, numTilesY);
 
-	for (int yCoordinate = 0; yCoordinate < numTilesY; yCoordinate++)
+	//the same definition and seed always produce the same layout so generation only has to happen once
+	uint64_t artifactKey = GetTileArtifactKey();
+	if (!m_mapDefinition->m_isCached || !LoadTileArtifact(artifactKey))
 	{
-		for (int xCoordinate = 0; xCoordinate < numTilesX; xCoordinate++)
-		{		
-			Tile* newTile = new Tile();
-
-			newTile->m_tileCoords = IntVector2(xCoordinate, yCoordinate);
-			newTile->m_tileDefinition = TileDefinition::s_tileDefinitions[m_mapDefinition->m_defaultTile->m_name];
-
-			newTile->Initialize();
+		GenerateTiles();
 
-			m_tiles.push_back(newTile);
-			newTile = nullptr;
-		}
-	}
-
-	for (int genStepsIndex = 0; genStepsIndex < (int)m_mapDefinition->m_genSteps.size(); genStepsIndex++)
-	{
-		int iterations = GetRandomIntInRange(m_mapDefinition->m_iterations.min, m_mapDefinition->m_iterations.max);
-		float chanceToRun = GetRandomFloatZeroToOne();
-		if (chanceToRun <= m_mapDefinition->m_chanceToRun)
-		{
-			for (int iterationIndex = 0; iterationIndex < iterations; iterationIndex++)
-			{
-				m_mapDefinition->m_genSteps[genStepsIndex]->Run(*this);
-			}
-		}
+		if (m_mapDefinition->m_isCached)
+			SaveTileArtifact(artifactKey);
 	}
 
 	m_mapWorldBounds = AABB2(0.f, 0.f, m_dimensions.x * g_tileSize, m_dimensions.y * g_tileSize);
@@ -72,20 +73,18 @@ Map::Map(SimulationDefinition* simulationDefinition, const std::string & mapName
 //  =========================================================================================
 Map::~Map()
 {
+	//the worker reads the snapshot buffer so it has to go first
+	m_renderVertexWorker.Stop();
+
 	//cleanup reference pointers
 	m_mapDefinition = nullptr;
 	m_activeSimulationDefinition = nullptr;
 	m_playingState = nullptr;
 
 	//cleanuip timers
-	delete(m_sortTimer);
-	m_sortTimer = nullptr;
-
-	delete(m_threatTimer);
-	m_threatTimer = nullptr;	
-
-	delete(m_bombardmentTimer);
-	m_bombardmentTimer = nullptr;	
+	m_timingWheel.DestroyTimer(m_sortTimer);
+	m_timingWheel.DestroyTimer(m_threatTimer);
+	m_timingWheel.DestroyTimer(m_bombardmentTimer);	
 	
 	//delete grid
 	delete(m_mapAsGrid);
@@ -98,19 +97,20 @@ Map::~Map()
 	delete(m_debugBuilder);
 	m_debugBuilder = nullptr;
 
-	delete(m_agentBuilder);
-	m_agentBuilder = nullptr;
-
 	//delete mesh
-	delete(m_mapMesh);
-	m_mapMesh = nullptr;
-
-	delete(m_debugMapMesh);
-	m_debugMapMesh = nullptr;
+	DeleteMapChunkMeshes();
 
 	delete(m_agentMesh);
 	m_agentMesh = nullptr;
 
+	delete(m_bombardmentMesh);
+	m_bombardmentMesh = nullptr;
+
+	delete(m_fireMesh);
+	m_fireMesh = nullptr;
+
+	m_textMesh.Destroy();
+
 	//cleanup bombardments
 	for (int bombardmentIndex = 0; bombardmentIndex < (int)m_activeBombardments.size(); ++bombardmentIndex)
 	{
@@ -178,14 +178,6 @@ Map::~Map()
 		m_agentsOrderedByPriority[agentIndex] = nullptr;
 	}
 	m_agentsOrderedByPriority.clear();
-
-	//tiles
-	for (int tileIndex = 0; tileIndex < (int)m_tiles.size(); ++tileIndex)
-	{
-		delete(m_tiles[tileIndex]);
-		m_tiles[tileIndex] = nullptr;
-	}
-	m_tiles.clear();
 }
 
 //  =========================================================================================
@@ -251,15 +243,8 @@ void Map::Initialize()
 	//create agents
 	for (int agentIndex = 0; agentIndex < m_activeSimulationDefinition->m_numAgents; ++agentIndex)
 	{
-		IsoSpriteAnimSet* animSet = nullptr;
-		std::map<std::string, IsoSpriteAnimSetDefinition*>::iterator spriteDefIterator = IsoSpriteAnimSetDefinition::s_isoSpriteAnimSetDefinitions.find("agent");
-		if (spriteDefIterator != IsoSpriteAnimSetDefinition::s_isoSpriteAnimSetDefinitions.end())
-		{
-			animSet = new IsoSpriteAnimSet(spriteDefIterator->second);
-		}
-
 		Vector2 randomStartingLocation = GetRandomNonBlockedPositionInMapBounds();
-		Agent* agent = new Agent(randomStartingLocation, animSet, this);
+		Agent* agent = CreateAgent(randomStartingLocation);
 		m_agentsOrderedByXPosition.push_back(agent);
 		m_agentsOrderedByYPosition.push_back(agent);
 		m_agentsOrderedByPriority.push_back(agent);
@@ -267,7 +252,6 @@ void Map::Initialize()
 		agent->m_indexInSortedXList = agentIndex;
 		agent->m_indexInSortedYList = agentIndex;
 
-		animSet = nullptr;
 		agent = nullptr;
 	}
 
@@ -275,27 +259,33 @@ void Map::Initialize()
 	m_threat = m_activeSimulationDefinition->m_startingThreat;
 
 	//setup timeres
-	m_bombardmentTimer = new Stopwatch(GetGameClock());
-	m_bombardmentTimer->SetTimer(1.f / m_activeSimulationDefinition->m_bombardmentRatePerSecond);
+	m_bombardmentTimer = m_timingWheel.CreateTimer();
+	m_timingWheel.StartTimer(m_bombardmentTimer, 1.f / m_activeSimulationDefinition->m_bombardmentRatePerSecond, true);
 
-	m_threatTimer = new Stopwatch(GetGameClock());
-	m_threatTimer->SetTimer(1.f / m_activeSimulationDefinition->m_threatRatePerSecond);
+	m_threatTimer = m_timingWheel.CreateTimer();
+	m_timingWheel.StartTimer(m_threatTimer, 1.f / m_activeSimulationDefinition->m_threatRatePerSecond, true);
 
 	//sort agents for the first time
-	m_sortTimer = new Stopwatch(g_sortTimerInSeconds, GetGameClock());
+	m_sortTimer = m_timingWheel.CreateTimer();
+	m_timingWheel.StartTimer(m_sortTimer, g_sortTimerInSeconds, true);
 
 	SortAgentsByX();
 	SortAgentsByY();
 
+	SelectAgentUpdateFunction();
+	SelectSlackTasks();
+
 	m_mapBuilder = new MeshBuilder();
 	m_debugBuilder = new MeshBuilder();
-	m_agentBuilder = new MeshBuilder();
 
-	CreateMapMesh();
+	UpdateMapMeshes();
 	m_agentMesh = new Mesh();
-	CreateDynamicAgentMesh();
+	PublishRenderSnapshot();
 	InitializeMapGrid();
 	UpdateMapGrid();
+
+	//poi never move so paths between them only need to be found once
+	InitializePointOfInterestPathDistances();
 }
 
 //  =========================================================================================
@@ -306,8 +296,26 @@ void Map::Update(float deltaSeconds)
 	if(m_isMapGridDirty)
 		UpdateMapGrid();
 
-	//udpate timers
-	if (m_threatTimer->DecrementAll() > 0)
+	//take this frame's external inputs from the log when replaying
+	if (m_replayLog.IsPlayingBack())
+	{
+		if (!m_replayLog.ReadNextFrame(m_currentReplayFrame))
+			return;
+
+		deltaSeconds = m_currentReplayFrame.m_deltaSeconds;
+	}
+	else
+	{
+		m_currentReplayFrame = ReplayFrame();
+		m_currentReplayFrame.m_deltaSeconds = deltaSeconds;
+	}
+
+	m_simulationDeltaSeconds = deltaSeconds;
+
+	//udpate timers. expired timers only flag themselves so owners check them for free
+	m_timingWheel.Advance(deltaSeconds);
+
+	if (m_timingWheel.ConsumeExpirations(m_threatTimer) > 0)
 	{
 		if (m_threat != g_maxThreat)
 		{
@@ -322,9 +330,9 @@ void Map::Update(float deltaSeconds)
 	nonAgentUpdateTimer.Start();
 
 	// Update bombardments
-	if (m_bombardmentTimer->DecrementAll() > 0)
+	if (m_timingWheel.ConsumeExpirations(m_bombardmentTimer) > 0)
 	{
-		Bombardment* bombardment = new Bombardment(GetWorldPositionOfMapCoordinate(GetRandomCoordinateInMapBounds()));
+		Bombardment* bombardment = new Bombardment(GetWorldPositionOfMapCoordinate(GetRandomCoordinateInMapBounds()), &m_timingWheel);
 		m_activeBombardments.push_back(bombardment);
 	}
 
@@ -335,6 +343,11 @@ void Map::Update(float deltaSeconds)
 
 	nonAgentUpdateTimer.Stop();
 	g_previousFrameNonAgentUpdateTime = nonAgentUpdateTimer.GetRunningTime();
+
+	if (m_replayLog.IsRecording())
+		m_replayLog.RecordFrame(m_currentReplayFrame);
+
+	PublishRenderSnapshot();
 }
 
 //  =============================================================================
@@ -343,35 +356,45 @@ void Map::UpdateAgents(float deltaSeconds)
 	//update agents
 	PROFILER_PUSH();
 
-	if (!GetIsAgentUpdateBudgeted())
-	{
-		g_agentsUpdatedThisFrame = 0;
+	//the budgeted/optimized variant was chosen when the simulation was loaded
+	(this->*m_agentUpdateFunction)(deltaSeconds);
 
-		for (int agentIndex = 0; agentIndex < (int)m_agentsOrderedByXPosition.size(); ++agentIndex)
-		{
-			++g_agentsUpdatedThisFrame;
-			m_agentsOrderedByXPosition[agentIndex]->Update(deltaSeconds);
-			DetectAgentToTileCollision(m_agentsOrderedByXPosition[agentIndex]);
-		}
+	//full and quick updates both advance animation by the whole frame so do it for everyone at once
+	UpdateAgentAnimations(deltaSeconds);
+}
+
+//  =============================================================================
+void Map::UpdateAgentAnimations(float deltaSeconds)
+{
+	PROFILER_PUSH();
+
+	for (int agentIndex = 0; agentIndex < (int)m_agentsOrderedByXPosition.size(); ++agentIndex)
+	{
+		Agent* agent = m_agentsOrderedByXPosition[agentIndex];
+		agent->m_animationSet->Update(agent->m_animationState, deltaSeconds);
 	}
-	else
+}
+
+//  =============================================================================
+template <typename SimulationPolicy>
+void Map::UpdateAgentsUnbudgeted(float deltaSeconds)
+{
+	g_agentsUpdatedThisFrame = 0;
+
+	for (int agentIndex = 0; agentIndex < (int)m_agentsOrderedByXPosition.size(); ++agentIndex)
 	{
-		UpdateAgentsBudgeted(deltaSeconds);
+		++g_agentsUpdatedThisFrame;
+		m_agentsOrderedByXPosition[agentIndex]->Update<SimulationPolicy>(deltaSeconds);
 	}
 
-	//check optimization flags
+	ResolveAgentToTileCollisions(m_agentsOrderedByXPosition);
+
 	//sort for Y drawing for render AND for next frame's agent update
-	if (GetIsOptimized())
-	{		
-		if (m_sortTimer->CheckAndReset())
-		{
-			SortAgentsByX();
-			SortAgentsByY();
-		}		
-	}
+	SimulationPolicy::PathingPolicy::UpdateSortedAgentLists(this);
 }
 
 //  =============================================================================
+template <typename SimulationPolicy>
 void Map::UpdateAgentsBudgeted(float deltaSeconds)
 {
 	PROFILER_PUSH();
@@ -379,7 +402,11 @@ void Map::UpdateAgentsBudgeted(float deltaSeconds)
 	g_agentsUpdatedThisFrame = 0;
 	
 	//if this is the first frame, there is no point in sorting because we have no criteria to decide on
-	if (g_previousFrameNonAgentUpdateTime != 0)
+	bool isPlayingBack = m_replayLog.IsPlayingBack();
+	if (!isPlayingBack)
+		m_currentReplayFrame.m_didSortByPriority = g_previousFrameNonAgentUpdateTime != 0;
+
+	if (m_currentReplayFrame.m_didSortByPriority)
 	{
 		std::sort(m_agentsOrderedByPriority.begin(), m_agentsOrderedByPriority.end(), AgentSort);
 	}	
@@ -398,7 +425,7 @@ void Map::UpdateAgentsBudgeted(float deltaSeconds)
 	previousRemainingBudget = 0;
 
 	bool didBlowBudget = false;
-	bool canUpdate = true;
+	bool canUpdate = isPlayingBack ? m_currentReplayFrame.m_numFullAgentUpdates > 0 : true;
 	for (int agentIndex = 0; agentIndex < (int)m_agentsOrderedByPriority.size(); ++agentIndex)
 	{
 		//if there is still budget left for update, continue..
@@ -407,8 +434,7 @@ void Map::UpdateAgentsBudgeted(float deltaSeconds)
 			callTimer.Start();
 
 			//do udpate work
-			m_agentsOrderedByPriority[agentIndex]->Update(deltaSeconds);
-			//DetectAgentToTileCollision(m_agentsOrderedByPriority[agentIndex]);
+			m_agentsOrderedByPriority[agentIndex]->Update<SimulationPolicy>(deltaSeconds);
 
 			callTimer.Stop();
 			uint64_t totalUpdateTime = callTimer.GetRunningTime();
@@ -425,6 +451,10 @@ void Map::UpdateAgentsBudgeted(float deltaSeconds)
 			previousRemainingBudget = remainingAgentUpdateBudget;
 
 			g_agentsUpdatedThisFrame++;
+
+			//the recorded count replaces the clock so the same agents get full updates
+			if (isPlayingBack)
+				canUpdate = g_agentsUpdatedThisFrame < m_currentReplayFrame.m_numFullAgentUpdates;
 		}	
 		else //we are out of budgets
 		{
@@ -434,22 +464,172 @@ void Map::UpdateAgentsBudgeted(float deltaSeconds)
 			m_agentsOrderedByPriority[agentIndex]->QuickUpdate(deltaSeconds);
 			didBlowBudget = true;
 		}		
-
-		DetectAgentToTileCollision(m_agentsOrderedByPriority[agentIndex]);
 	}
 
+	ResolveAgentToTileCollisions(m_agentsOrderedByPriority);
+
+	m_currentReplayFrame.m_numFullAgentUpdates = g_agentsUpdatedThisFrame;
+
+	//spend whatever is left of the budget on maintenance work instead of throwing it away
+	if (canUpdate && remainingAgentUpdateBudget > 0)
+		m_slackTaskQueue.RunUntil(this, GetPerformanceCounter() + (uint64_t)remainingAgentUpdateBudget);
+
 	if(!didBlowBudget)
 		callTimer.Start();
 
 	//sort if we are optimized
+	SimulationPolicy::PathingPolicy::UpdateSortedAgentLists(this);
+}
+
+//  =============================================================================
+void Map::SelectAgentUpdateFunction()
+{
 	if (GetIsOptimized())
-	{		
-		if (m_sortTimer->CheckAndReset())
-		{
-			SortAgentsByX();
-			SortAgentsByY();
-		}		
+	{
+		if (GetIsAgentUpdateBudgeted())
+			m_agentUpdateFunction = &Map::UpdateAgentsBudgeted<OptimizedSimulationPolicy>;
+		else
+			m_agentUpdateFunction = &Map::UpdateAgentsUnbudgeted<OptimizedSimulationPolicy>;
+
+		m_agentPathFunction = &Agent::GetPathToDestination<OptimizedSimulationPolicy::PathingPolicy>;
+	}
+	else
+	{
+		if (GetIsAgentUpdateBudgeted())
+			m_agentUpdateFunction = &Map::UpdateAgentsBudgeted<UnoptimizedSimulationPolicy>;
+		else
+			m_agentUpdateFunction = &Map::UpdateAgentsUnbudgeted<UnoptimizedSimulationPolicy>;
+
+		m_agentPathFunction = &Agent::GetPathToDestination<UnoptimizedSimulationPolicy::PathingPolicy>;
+	}
+}
+
+//  =============================================================================
+void Map::SelectSlackTasks()
+{
+	m_slackTaskQueue.Clear();
+
+	//slack work depends on how much time is left over, which a replay can't reproduce
+	if (IsDeterministic())
+		return;
+
+	if (GetIsOptimized())
+	{
+		m_slackTaskQueue.AddTask(&PrefetchAgentPathSlackTask<OptimizedSimulationPolicy>);
+		m_slackTaskQueue.AddTask(&WarmUtilityStorageSlackTask);
+	}
+	else
+	{
+		//no memoization to warm when unoptimized
+		m_slackTaskQueue.AddTask(&PrefetchAgentPathSlackTask<UnoptimizedSimulationPolicy>);
+	}
+
+	m_slackTaskQueue.AddTask(&UpdateFireAccessPositionSlackTask);
+}
+
+//  =============================================================================
+void Map::SeedRandomStreams()
+{
+	m_randomSeed = m_activeSimulationDefinition->m_randomSeed;
+
+	for (int streamIndex = 0; streamIndex < NUM_RANDOM_STREAMS; ++streamIndex)
+	{
+		m_randomStreams[streamIndex].Reseed((uint64_t)m_randomSeed, (uint64_t)streamIndex);
+	}
+}
+
+//  =============================================================================
+void Map::BeginReplay()
+{
+	m_replayLog.Stop();
+
+	if (!IsStringNullOrEmpty(m_activeSimulationDefinition->m_replayFilePath))
+	{
+		m_replayLog.BeginPlayback(m_activeSimulationDefinition->m_replayFilePath, m_randomSeed);
+	}
+	else if (m_activeSimulationDefinition->m_isDeterministic)
+	{
+		m_replayLog.BeginRecording(m_randomSeed);
+	}
+}
+
+//  =============================================================================
+bool Map::IsDeterministic()
+{
+	return m_activeSimulationDefinition->m_isDeterministic;
+}
+
+//  =========================================================================================
+//  Slack tasks
+//  =========================================================================================
+template <typename SimulationPolicy>
+eSlackTaskResult PrefetchAgentPathSlackTask(Map* map, int& inOutCursor, uint64_t deadlineHPC)
+{
+	//one path per call. the queue already checked the deadline before calling
+	UNUSED(deadlineHPC);
+
+	if (inOutCursor >= (int)map->m_agentsOrderedByPriority.size())
+		return PASS_COMPLETE_SLACK_TASK_RESULT;
+
+	map->m_agentsOrderedByPriority[inOutCursor]->m_planner->PrefetchLikelyNextPath<SimulationPolicy>();
+	++inOutCursor;
+
+	return WORKING_SLACK_TASK_RESULT;
+}
+
+//  =========================================================================================
+eSlackTaskResult WarmUtilityStorageSlackTask(Map* map, int& inOutCursor, uint64_t deadlineHPC)
+{
+	//the shared storage is made with the first planner
+	if (map->m_agentsOrderedByPriority.size() == 0)
+		return PASS_COMPLETE_SLACK_TASK_RESULT;
+
+	//cursor walks every division of every memoized curve (distance through shoot)
+	int numDivisions = Planner::m_distanceUtilityStorage->GetNumDivisions();
+	int numEntries = numDivisions * (SHOOT_UTILITY_CURVE + 1);
+
+	//skip a bounded number of already stored entries per call so a warm table can't eat the whole slack
+	for (int checkCount = 0; checkCount < 64 && inOutCursor < numEntries; ++checkCount)
+	{
+		if (GetPerformanceCounter() >= deadlineHPC)
+			return WORKING_SLACK_TASK_RESULT;
+
+		eUtilityCurveType curveType = (eUtilityCurveType)(inOutCursor / numDivisions);
+		int divisionIndex = inOutCursor % numDivisions;
+		++inOutCursor;
+
+		UtilityStorage* storage = Planner::GetUtilityStorageForCurve(curveType);
+		if (storage->IsValueStoredAtIndex(divisionIndex))
+			continue;
+
+		//stored directly. the memoized Calculate functions would count this as a memoization call and time it
+		storage->StoreValueForInputAtIndex(Planner::CalculateRawCurveUtility(curveType, storage->GetInputForIndex(divisionIndex)), divisionIndex);
+		return WORKING_SLACK_TASK_RESULT;
+	}
+
+	if (inOutCursor >= numEntries)
+		return PASS_COMPLETE_SLACK_TASK_RESULT;
+
+	return WORKING_SLACK_TASK_RESULT;
+}
+
+//  =========================================================================================
+eSlackTaskResult UpdateFireAccessPositionSlackTask(Map* map, int& inOutCursor, uint64_t deadlineHPC)
+{
+	//skip fires that are already up to date with the grid
+	while (inOutCursor < (int)map->m_fires.size())
+	{
+		if (GetPerformanceCounter() >= deadlineHPC)
+			return WORKING_SLACK_TASK_RESULT;
+
+		Fire* fire = map->m_fires[inOutCursor];
+		++inOutCursor;
+
+		if (fire->UpdateAccessPosition())
+			return WORKING_SLACK_TASK_RESULT;
 	}
+
+	return PASS_COMPLETE_SLACK_TASK_RESULT;
 }
 
 //  =========================================================================================
@@ -462,54 +642,67 @@ void Map::Render()
 
 	Renderer* theRenderer = Renderer::GetInstance();
 
+	//started on first render so headless runs don't build vertices nobody draws
+	if (!m_renderVertexWorker.IsRunning())
+		m_renderVertexWorker.Start(&m_renderSnapshots);
+
+	//everything dynamic below was built by the worker from a finished tick. only the upload happens here
+	bool isNewVertexFrame = m_renderVertexWorker.HasNewFrame();
+	m_renderVertexFrame = &m_renderVertexWorker.AcquireFrame();
+	if (isNewVertexFrame)
+		UploadDynamicMeshes();
+
+	const RenderVertexFrame& vertexFrame = *m_renderVertexFrame;
+
 	//render tile mesh
+	UpdateMapMeshes();
 	theRenderer->SetTexture(*theRenderer->CreateOrGetTexture("Data/Images/Terrain_8x8.png"));
 	theRenderer->SetShader(theRenderer->m_defaultShader);
-	theRenderer->DrawMesh(m_mapMesh);
+	for (int chunkIndex = 0; chunkIndex < (int)m_mapChunkMeshes.size(); ++chunkIndex)
+	{
+		theRenderer->DrawMesh(m_mapChunkMeshes[chunkIndex]);
+	}
 
 	//render tile block data
 	if (g_isBlockedTileDataShown)
 	{
+		UpdateDebugMapMeshes();
 		theRenderer->BindMaterial(theRenderer->CreateOrGetMaterial("text"));
-		theRenderer->DrawMesh(m_debugMapMesh);
+		for (int chunkIndex = 0; chunkIndex < (int)m_debugMapChunkMeshes.size(); ++chunkIndex)
+		{
+			theRenderer->DrawMesh(m_debugMapChunkMeshes[chunkIndex]);
+		}
 	}
 
-	//create and render agent mesh
-	CreateDynamicAgentMesh();
-	theRenderer->SetTexture(*theRenderer->CreateOrGetTexture(m_agentsOrderedByXPosition[0]->m_animationSet->GetCurrentSprite(m_agentsOrderedByXPosition[0]->m_spriteDirection)->m_definition->m_diffuseSource));
-	theRenderer->SetShader(theRenderer->CreateOrGetShader("agents"));
-	theRenderer->DrawMesh(m_agentMesh);
+	//render agent mesh
+	if (vertexFrame.m_visibleAgents.size() > 0)
+	{
+		theRenderer->SetTexture(*theRenderer->CreateOrGetTexture(vertexFrame.m_visibleAgents[0].m_sprite->m_definition->m_diffuseSource));
+		theRenderer->SetShader(theRenderer->CreateOrGetShader("agents"));
+		theRenderer->DrawMesh(m_agentMesh);
+	}
 
 	//create and render text
-	Mesh* textMesh = CreateTextMesh();	
-	if (textMesh != nullptr)
+	if (UpdateTextMesh())
 	{
 		theRenderer->BindMaterial(theRenderer->CreateOrGetMaterial("text"));
-		theRenderer->DrawMesh(textMesh);
+		theRenderer->DrawMesh(m_textMesh.m_mesh);
 	}	
 
-	//create and render bombardments
-	if (m_activeBombardments.size() > 0)
+	//render bombardments
+	if (vertexFrame.m_bombardmentBuilder.m_vertices.size() > 0)
 	{
-		Mesh* bombardmentMesh = CreateDynamicBombardmentMesh();
 		theRenderer->SetTexture(*theRenderer->CreateOrGetTexture("Data/Images/AirStrike.png"));
 		theRenderer->SetShader(theRenderer->CreateOrGetShader("agents"));
-		theRenderer->DrawMesh(bombardmentMesh);
-
-		delete(bombardmentMesh);
-		bombardmentMesh = nullptr;
+		theRenderer->DrawMesh(m_bombardmentMesh);
 	}
 
-	//create and render fires
-	if (m_fires.size() > 0)
+	//render fires
+	if (vertexFrame.m_fireBuilder.m_vertices.size() > 0)
 	{
-		Mesh* fireMesh = CreateDynamicFireMesh();
 		theRenderer->SetTexture(*theRenderer->CreateOrGetTexture("Data/Images/Fire.png"));
 		theRenderer->SetShader(theRenderer->CreateOrGetShader("agents"));
-		theRenderer->DrawMesh(fireMesh);
-
-		delete(fireMesh);
-		fireMesh = nullptr;
+		theRenderer->DrawMesh(m_fireMesh);
 	}
 
 	//set back to default
@@ -525,14 +718,9 @@ void Map::Reload(SimulationDefinition* definition)
 	m_playingState = nullptr;
 
 	//cleanuip timers
-	delete(m_sortTimer);
-	m_sortTimer = nullptr;
-
-	delete(m_threatTimer);
-	m_threatTimer = nullptr;	
-
-	delete(m_bombardmentTimer);
-	m_bombardmentTimer = nullptr;
+	m_timingWheel.DestroyTimer(m_sortTimer);
+	m_timingWheel.DestroyTimer(m_threatTimer);
+	m_timingWheel.DestroyTimer(m_bombardmentTimer);
 
 	//cleanup bombardments
 	for (int bombardmentIndex = 0; bombardmentIndex < (int)m_activeBombardments.size(); ++bombardmentIndex)
@@ -559,7 +747,6 @@ void Map::Reload(SimulationDefinition* definition)
 
 	for (int agentIndex = 0; agentIndex < (int)m_agentsOrderedByYPosition.size(); ++agentIndex)
 	{
-		delete(m_agentsOrderedByYPosition[agentIndex]);
 		m_agentsOrderedByYPosition[agentIndex] = nullptr;
 	}
 	m_agentsOrderedByYPosition.clear();
@@ -572,26 +759,21 @@ void Map::Reload(SimulationDefinition* definition)
 	m_agentsOrderedByPriority.clear();
 
 	// Reload step ----------------------------------------------
+	SeedRandomStreams();
+	BeginReplay();
 
 	//create agents
 	for (int agentIndex = 0; agentIndex < m_activeSimulationDefinition->m_numAgents; ++agentIndex)
 	{
-		IsoSpriteAnimSet* animSet = nullptr;
-		std::map<std::string, IsoSpriteAnimSetDefinition*>::iterator spriteDefIterator = IsoSpriteAnimSetDefinition::s_isoSpriteAnimSetDefinitions.find("agent");
-		if (spriteDefIterator != IsoSpriteAnimSetDefinition::s_isoSpriteAnimSetDefinitions.end())
-		{
-			animSet = new IsoSpriteAnimSet(spriteDefIterator->second);
-		}
-
 		Vector2 randomStartingLocation = GetRandomNonBlockedPositionInMapBounds();
-		Agent* agent = new Agent(randomStartingLocation, animSet, this);
+		Agent* agent = CreateAgent(randomStartingLocation);
 		m_agentsOrderedByXPosition.push_back(agent);
 		m_agentsOrderedByYPosition.push_back(agent);
+		m_agentsOrderedByPriority.push_back(agent);
 
 		agent->m_indexInSortedXList = agentIndex;
 		agent->m_indexInSortedYList = agentIndex;
 
-		animSet = nullptr;
 		agent = nullptr;
 	}
 
@@ -599,202 +781,583 @@ void Map::Reload(SimulationDefinition* definition)
 	m_threat = m_activeSimulationDefinition->m_startingThreat;
 
 	//setup timeres
-	m_bombardmentTimer = new Stopwatch(GetGameClock());
-	m_bombardmentTimer->SetTimer(1.f / m_activeSimulationDefinition->m_bombardmentRatePerSecond);
+	m_bombardmentTimer = m_timingWheel.CreateTimer();
+	m_timingWheel.StartTimer(m_bombardmentTimer, 1.f / m_activeSimulationDefinition->m_bombardmentRatePerSecond, true);
 
-	m_threatTimer = new Stopwatch(GetGameClock());
-	m_threatTimer->SetTimer(1.f / m_activeSimulationDefinition->m_threatRatePerSecond);
+	m_threatTimer = m_timingWheel.CreateTimer();
+	m_timingWheel.StartTimer(m_threatTimer, 1.f / m_activeSimulationDefinition->m_threatRatePerSecond, true);
 
 	//sort agents for the first time
-	m_sortTimer = new Stopwatch(g_sortTimerInSeconds, GetGameClock());
+	m_sortTimer = m_timingWheel.CreateTimer();
+	m_timingWheel.StartTimer(m_sortTimer, g_sortTimerInSeconds, true);
 
 	SortAgentsByX();
 	SortAgentsByY();	
 
+	SelectAgentUpdateFunction();
+	SelectSlackTasks();
+
 	m_mapBuilder = new MeshBuilder();
 	m_debugBuilder = new MeshBuilder();
-	m_agentBuilder = new MeshBuilder();
 
-	CreateMapMesh();
+	UpdateMapMeshes();
 	m_agentMesh = new Mesh();
-	CreateDynamicAgentMesh();
+	PublishRenderSnapshot();
 	InitializeMapGrid();
 	UpdateMapGrid();
 }
 
-//  =========================================================================================
-void Map::CreateMapMesh()
+//  =============================================================================
+Agent* Map::CreateAgent(const Vector2& position)
 {
-	PROFILER_PUSH();
-
-	m_mapBuilder->FlushBuilder();
-	
-	//create mesh for static tiles and buildings
-	for (int tileIndex = 0; tileIndex < (int)m_tiles.size(); ++tileIndex)
-	{
-		m_mapBuilder->CreateTexturedQuad2D(m_tiles[tileIndex]->GetBounds().GetCenter(), Vector2::ONE, m_tiles[tileIndex]->m_tileDefinition->m_baseSpriteUVCoords.mins, m_tiles[tileIndex]->m_tileDefinition->m_baseSpriteUVCoords.maxs, m_tiles[tileIndex]->m_tint );
-	}
-
-	m_mapMesh = m_mapBuilder->CreateMesh<VertexPCU>();
+	//every agent plays from the same shared set
+	if (m_agentAnimationSet == nullptr)
+		m_agentAnimationSet = IsoSpriteAnimSet::CreateOrGetAnimSet("agent");
 
-	CreateDebugMapMesh();
+	return new Agent(position, m_agentAnimationSet, this);
 }
 
 //  =========================================================================================
-void Map::CreateDebugMapMesh()
+//  Snapshots
+//  =========================================================================================
+bool Map::SaveSnapshot(const std::string& filePath)
 {
 	PROFILER_PUSH();
 
-	if (m_debugMapMesh != nullptr)
-	{
-		delete(m_debugMapMesh);
-		m_debugMapMesh = nullptr;
-	}
-
-	m_debugBuilder->FlushBuilder();
-
-	//create debug mesh to show blocking states
-	for (int tileIndex = 0; tileIndex < (int)m_tiles.size(); ++tileIndex)
-	{
-		int value = m_tiles[tileIndex]->m_tileDefinition->m_allowsWalking == true ? 0 : 1;
-		std::string doesBlock = Stringf("%i", value);
-
-		m_debugBuilder->CreateText2DInAABB2(m_tiles[tileIndex]->GetBounds().GetCenter(), Vector2::ONE, 1.f, doesBlock, m_tiles[tileIndex]->m_tint );
-	}
+	SnapshotWriter writer;
+	WriteSnapshot(writer);
 
-	m_debugMapMesh = m_debugBuilder->CreateMesh<VertexPCU>();
+	return writer.WriteToFile(filePath);
 }
 
-//  =========================================================================================
-void Map::CreateDynamicAgentMesh()
+//  =============================================================================
+bool Map::LoadSnapshot(const std::string& filePath)
 {
 	PROFILER_PUSH();
 
-	m_agentBuilder->FlushBuilder();
-
-	//create mesh for static tiles and buildings
-	for (int agentIndex = 0; agentIndex < (int)m_agentsOrderedByYPosition.size(); ++agentIndex)
-	{
-		Sprite sprite = *m_agentsOrderedByXPosition[agentIndex]->m_animationSet->GetCurrentSprite(m_agentsOrderedByXPosition[agentIndex]->m_spriteDirection);
-
-		Rgba agentColor = Rgba::WHITE;
-		switch (m_agentsOrderedByXPosition[agentIndex]->m_planner->m_currentPlan.m_chosenPlanType)
-		{
-		case GATHER_ARROWS_PLAN_TYPE:
-			agentColor = GATHER_ARROWS_TINT;
-			break;
-		case GATHER_LUMBER_PLAN_TYPE:
-			agentColor = GATHER_LUMBER_TINT;
-			break;
-		case GATHER_BANDAGES_PLAN_TYPE:
-			agentColor = GATHER_BANDAGES_TINT;
-			break;
-		case GATHER_WATER_PLAN_TYPE:
-			agentColor = GATHER_WATER_TINT;
-			break;
-		case SHOOT_PLAN_TYPE:
-			agentColor = SHOOT_TINT;
-			break;
-		case REPAIR_PLAN_TYPE:
-			agentColor = REPAIR_TINT;
-			break;
-		case HEAL_PLAN_TYPE:
-			agentColor = HEAL_TINT;
-			break;
-		case FIGHT_FIRE_PLAN_TYPE:
-			agentColor = PUT_OUT_FIRE_TINT;
-			break;
-		}
-
-		//AABB2 bounds = m_agentsOrderedByXPosition[agentIndex]->m_spriteRenderBounds;
-		Vector2 agentSize = Vector2::ONE;
-
-		if (g_isDebugDataShown)
-		{
-			if(m_agentsOrderedByXPosition[agentIndex] == m_playingState->m_disectedAgent)
-				agentSize = Vector2(1.75f, 1.75f);
-		}	
-
-		m_agentBuilder->CreateTexturedQuad2D(m_agentsOrderedByXPosition[agentIndex]->m_position,
-			agentSize,
-			Vector2(sprite.GetNormalizedUV().mins.x, sprite.GetNormalizedUV().maxs.y),
-			Vector2(sprite.GetNormalizedUV().maxs.x, sprite.GetNormalizedUV().mins.y),
-			agentColor);
-	}
+	SnapshotReader reader;
+	if (!reader.ReadFromFile(filePath))
+		return false;
 
-	m_agentBuilder->UpdateMesh<VertexPCU>(m_agentMesh);
+	return ReadSnapshot(reader);
 }
 
-
 //  =============================================================================
-Mesh* Map::CreateTextMesh()
+void Map::WriteSnapshot(SnapshotWriter& writer)
 {
-	PROFILER_PUSH();
+	// header ----------------------------------------------
+	writer.Write(SIMULATION_SNAPSHOT_MAGIC);
+	writer.Write(SIMULATION_SNAPSHOT_VERSION);
+	writer.Write(m_randomSeed);
+	writer.Write(m_dimensions);
+	writer.Write((uint32_t)m_agentsOrderedByPriority.size());
+	writer.Write((uint32_t)m_pointsOfInterest.size());
 
-	MeshBuilder builder = MeshBuilder();
-	Mesh* textMesh = nullptr;
+	// tiles ----------------------------------------------
+	//definitions are saved by name so reordering the xml doesn't break old snapshots
+	std::vector<TileDefinition*> tileDefinitions;
+	writer.Write((uint32_t)TileDefinition::s_tileDefinitions.size());
+	for (std::map<std::string, TileDefinition*>::iterator definitionIterator = TileDefinition::s_tileDefinitions.begin(); definitionIterator != TileDefinition::s_tileDefinitions.end(); ++definitionIterator)
+	{
+		writer.WriteString(definitionIterator->first);
+		tileDefinitions.push_back(definitionIterator->second);
+	}
 
-	//agent ids
-	if (g_isIdShown)
+	for (int tileIndex = 0; tileIndex < GetNumTiles(); ++tileIndex)
 	{
-		for (int agentIndex = 0; agentIndex < (int)m_agentsOrderedByYPosition.size(); ++agentIndex)
-		{
-			builder.CreateText2DInAABB2(Vector2(m_agentsOrderedByXPosition[agentIndex]->m_position.x, m_agentsOrderedByXPosition[agentIndex]->m_position.y + 0.7), Vector2(0.25f, 0.25f), 1.f, Stringf("%i", m_agentsOrderedByXPosition[agentIndex]->m_id), Rgba::WHITE);
-		}
+		const Tile& tile = GetTileAtIndex(tileIndex);
+		uint16_t definitionIndex = (uint16_t)(std::find(tileDefinitions.begin(), tileDefinitions.end(), tile.GetDefinition()) - tileDefinitions.begin());
+		writer.Write(definitionIndex);
+		writer.Write(GetTileTint(tile));
 	}
 
-	//  ----------------------------------------------
-	//draw other things
-	//  ----------------------------------------------
+	// map state ----------------------------------------------
+	writer.Write(m_threat);
+	writer.Write(m_bombardmentTimer);
+	writer.Write(m_threatTimer);
+	writer.Write(m_sortTimer);
+	writer.Write(m_randomStreams);
+	writer.Write(Fire::GetNextFireId());
+
+	// agents ----------------------------------------------
+	for (int agentIndex = 0; agentIndex < (int)m_agentsOrderedByPriority.size(); ++agentIndex)
+	{
+		m_agentsOrderedByPriority[agentIndex]->WriteSnapshot(writer);
+	}
 
-	if (builder.m_vertices.size() > 0)
+	for (int agentIndex = 0; agentIndex < (int)m_agentsOrderedByXPosition.size(); ++agentIndex)
 	{
-		textMesh = builder.CreateMesh<VertexPCU>();
-	}	
+		writer.Write(m_agentsOrderedByXPosition[agentIndex]->m_id);
+	}
 
-	return textMesh;
-}
+	for (int agentIndex = 0; agentIndex < (int)m_agentsOrderedByYPosition.size(); ++agentIndex)
+	{
+		writer.Write(m_agentsOrderedByYPosition[agentIndex]->m_id);
+	}
 
-//  =========================================================================================
-Mesh* Map::CreateDynamicBombardmentMesh()
-{
-	PROFILER_PUSH();
+	// entities ----------------------------------------------
+	for (int poiIndex = 0; poiIndex < (int)m_pointsOfInterest.size(); ++poiIndex)
+	{
+		m_pointsOfInterest[poiIndex]->WriteSnapshot(writer);
+	}
 
-	MeshBuilder builder;
+	writer.Write((uint32_t)m_fires.size());
+	for (int fireIndex = 0; fireIndex < (int)m_fires.size(); ++fireIndex)
+	{
+		writer.Write(m_fires[fireIndex]->m_coordinate);
+		m_fires[fireIndex]->WriteSnapshot(writer);
+	}
 
+	writer.Write((uint32_t)m_activeBombardments.size());
 	for (int bombardmentIndex = 0; bombardmentIndex < (int)m_activeBombardments.size(); ++bombardmentIndex)
-	{	
-		AABB2 bombardmentBox = AABB2(m_activeBombardments[bombardmentIndex]->m_disc.center, m_activeBombardments[bombardmentIndex]->m_disc.radius, m_activeBombardments[bombardmentIndex]->m_disc.radius);
-		builder.CreateTexturedQuad2D(m_activeBombardments[bombardmentIndex]->m_disc.center, bombardmentBox.GetDimensions(), Vector2::ZERO, Vector2::ONE, Rgba(1.f, 1.f, 1.f, .5f));
+	{
+		m_activeBombardments[bombardmentIndex]->WriteSnapshot(writer);
 	}
 
-	Mesh* bombardmentMesh = builder.CreateMesh<VertexPCU>();
+	Planner::WriteUtilityStorageSnapshot(writer);
 
-	return bombardmentMesh;
+	//last so restoring it replaces any timers the entity constructors made on the way in
+	m_timingWheel.WriteSnapshot(writer);
 }
 
-//  =========================================================================================
-Mesh* Map::CreateDynamicFireMesh()
+//  =============================================================================
+bool Map::ReadSnapshot(SnapshotReader& reader)
 {
-	PROFILER_PUSH();
+	// header ----------------------------------------------
+	uint32_t magic = reader.Read<uint32_t>();
+	uint32_t version = reader.Read<uint32_t>();
+	int seed = reader.Read<int>();
+	IntVector2 dimensions = reader.Read<IntVector2>();
+	uint32_t numAgents = reader.Read<uint32_t>();
+	uint32_t numPointsOfInterest = reader.Read<uint32_t>();
+
+	//poi and tiles come from the seed so a snapshot only fits the map it was taken on
+	if (!reader.IsValid() || magic != SIMULATION_SNAPSHOT_MAGIC || version != SIMULATION_SNAPSHOT_VERSION)
+		return false;
 
-	MeshBuilder builder;;
+	if (seed != m_randomSeed || dimensions.x != m_dimensions.x || dimensions.y != m_dimensions.y || numPointsOfInterest != (uint32_t)m_pointsOfInterest.size())
+		return false;
 
-	for (int fireIndex = 0; fireIndex < (int)m_fires.size(); ++fireIndex)
-	{	
-		Vector2 fireCenter = Vector2(m_fires[fireIndex]->m_coordinate) + Vector2(0.5f, 0.6f);
-		AABB2 fireBox = AABB2(fireCenter, 0.5f, 0.5f);
-		builder.CreateTexturedQuad2D(fireBox.GetCenter(), fireBox.GetDimensions(), Vector2::ZERO, Vector2::ONE, Rgba(1.f, 1.f, 1.f, 0.7f));
+	// tiles ----------------------------------------------
+	std::vector<TileDefinition*> tileDefinitions;
+	uint32_t numTileDefinitions = reader.Read<uint32_t>();
+	for (uint32_t definitionIndex = 0; definitionIndex < numTileDefinitions && reader.IsValid(); ++definitionIndex)
+	{
+		std::map<std::string, TileDefinition*>::iterator definitionIterator = TileDefinition::s_tileDefinitions.find(reader.ReadString());
+		if (definitionIterator == TileDefinition::s_tileDefinitions.end())
+			return false;
+
+		tileDefinitions.push_back(definitionIterator->second);
 	}
 
-	Mesh* fireMesh = builder.CreateMesh<VertexPCU>();
+	//nothing has been touched yet so a bad tile table can still bail out cleanly
+	std::vector<uint16_t> tileDefinitionIndices;
+	std::vector<Rgba> tileTints;
+	tileDefinitionIndices.resize(GetNumTiles());
+	tileTints.resize(GetNumTiles());
 
-	//cleanup
-	return fireMesh;
-}
+	for (int tileIndex = 0; tileIndex < GetNumTiles(); ++tileIndex)
+	{
+		reader.Read(tileDefinitionIndices[tileIndex]);
+		reader.Read(tileTints[tileIndex]);
 
-//  =========================================================================================
-void Map::DeleteDeadEntities()
+		if (tileDefinitionIndices[tileIndex] >= (uint16_t)tileDefinitions.size())
+			return false;
+	}
+
+	if (!reader.IsValid())
+		return false;
+
+	//the map is changed from here on. agents own timers and ids on the live map so they can't be read into temporaries,
+	//which means any failure past this point can only die rather than hand back a half restored map
+	for (int tileIndex = 0; tileIndex < GetNumTiles(); ++tileIndex)
+	{
+		SetTileAtCoordinate(GetTileCoordinateOfIndex(tileIndex), tileDefinitions[tileDefinitionIndices[tileIndex]], tileTints[tileIndex]);
+	}
+
+	// map state ----------------------------------------------
+	reader.Read(m_threat);
+	reader.Read(m_bombardmentTimer);
+	reader.Read(m_threatTimer);
+	reader.Read(m_sortTimer);
+	reader.Read(m_randomStreams);
+	int nextFireId = reader.Read<int>();
+
+	// agents ----------------------------------------------
+	//everything is rebuilt from the file. timers the old entities free here belong to the wheel we are about to replace
+	for (int agentIndex = 0; agentIndex < (int)m_agentsOrderedByPriority.size(); ++agentIndex)
+	{
+		delete(m_agentsOrderedByPriority[agentIndex]);
+		m_agentsOrderedByPriority[agentIndex] = nullptr;
+	}
+	m_agentsOrderedByPriority.clear();
+	m_agentsOrderedByXPosition.clear();
+	m_agentsOrderedByYPosition.clear();
+
+	std::vector<Agent*> agentsById;
+	agentsById.resize(numAgents, nullptr);
+
+	for (uint32_t agentIndex = 0; agentIndex < numAgents; ++agentIndex)
+	{
+		Agent* agent = CreateAgent(Vector2::ZERO);
+		m_agentsOrderedByPriority.push_back(agent);
+
+		//actions are stored by index so an unknown one means the file doesn't match this build
+		bool didReadAgent = agent->ReadSnapshot(reader);
+		ASSERT_OR_DIE(didReadAgent, "SNAPSHOT HAS AN UNKNOWN ACTION");
+
+		ASSERT_OR_DIE(agent->m_id >= 0 && agent->m_id < (int)numAgents, "SNAPSHOT AGENT ID OUT OF RANGE");
+		agentsById[agent->m_id] = agent;
+	}
+
+	for (uint32_t agentIndex = 0; agentIndex < numAgents; ++agentIndex)
+	{
+		m_agentsOrderedByXPosition.push_back(agentsById[ClampInt(reader.Read<int>(), 0, (int)numAgents - 1)]);
+	}
+
+	for (uint32_t agentIndex = 0; agentIndex < numAgents; ++agentIndex)
+	{
+		m_agentsOrderedByYPosition.push_back(agentsById[ClampInt(reader.Read<int>(), 0, (int)numAgents - 1)]);
+	}
+
+	// entities ----------------------------------------------
+	for (int poiIndex = 0; poiIndex < (int)m_pointsOfInterest.size(); ++poiIndex)
+	{
+		m_pointsOfInterest[poiIndex]->ReadSnapshot(reader);
+	}
+
+	for (int fireIndex = 0; fireIndex < (int)m_fires.size(); ++fireIndex)
+	{
+		delete(m_fires[fireIndex]);
+		m_fires[fireIndex] = nullptr;
+	}
+	m_fires.clear();
+
+	uint32_t numFires = reader.Read<uint32_t>();
+	for (uint32_t fireIndex = 0; fireIndex < numFires && reader.IsValid(); ++fireIndex)
+	{
+		Fire* fire = new Fire(reader.Read<IntVector2>(), this);
+		fire->ReadSnapshot(reader);
+		m_fires.push_back(fire);
+	}
+
+	//making the fires above moved the id on. put it back to where the saved sim was
+	Fire::SetNextFireId(nextFireId);
+
+	for (int bombardmentIndex = 0; bombardmentIndex < (int)m_activeBombardments.size(); ++bombardmentIndex)
+	{
+		delete(m_activeBombardments[bombardmentIndex]);
+		m_activeBombardments[bombardmentIndex] = nullptr;
+	}
+	m_activeBombardments.clear();
+
+	uint32_t numBombardments = reader.Read<uint32_t>();
+	for (uint32_t bombardmentIndex = 0; bombardmentIndex < numBombardments && reader.IsValid(); ++bombardmentIndex)
+	{
+		Bombardment* bombardment = new Bombardment(Vector2::ZERO, &m_timingWheel);
+		bombardment->ReadSnapshot(reader);
+		m_activeBombardments.push_back(bombardment);
+	}
+
+	Planner::ReadUtilityStorageSnapshot(reader);
+	m_timingWheel.ReadSnapshot(reader);
+
+	//past the header a short file leaves entities half restored
+	ASSERT_OR_DIE(reader.IsValid(), "SNAPSHOT IS TRUNCATED");
+
+	// derived data ----------------------------------------------
+	//fires change tiles in both directions so every grid value is rewritten
+	for (int chunkIndex = 0; chunkIndex < (int)m_tileChunks.size(); ++chunkIndex)
+	{
+		WriteTileChunkToGrid(chunkIndex, *m_mapAsGrid, false);
+	}
+	m_isMapGridDirty = false;
+	++m_mapGridVersion;
+
+	//restored tiles flagged their chunks dirty
+	UpdateMapMeshes();
+	PublishRenderSnapshot();
+
+	m_slackTaskQueue.ResetCursors();
+
+	return true;
+}
+
+//  =========================================================================================
+void Map::PublishRenderSnapshot()
+{
+	PROFILER_PUSH();
+
+	RenderSnapshot& snapshot = m_renderSnapshots.GetWriteSlot();
+	snapshot.Clear();
+	snapshot.m_tick = ++m_renderSnapshotTick;
+
+	//y list order so the consumer draws back to front
+	snapshot.m_agents.resize(m_agentsOrderedByYPosition.size());
+	for (int agentIndex = 0; agentIndex < (int)m_agentsOrderedByYPosition.size(); ++agentIndex)
+	{
+		const Agent* agent = m_agentsOrderedByYPosition[agentIndex];
+		AgentRenderState& agentState = snapshot.m_agents[agentIndex];
+
+		agentState.m_position = agent->m_position;
+		agentState.m_sprite = agent->m_animationSet->GetCurrentSprite(agent->m_animationState, agent->m_spriteDirection);
+
+		//flipped in y for the quad
+		const AABB2& spriteUVs = agentState.m_sprite->GetNormalizedUV();
+		agentState.m_uvMins = Vector2(spriteUVs.mins.x, spriteUVs.maxs.y);
+		agentState.m_uvMaxs = Vector2(spriteUVs.maxs.x, spriteUVs.mins.y);
+		agentState.m_id = agent->m_id;
+		agentState.m_planType = agent->m_planner->m_currentPlan.m_chosenPlanType;
+		agentState.m_size = 1.f;
+
+		if (g_isDebugDataShown && m_playingState != nullptr && agent == m_playingState->m_disectedAgent)
+			agentState.m_size = 1.75f;
+	}
+
+	for (int fireIndex = 0; fireIndex < (int)m_fires.size(); ++fireIndex)
+	{
+		snapshot.m_fireCenters.push_back(Vector2(m_fires[fireIndex]->m_coordinate) + Vector2(0.5f, 0.6f));
+	}
+
+	for (int bombardmentIndex = 0; bombardmentIndex < (int)m_activeBombardments.size(); ++bombardmentIndex)
+	{
+		snapshot.m_bombardmentDiscs.push_back(m_activeBombardments[bombardmentIndex]->m_disc);
+	}
+
+	m_renderSnapshots.PublishWriteSlot();
+}
+
+//  =========================================================================================
+void Map::SetViewBounds(const AABB2& viewBounds)
+{
+	//the worker rebuilds every frame for a new view so only hand over one that moved
+	if (m_isViewCulled && viewBounds.mins == m_viewBounds.mins && viewBounds.maxs == m_viewBounds.maxs)
+		return;
+
+	m_viewBounds = viewBounds;
+	m_isViewCulled = true;
+	m_renderVertexWorker.SetViewBounds(viewBounds);
+}
+
+//  =========================================================================================
+void Map::UpdateMapMeshes()
+{
+	PROFILER_PUSH();
+
+	//chunk layout changed (new tiles or a loaded artifact) so start over
+	if (m_mapChunkMeshes.size() != m_tileChunks.size())
+	{
+		DeleteMapChunkMeshes();
+		m_mapChunkMeshes.resize(m_tileChunks.size(), nullptr);
+		m_debugMapChunkMeshes.resize(m_tileChunks.size(), nullptr);
+	}
+
+	for (int chunkIndex = 0; chunkIndex < (int)m_tileChunks.size(); ++chunkIndex)
+	{
+		if (m_mapChunkMeshes[chunkIndex] == nullptr || m_tileChunks[chunkIndex].IsMeshDirty())
+			CreateMapChunkMesh(chunkIndex);
+	}
+}
+
+//  =========================================================================================
+void Map::UpdateDebugMapMeshes()
+{
+	PROFILER_PUSH();
+
+	//only chunks with changed tiles are rebuilt
+	for (int chunkIndex = 0; chunkIndex < (int)m_debugMapChunkMeshes.size(); ++chunkIndex)
+	{
+		if (m_debugMapChunkMeshes[chunkIndex] == nullptr || m_tileChunks[chunkIndex].IsDebugMeshDirty())
+			CreateDebugMapChunkMesh(chunkIndex);
+	}
+}
+
+//  =========================================================================================
+void Map::CreateMapChunkMesh(int chunkIndex)
+{
+	TileChunk& chunk = m_tileChunks[chunkIndex];
+
+	IntVector2 start;
+	IntVector2 end;
+	GetTileChunkBounds(chunkIndex, start, end);
+
+	m_mapBuilder->FlushBuilder();
+
+	//create mesh for static tiles and buildings
+	for (int yCoordinate = start.y; yCoordinate < end.y; ++yCoordinate)
+	{
+		for (int xCoordinate = start.x; xCoordinate < end.x; ++xCoordinate)
+		{
+			const Tile& tile = chunk.GetTile(TileChunk::GetLocalIndex(xCoordinate, yCoordinate));
+			const TileDefinition* definition = tile.GetDefinition();
+			Vector2 tileCenter = Vector2((float)xCoordinate + 0.5f, (float)yCoordinate + 0.5f);
+
+			m_mapBuilder->CreateTexturedQuad2D(tileCenter, Vector2::ONE, definition->m_baseSpriteUVCoords.mins, definition->m_baseSpriteUVCoords.maxs, GetTileTint(tile));
+		}
+	}
+
+	if (m_mapChunkMeshes[chunkIndex] == nullptr)
+		m_mapChunkMeshes[chunkIndex] = new Mesh();
+
+	m_mapBuilder->UpdateMesh<VertexPCU>(m_mapChunkMeshes[chunkIndex]);
+	chunk.SetMeshDirty(false);
+}
+
+//  =========================================================================================
+void Map::CreateDebugMapChunkMesh(int chunkIndex)
+{
+	//blocking state is one character so the glyph strings never need formatting
+	static const std::string s_walkableGlyph = "0";
+	static const std::string s_blockedGlyph = "1";
+
+	TileChunk& chunk = m_tileChunks[chunkIndex];
+
+	IntVector2 start;
+	IntVector2 end;
+	GetTileChunkBounds(chunkIndex, start, end);
+
+	m_debugBuilder->FlushBuilder();
+
+	//create debug mesh to show blocking states
+	for (int yCoordinate = start.y; yCoordinate < end.y; ++yCoordinate)
+	{
+		for (int xCoordinate = start.x; xCoordinate < end.x; ++xCoordinate)
+		{
+			const Tile& tile = chunk.GetTile(TileChunk::GetLocalIndex(xCoordinate, yCoordinate));
+			Vector2 tileCenter = Vector2((float)xCoordinate + 0.5f, (float)yCoordinate + 0.5f);
+
+			m_debugBuilder->CreateText2DInAABB2(tileCenter, Vector2::ONE, 1.f, tile.AllowsWalking() ? s_walkableGlyph : s_blockedGlyph, GetTileTint(tile));
+		}
+	}
+
+	if (m_debugMapChunkMeshes[chunkIndex] == nullptr)
+		m_debugMapChunkMeshes[chunkIndex] = new Mesh();
+
+	m_debugBuilder->UpdateMesh<VertexPCU>(m_debugMapChunkMeshes[chunkIndex]);
+	chunk.SetDebugMeshDirty(false);
+}
+
+//  =========================================================================================
+void Map::DeleteMapChunkMeshes()
+{
+	for (int chunkIndex = 0; chunkIndex < (int)m_mapChunkMeshes.size(); ++chunkIndex)
+	{
+		delete(m_mapChunkMeshes[chunkIndex]);
+		m_mapChunkMeshes[chunkIndex] = nullptr;
+	}
+
+	for (int chunkIndex = 0; chunkIndex < (int)m_debugMapChunkMeshes.size(); ++chunkIndex)
+	{
+		delete(m_debugMapChunkMeshes[chunkIndex]);
+		m_debugMapChunkMeshes[chunkIndex] = nullptr;
+	}
+
+	m_mapChunkMeshes.clear();
+	m_debugMapChunkMeshes.clear();
+}
+
+//  =========================================================================================
+void Map::UploadDynamicMeshes()
+{
+	PROFILER_PUSH();
+
+	RenderVertexFrame& vertexFrame = *m_renderVertexFrame;
+
+	if (vertexFrame.m_agentBuilder.m_vertices.size() > 0)
+		vertexFrame.m_agentBuilder.UpdateMesh<VertexPCU>(m_agentMesh);
+
+	if (vertexFrame.m_bombardmentBuilder.m_vertices.size() > 0)
+	{
+		if (m_bombardmentMesh == nullptr)
+			m_bombardmentMesh = new Mesh();
+
+		vertexFrame.m_bombardmentBuilder.UpdateMesh<VertexPCU>(m_bombardmentMesh);
+	}
+
+	if (vertexFrame.m_fireBuilder.m_vertices.size() > 0)
+	{
+		if (m_fireMesh == nullptr)
+			m_fireMesh = new Mesh();
+
+		vertexFrame.m_fireBuilder.UpdateMesh<VertexPCU>(m_fireMesh);
+	}
+
+	m_numAgentsCulled = vertexFrame.m_numAgentsCulled;
+	m_numFiresCulled = vertexFrame.m_numFiresCulled;
+	m_numBombardmentsCulled = vertexFrame.m_numBombardmentsCulled;
+}
+
+//  =============================================================================
+bool Map::UpdateTextMesh()
+{
+	PROFILER_PUSH();
+
+	m_textMesh.Begin();
+
+	//agent ids
+	if (g_isIdShown)
+	{
+		//ids are formatted on the stack. short enough for the builder's string to skip the heap too
+		char idText[16];
+
+		const std::vector<AgentRenderState>& visibleAgents = m_renderVertexFrame->m_visibleAgents;
+		for (int agentIndex = 0; agentIndex < (int)visibleAgents.size(); ++agentIndex)
+		{
+			snprintf(idText, sizeof(idText), "%i", visibleAgents[agentIndex].m_id);
+			m_textMesh.m_builder->CreateText2DInAABB2(Vector2(visibleAgents[agentIndex].m_position.x, visibleAgents[agentIndex].m_position.y + 0.7), Vector2(0.25f, 0.25f), 1.f, idText, Rgba::WHITE);
+		}
+	}
+
+	//  ----------------------------------------------
+	//draw other things
+	//  ----------------------------------------------
+
+	return m_textMesh.End();
+}
+
+//  =========================================================================================
+void PooledDynamicMesh::Begin()
+{
+	if (m_builder == nullptr)
+		m_builder = new MeshBuilder();
+
+	//keep room for the busiest frame seen so far in case the flush handed the storage back
+	m_builder->FlushBuilder();
+	m_builder->m_vertices.reserve(m_vertexHighWaterMark);
+}
+
+//  =========================================================================================
+bool PooledDynamicMesh::End()
+{
+	int numVertices = (int)m_builder->m_vertices.size();
+	if (numVertices == 0)
+		return false;
+
+	if (m_mesh == nullptr)
+		m_mesh = new Mesh();
+
+	m_builder->UpdateMesh<VertexPCU>(m_mesh);
+
+	if (numVertices > m_vertexHighWaterMark)
+		m_vertexHighWaterMark = numVertices;
+
+	return true;
+}
+
+//  =========================================================================================
+void PooledDynamicMesh::Destroy()
+{
+	delete(m_builder);
+	m_builder = nullptr;
+
+	delete(m_mesh);
+	m_mesh = nullptr;
+
+	m_vertexHighWaterMark = 0;
+}
+
+//  =========================================================================================
+void Map::DeleteDeadEntities()
 {
 	PROFILER_PUSH();
 
@@ -811,11 +1374,11 @@ void Map::DeleteDeadFires()
 	{
 		if (m_fires[fireIndex]->IsDead())
 		{
-			Tile* fireTile = GetTileAtWorldPosition(m_fires[fireIndex]->m_worldPosition);
+			IntVector2 fireCoordinate = GetTileCoordinateOfPosition(m_fires[fireIndex]->m_worldPosition);
 
-			ASSERT_OR_DIE(fireTile != nullptr, "FIRE TILE IS INVALID ON DELETION");
+			ASSERT_OR_DIE(CheckIsCoordinateValid(fireCoordinate), "FIRE TILE IS INVALID ON DELETION");
 
-			fireTile->m_tileDefinition = TileDefinition::s_tileDefinitions.find("Ground")->second;
+			SetTileAtCoordinate(fireCoordinate, TileDefinition::s_groundDefinition);
 			m_fires.erase(m_fires.begin() + fireIndex);
 			--fireIndex;
 		}			
@@ -837,14 +1400,15 @@ void Map::DeleteDeadBombardmentsAndRandomlyStartFire()
 			if (DoesBombardmentStartFire())
 			{
 				IntVector2 tileCoordinate = GetTileCoordinateOfPosition(m_activeBombardments[bombardmentIndex]->m_disc.center);
-				Tile* tile = GetTileAtCoordinate(tileCoordinate);
+				const Tile* tile = GetTileAtCoordinate(tileCoordinate);
 				
-				if (tile->m_tileDefinition->m_allowsWalking && tile->m_tileDefinition->m_allowsBuilding)
+				if (tile->AllowsWalking() && tile->AllowsBuilding())
 				{
-					SpawnFire(tile);
+					SpawnFire(tileCoordinate);
 				}				
 			}
 
+			delete(m_activeBombardments[bombardmentIndex]);
 			m_activeBombardments.erase(m_activeBombardments.begin() + bombardmentIndex);
 			--bombardmentIndex;
 		}
@@ -951,112 +1515,444 @@ void Map::SwapAgents(int indexI, int indexJ, eAgentSortType type)
 	case X_AGENT_SORT_TYPE:
 		tempAgent = m_agentsOrderedByXPosition[indexI];
 
-		//swap first
-		m_agentsOrderedByXPosition[indexI] = m_agentsOrderedByXPosition[indexJ];
-		m_agentsOrderedByXPosition[indexJ] = tempAgent;
+		//swap first
+		m_agentsOrderedByXPosition[indexI] = m_agentsOrderedByXPosition[indexJ];
+		m_agentsOrderedByXPosition[indexJ] = tempAgent;
+
+		//set new indexes
+		m_agentsOrderedByXPosition[indexI]->m_indexInSortedXList = indexI;
+		m_agentsOrderedByXPosition[indexJ]->m_indexInSortedXList = indexJ;
+		break;
+	case Y_AGENT_SORT_TYPE:
+		tempAgent = m_agentsOrderedByYPosition[indexI];
+
+		//swap first
+		m_agentsOrderedByYPosition[indexI] = m_agentsOrderedByYPosition[indexJ];
+		m_agentsOrderedByYPosition[indexJ] = tempAgent;
+
+		//set new indexes
+		m_agentsOrderedByYPosition[indexI]->m_indexInSortedYList = indexI;
+		m_agentsOrderedByYPosition[indexJ]->m_indexInSortedYList = indexJ;
+		break;
+	case PRIORITY_AGENT_SORT_TYPE:
+		tempAgent = m_agentsOrderedByPriority[indexI];
+
+		//swap first
+		m_agentsOrderedByPriority[indexI] = m_agentsOrderedByPriority[indexJ];
+		m_agentsOrderedByPriority[indexJ] = tempAgent;
+
+		//set new indexes
+		m_agentsOrderedByPriority[indexI]->m_indexInPriorityList = indexI;
+		m_agentsOrderedByPriority[indexJ]->m_indexInPriorityList = indexJ;
+		break;
+	}
+
+	tempAgent = nullptr;
+}
+
+//  =========================================================================================
+void Map::GetAsGrid(Grid<int>& outMapGrid)
+{
+	outMapGrid.InitializeGrid(0, m_dimensions.x, m_dimensions.y);
+
+	for (int chunkIndex = 0; chunkIndex < (int)m_tileChunks.size(); ++chunkIndex)
+	{
+		WriteTileChunkToGrid(chunkIndex, outMapGrid, true);
+	}
+}
+
+//  =========================================================================================
+void Map::InitializeMapGrid()
+{
+	m_mapAsGrid = new Grid<int>();
+	m_mapAsGrid->InitializeGrid(0, m_dimensions.x, m_dimensions.y);
+
+	//new grid so every chunk needs writing
+	for (int chunkIndex = 0; chunkIndex < (int)m_tileChunks.size(); ++chunkIndex)
+	{
+		m_tileChunks[chunkIndex].SetGridDirty(true);
+	}
+}
+
+//  =========================================================================================
+void Map::UpdateMapGrid()
+{
+	PROFILER_PUSH();
+
+	//only chunks whose walkability changed are rewritten
+	for (int chunkIndex = 0; chunkIndex < (int)m_tileChunks.size(); ++chunkIndex)
+	{
+		if (!m_tileChunks[chunkIndex].IsGridDirty())
+			continue;
+
+		WriteTileChunkToGrid(chunkIndex, *m_mapAsGrid, false);
+		m_tileChunks[chunkIndex].SetGridDirty(false);
+	}
+
+	m_isMapGridDirty = false;
+	++m_mapGridVersion;
+}
+
+//  =========================================================================================
+void Map::WriteTileChunkToGrid(int chunkIndex, Grid<int>& outMapGrid, bool isGridCleared)
+{
+	const TileChunk& chunk = m_tileChunks[chunkIndex];
+
+	//a cleared grid already says walkable
+	if (isGridCleared && chunk.IsAllWalkable())
+		return;
+
+	IntVector2 start;
+	IntVector2 end;
+	GetTileChunkBounds(chunkIndex, start, end);
+
+	//every tile of a uniform chunk is the fill tile so the value only has to be worked out once
+	if (chunk.IsUniform())
+	{
+		int fillValue = chunk.GetFillTile().AllowsWalking() ? 0 : 1;
+		for (int yCoordinate = start.y; yCoordinate < end.y; ++yCoordinate)
+		{
+			for (int xCoordinate = start.x; xCoordinate < end.x; ++xCoordinate)
+			{
+				outMapGrid.SetValueAtIndex(fillValue, xCoordinate + (yCoordinate * m_dimensions.x));
+			}
+		}
+
+		return;
+	}
+
+	for (int yCoordinate = start.y; yCoordinate < end.y; ++yCoordinate)
+	{
+		for (int xCoordinate = start.x; xCoordinate < end.x; ++xCoordinate)
+		{
+			int value = chunk.GetTile(TileChunk::GetLocalIndex(xCoordinate, yCoordinate)).AllowsWalking() ? 0 : 1;
+
+			if (!isGridCleared || value != 0)
+				outMapGrid.SetValueAtIndex(value, xCoordinate + (yCoordinate * m_dimensions.x));
+		}
+	}
+}
+
+//  =========================================================================================
+void Map::GetTileChunkBounds(int chunkIndex, IntVector2& outStart, IntVector2& outEnd) const
+{
+	//edge chunks are clipped to the map
+	outStart.x = (chunkIndex % m_numTileChunks.x) << TILE_CHUNK_SIZE_BITS;
+	outStart.y = (chunkIndex / m_numTileChunks.x) << TILE_CHUNK_SIZE_BITS;
+	outEnd.x = ClampInt(outStart.x + TILE_CHUNK_SIZE, 0, m_dimensions.x);
+	outEnd.y = ClampInt(outStart.y + TILE_CHUNK_SIZE, 0, m_dimensions.y);
+}
+
+//  =========================================================================================
+bool Map::IsTileBlockingAtCoordinate(const IntVector2& coordinate)
+{
+	bool isBlocking = !GetTileAtCoordinate(coordinate)->AllowsWalking();
+	return isBlocking;	
+}
+
+//  =========================================================================================
+bool Map::DoesTilePreventBuilding(const IntVector2& coordinate)
+{
+	bool doesAllowBuilding = !GetTileAtCoordinate(coordinate)->AllowsBuilding();
+	return doesAllowBuilding;	
+}
+
+//  =========================================================================================
+void Map::GenerateTiles()
+{
+	PROFILER_PUSH();
+
+	InitializeTiles(m_mapDefinition->m_defaultTile);
+
+	RandomStream& mapGenerationStream = GetRandomStream(MAP_GENERATION_RANDOM_STREAM);
+	for (int genStepsIndex = 0; genStepsIndex < (int)m_mapDefinition->m_genSteps.size(); genStepsIndex++)
+	{
+		int iterations = mapGenerationStream.GetNextIntInRange(m_mapDefinition->m_iterations.min, m_mapDefinition->m_iterations.max);
+		float chanceToRun = mapGenerationStream.GetNextFloatZeroToOne();
+		if (chanceToRun <= m_mapDefinition->m_chanceToRun)
+		{
+			for (int iterationIndex = 0; iterationIndex < iterations; iterationIndex++)
+			{
+				m_mapDefinition->m_genSteps[genStepsIndex]->Run(*this);
+			}
+		}
+	}
+}
+
+//  =========================================================================================
+uint64_t Map::GetTileArtifactKey() const
+{
+	uint32_t version = MAP_ARTIFACT_VERSION;
+	uint64_t key = HashArtifactBytes(&version, sizeof(version), MAP_ARTIFACT_HASH_OFFSET);
+	key = HashArtifactBytes(&m_mapDefinition->m_contentHash, sizeof(m_mapDefinition->m_contentHash), key);
+	key = HashArtifactBytes(&m_randomSeed, sizeof(m_randomSeed), key);
+
+	for (int genStepsIndex = 0; genStepsIndex < (int)m_mapDefinition->m_genSteps.size(); genStepsIndex++)
+	{
+		m_mapDefinition->m_genSteps[genStepsIndex]->AppendArtifactKey(key);
+	}
+
+	return key;
+}
+
+//  =========================================================================================
+bool Map::LoadTileArtifact(uint64_t key)
+{
+	PROFILER_PUSH();
+
+	//mapped rather than read so big layouts are paged in straight into the chunks
+	SnapshotReader reader;
+	if (!reader.MapFile(GetMapArtifactPath(key)))
+		return false;
+
+	if (reader.Read<uint32_t>() != MAP_ARTIFACT_MAGIC || reader.Read<uint32_t>() != MAP_ARTIFACT_VERSION || reader.Read<uint64_t>() != key)
+		return false;
+
+	IntVector2 dimensions = reader.Read<IntVector2>();
+	if (dimensions.x != m_dimensions.x || dimensions.y != m_dimensions.y)
+		return false;
+
+	//definitions were saved by name. when the table still lines up the records can be copied as is
+	uint32_t numDefinitions = reader.Read<uint32_t>();
+	std::vector<uint8_t> definitionRemap;
+	std::vector<uint8_t> definitionFlags;
+	bool doDefinitionsMatch = numDefinitions == (uint32_t)TileDefinition::s_tileDefinitionsByIndex.size();
+
+	for (uint32_t definitionIndex = 0; definitionIndex < numDefinitions; ++definitionIndex)
+	{
+		std::string definitionName = reader.ReadString();
+		uint8_t flags = reader.Read<uint8_t>();
+
+		std::map<std::string, TileDefinition*>::iterator definitionIterator = TileDefinition::s_tileDefinitions.find(definitionName);
+		if (definitionIterator == TileDefinition::s_tileDefinitions.end() || definitionIterator->second == nullptr)
+			return false;
+
+		TileDefinition* definition = definitionIterator->second;
+		definitionRemap.push_back(definition->m_index);
+		definitionFlags.push_back(flags);
+
+		if (definition->m_index != definitionIndex || Tile(definition, 0).m_flags != flags)
+			doDefinitionsMatch = false;
+	}
+
+	std::vector<Rgba> tileTints;
+	reader.ReadVector(tileTints);
+	if (tileTints.size() == 0 || tileTints.size() > 256)
+		return false;
+
+	uint32_t numChunks = reader.Read<uint32_t>();
+	if (!reader.IsValid() || numChunks != (uint32_t)(((m_dimensions.x + TILE_CHUNK_MASK) >> TILE_CHUNK_SIZE_BITS) * ((m_dimensions.y + TILE_CHUNK_MASK) >> TILE_CHUNK_SIZE_BITS)))
+		return false;
+
+	InitializeTiles(m_mapDefinition->m_defaultTile);
+	m_tileTints = tileTints;
+
+	std::vector<Tile> remappedTiles;
+	for (int chunkIndex = 0; chunkIndex < (int)m_tileChunks.size(); ++chunkIndex)
+	{
+		bool isUniform = reader.Read<uint8_t>() != 0;
+		int numTiles = isUniform ? 1 : TILES_PER_CHUNK;
+
+		const Tile* tiles = (const Tile*)reader.ReadInPlace(sizeof(Tile) * numTiles);
+		if (tiles == nullptr)
+			return false;
+
+		//records are copied as is on the fast path. a stale or damaged file that got past the key is a miss, not a crash
+		for (int tileIndex = 0; tileIndex < numTiles; ++tileIndex)
+		{
+			const Tile& tile = tiles[tileIndex];
+			if (tile.m_definitionIndex >= numDefinitions || (size_t)tile.m_tintIndex >= tileTints.size())
+				return false;
+
+			if (doDefinitionsMatch && tile.m_flags != definitionFlags[tile.m_definitionIndex])
+				return false;
+		}
+
+		if (!doDefinitionsMatch)
+		{
+			remappedTiles.resize(numTiles);
+			for (int tileIndex = 0; tileIndex < numTiles; ++tileIndex)
+			{
+				remappedTiles[tileIndex] = Tile(TileDefinition::s_tileDefinitionsByIndex[definitionRemap[tiles[tileIndex].m_definitionIndex]], tiles[tileIndex].m_tintIndex);
+			}
+			tiles = remappedTiles.data();
+		}
+
+		if (isUniform)
+			m_tileChunks[chunkIndex].Fill(tiles[0]);
+		else
+			m_tileChunks[chunkIndex].SetTiles(tiles);
+	}
+
+	m_isMapGridDirty = true;
+	return true;
+}
+
+//  =========================================================================================
+bool Map::SaveTileArtifact(uint64_t key)
+{
+	PROFILER_PUSH();
 
-		//set new indexes
-		m_agentsOrderedByXPosition[indexI]->m_indexInSortedXList = indexI;
-		m_agentsOrderedByXPosition[indexJ]->m_indexInSortedXList = indexJ;
-		break;
-	case Y_AGENT_SORT_TYPE:
-		tempAgent = m_agentsOrderedByYPosition[indexI];
+	//tags only steer later gen steps and aren't part of the artifact, so maps that use them are regenerated every time
+	if (m_tileTags.size() > 0)
+		return false;
 
-		//swap first
-		m_agentsOrderedByYPosition[indexI] = m_agentsOrderedByYPosition[indexJ];
-		m_agentsOrderedByYPosition[indexJ] = tempAgent;
+	SnapshotWriter writer;
+	writer.Write(MAP_ARTIFACT_MAGIC);
+	writer.Write(MAP_ARTIFACT_VERSION);
+	writer.Write(key);
+	writer.Write(m_dimensions);
 
-		//set new indexes
-		m_agentsOrderedByYPosition[indexI]->m_indexInSortedYList = indexI;
-		m_agentsOrderedByYPosition[indexJ]->m_indexInSortedYList = indexJ;
-		break;
-	case PRIORITY_AGENT_SORT_TYPE:
-		tempAgent = m_agentsOrderedByPriority[indexI];
+	writer.Write((uint32_t)TileDefinition::s_tileDefinitionsByIndex.size());
+	for (int definitionIndex = 0; definitionIndex < (int)TileDefinition::s_tileDefinitionsByIndex.size(); ++definitionIndex)
+	{
+		TileDefinition* definition = TileDefinition::s_tileDefinitionsByIndex[definitionIndex];
+		writer.WriteString(definition->m_name);
+		writer.Write(Tile(definition, 0).m_flags);
+	}
 
-		//swap first
-		m_agentsOrderedByPriority[indexI] = m_agentsOrderedByPriority[indexJ];
-		m_agentsOrderedByPriority[indexJ] = tempAgent;
+	writer.WriteVector(m_tileTints);
 
-		//set new indexes
-		m_agentsOrderedByPriority[indexI]->m_indexInPriorityList = indexI;
-		m_agentsOrderedByPriority[indexJ]->m_indexInPriorityList = indexJ;
-		break;
+	//uniform chunks are a single record
+	writer.Write((uint32_t)m_tileChunks.size());
+	for (int chunkIndex = 0; chunkIndex < (int)m_tileChunks.size(); ++chunkIndex)
+	{
+		const Tile* tiles = m_tileChunks[chunkIndex].GetTileData();
+		writer.Write((uint8_t)(tiles == nullptr ? 1 : 0));
+
+		if (tiles == nullptr)
+			writer.Write(m_tileChunks[chunkIndex].GetFillTile());
+		else
+			writer.WriteBytes(tiles, sizeof(Tile) * TILES_PER_CHUNK);
 	}
 
-	tempAgent = nullptr;
+	return WriteMapArtifactFile(writer, key);
 }
 
 //  =========================================================================================
-void Map::GetAsGrid(Grid<int>& outMapGrid)
+void Map::InitializeTiles(TileDefinition* fillDefinition)
 {
-	outMapGrid.InitializeGrid(0, m_dimensions.x, m_dimensions.y);
+	//white is always the first tint so untinted tiles share index zero
+	m_tileTints.clear();
+	m_tileTints.push_back(Rgba::WHITE);
+	m_tileTags.clear();
+	m_freeSpaceIndex.Clear();
+	m_tileCollisionMasks.clear();
+
+	m_numTileChunks = IntVector2((m_dimensions.x + TILE_CHUNK_MASK) >> TILE_CHUNK_SIZE_BITS, (m_dimensions.y + TILE_CHUNK_MASK) >> TILE_CHUNK_SIZE_BITS);
+	m_tileChunks.clear();
+	m_tileChunks.resize(m_numTileChunks.x * m_numTileChunks.y);
 
-	for (int tileIndex = 0; tileIndex < (int)m_tiles.size(); tileIndex++)
+	Tile fillTile = Tile(fillDefinition, 0);
+	for (int chunkY = 0; chunkY < m_numTileChunks.y; ++chunkY)
 	{
-		int value = m_tiles[tileIndex]->m_tileDefinition->m_allowsWalking ? 0 : 1;
+		for (int chunkX = 0; chunkX < m_numTileChunks.x; ++chunkX)
+		{
+			//chunks on the far edges can hang off the map
+			int numTilesX = ClampInt(m_dimensions.x - (chunkX << TILE_CHUNK_SIZE_BITS), 0, TILE_CHUNK_SIZE);
+			int numTilesY = ClampInt(m_dimensions.y - (chunkY << TILE_CHUNK_SIZE_BITS), 0, TILE_CHUNK_SIZE);
 
-		if(value != 0)
-			outMapGrid.SetValueAtIndex(value, tileIndex);
+			m_tileChunks[chunkX + (chunkY * m_numTileChunks.x)].Initialize(fillTile, numTilesX, numTilesY);
+		}
 	}
 }
 
 //  =========================================================================================
-void Map::InitializeMapGrid()
+void Map::FillTiles(TileDefinition* fillDefinition)
 {
-	m_mapAsGrid = new Grid<int>();
-	m_mapAsGrid->InitializeGrid(0, m_dimensions.x, m_dimensions.y);
+	Tile fillTile = Tile(fillDefinition, 0);
+	for (int chunkIndex = 0; chunkIndex < (int)m_tileChunks.size(); ++chunkIndex)
+	{
+		m_tileChunks[chunkIndex].Fill(fillTile);
+	}
+
+	m_isMapGridDirty = true;
+	m_freeSpaceIndex.Clear();
+	m_tileCollisionMasks.clear();
 }
 
 //  =========================================================================================
-void Map::UpdateMapGrid()
+const Tile* Map::GetTileAtCoordinate(const IntVector2& coordinate) const
 {
-	PROFILER_PUSH();
+	//handle bad coordinates
+	if(coordinate.x >= m_dimensions.x || coordinate.x < 0 || coordinate.y >= m_dimensions.y || coordinate.y < 0)
+		return nullptr;
 
-	for (int tileIndex = 0; tileIndex < (int)m_tiles.size(); tileIndex++)
-	{
-		int value = m_tiles[tileIndex]->m_tileDefinition->m_allowsWalking ? 0 : 1;
+	return &GetTileChunkAtCoordinate(coordinate).GetTile(TileChunk::GetLocalIndex(coordinate.x, coordinate.y));
+}
 
-		if(value != 0)
-			m_mapAsGrid->SetValueAtIndex(value, tileIndex);
-	}
+//  =========================================================================================
+const Tile* Map::GetTileAtWorldPosition(const Vector2& position)
+{
+	IntVector2 cooordinateOfPosition = GetTileCoordinateOfPosition(position);
 
-	//redraw debug mesh
-	if(g_isDebugDataShown)
-		CreateDebugMapMesh();
+	return GetTileAtCoordinate(cooordinateOfPosition);
+}
 
-	m_isMapGridDirty = false;
+//  =========================================================================================
+const Tile& Map::GetTileAtIndex(int tileIndex) const
+{
+	IntVector2 coordinate = GetTileCoordinateOfIndex(tileIndex);
+	return GetTileChunkAtCoordinate(coordinate).GetTile(TileChunk::GetLocalIndex(coordinate.x, coordinate.y));
 }
 
 //  =========================================================================================
-bool Map::IsTileBlockingAtCoordinate(const IntVector2& coordinate)
+void Map::SetTileAtCoordinate(const IntVector2& coordinate, TileDefinition* definition)
 {
-	bool isBlocking = !GetTileAtCoordinate(coordinate)->m_tileDefinition->m_allowsWalking;
-	return isBlocking;	
+	SetTileAtCoordinate(coordinate, definition, GetTileTint(*GetTileAtCoordinate(coordinate)));
 }
 
 //  =========================================================================================
-bool Map::DoesTilePreventBuilding(const IntVector2& coordinate)
+void Map::SetTileAtCoordinate(const IntVector2& coordinate, TileDefinition* definition, const Rgba& tint)
 {
-	bool doesAllowBuilding = !GetTileAtCoordinate(coordinate)->m_tileDefinition->m_allowsBuilding;
-	return doesAllowBuilding;	
+	TileChunk& chunk = GetTileChunkAtCoordinate(coordinate);
+	int localIndex = TileChunk::GetLocalIndex(coordinate.x, coordinate.y);
+
+	Tile newTile = Tile(definition, GetOrAddTileTintIndex(tint));
+	uint8_t oldFlags = chunk.GetTile(localIndex).m_flags;
+	bool didWalkingChange = chunk.GetTile(localIndex).AllowsWalking() != newTile.AllowsWalking();
+	if (didWalkingChange)
+		m_isMapGridDirty = true;
+
+	chunk.SetTile(localIndex, newTile);
+
+	if (didWalkingChange)
+		UpdateTileCollisionMasksAroundCoordinate(coordinate);
+
+	if (oldFlags != newTile.m_flags)
+		m_freeSpaceIndex.UpdateTile(*this, coordinate);
 }
 
 //  =========================================================================================
-Tile* Map::GetTileAtCoordinate(const IntVector2& coordinate)
+uint8_t Map::GetOrAddTileTintIndex(const Rgba& tint)
 {
-	//handle bad coordinates
-	if(coordinate.x >= m_dimensions.x || coordinate.x < 0 || coordinate.y >= m_dimensions.y || coordinate.y < 0)
-		return nullptr;
+	for (int tintIndex = 0; tintIndex < (int)m_tileTints.size(); ++tintIndex)
+	{
+		const Rgba& existingTint = m_tileTints[tintIndex];
+		if (existingTint.r == tint.r && existingTint.g == tint.g && existingTint.b == tint.b && existingTint.a == tint.a)
+			return (uint8_t)tintIndex;
+	}
 
-	return m_tiles[coordinate.x + (coordinate.y * m_dimensions.x)];
+	//tiles only have a byte for their tint
+	ASSERT_OR_DIE(m_tileTints.size() < 256, "TOO MANY TILE TINTS");
+	m_tileTints.push_back(tint);
+	return (uint8_t)(m_tileTints.size() - 1);
 }
 
 //  =========================================================================================
-Tile* Map::GetTileAtWorldPosition(const Vector2& position)
+bool Map::DoesTileHaveTags(int tileIndex, const std::string& tags)
 {
-	IntVector2 cooordinateOfPosition = GetTileCoordinateOfPosition(position);
+	std::map<int, Tags>::iterator tagIterator = m_tileTags.find(tileIndex);
+	if (tagIterator == m_tileTags.end())
+		return false;
 
-	return GetTileAtCoordinate(cooordinateOfPosition);
+	return tagIterator->second.HasTags(tags);
+}
+
+//  =========================================================================================
+Tags& Map::GetTileTagsAtIndex(int tileIndex)
+{
+	return m_tileTags[tileIndex];
 }
 
 //  =========================================================================================
@@ -1097,6 +1993,63 @@ PointOfInterest* Map::GetPointOfInterestById(int poiId)
 	return nullptr;
 }
 
+//  =========================================================================================
+void Map::InitializePointOfInterestPathDistances()
+{
+	PROFILER_PUSH();
+
+	int numPointsOfInterest = (int)m_pointsOfInterest.size();
+	m_pointOfInterestPathDistances.clear();
+	m_pointOfInterestPathDistances.resize(numPointsOfInterest * numPointsOfInterest, 0.f);
+
+	for (int poiIndex = 0; poiIndex < numPointsOfInterest; ++poiIndex)
+	{
+		m_pointsOfInterest[poiIndex]->m_indexInPointOfInterestList = poiIndex;
+	}
+
+	//paths are symmetric so only search the upper triangle
+	std::vector<Vector2> path;
+	for (int fromIndex = 0; fromIndex < numPointsOfInterest; ++fromIndex)
+	{
+		PointOfInterest* fromPoi = m_pointsOfInterest[fromIndex];
+
+		for (int toIndex = fromIndex + 1; toIndex < numPointsOfInterest; ++toIndex)
+		{
+			PointOfInterest* toPoi = m_pointsOfInterest[toIndex];
+
+			path.clear();
+			path.push_back(toPoi->m_accessPosition);
+
+			float distance = 0.f;
+			if (AStarSearchOnGrid(path, fromPoi->m_accessCoordinate, toPoi->m_accessCoordinate, m_mapAsGrid, this))
+			{
+				//path is stored goal first so walk it backwards from the start
+				Vector2 previousPosition = fromPoi->m_accessPosition;
+				for (int pathIndex = (int)path.size() - 1; pathIndex >= 0; --pathIndex)
+				{
+					distance += GetDistance(previousPosition, path[pathIndex]);
+					previousPosition = path[pathIndex];
+				}
+			}
+			else
+			{
+				//no path. straight line is still a better guess than nothing
+				distance = GetDistance(fromPoi->m_accessPosition, toPoi->m_accessPosition);
+			}
+
+			m_pointOfInterestPathDistances[(fromIndex * numPointsOfInterest) + toIndex] = distance;
+			m_pointOfInterestPathDistances[(toIndex * numPointsOfInterest) + fromIndex] = distance;
+		}
+	}
+}
+
+//  =========================================================================================
+float Map::GetPathDistanceBetweenPointsOfInterest(PointOfInterest* fromPoi, PointOfInterest* toPoi)
+{
+	int numPointsOfInterest = (int)m_pointsOfInterest.size();
+	return m_pointOfInterestPathDistances[(fromPoi->m_indexInPointOfInterestList * numPointsOfInterest) + toPoi->m_indexInPointOfInterestList];
+}
+
 //  =========================================================================================
 void Map::DetectBombardmentToAgentCollision(Bombardment* bombardment)
 {
@@ -1125,8 +2078,7 @@ void Map::DetectBombardmentToPOICollision(Bombardment* bombardment)
 //  =========================================================================================
 bool Map::DoesBombardmentStartFire()
 {
-	//Game::GetGlobalRNG()->GetRandomZeroToOne()
-	return GetRandomFloatInRange(0.f, 1.f) >= RANDOM_FIRE_THRESHOLD ? true : false;
+	return GetRandomStream(FIRE_RANDOM_STREAM).GetNextFloatZeroToOne() >= RANDOM_FIRE_THRESHOLD ? true : false;
 }
 
 
@@ -1144,348 +2096,187 @@ Fire* Map::GetFireById(int entityId)
 }
 
 //  =========================================================================================
-void Map::SpawnFire(Tile* spawnTile)
+void Map::SpawnFire(const IntVector2& coordinate)
 {
-	spawnTile->m_tileDefinition = TileDefinition::s_tileDefinitions.find("Fire")->second;
-	Fire* fire = new Fire(spawnTile->m_tileCoords, this);
+	SetTileAtCoordinate(coordinate, TileDefinition::s_fireDefinition);
+	Fire* fire = new Fire(coordinate, this);
 	m_fires.push_back(fire);
 
 	m_isMapGridDirty = true;
 }
 
 //  =========================================================================================
-void Map::DetectAgentToTileCollision(Agent* agent)
+void AgentTileCollisionBatch::Clear()
 {
-#ifdef CollisionDataAnalysis
-	// profiling ----------------------------------------------
-	g_collisionAnalysisData->Start();
-	//  ----------------------------------------------
-#endif
-
-	IntVector2 agentTileCoord = GetTileCoordinateOfPosition(agent->m_position);
-	Vector2 agentPosition = agent->m_position;
-	bool didPushOutCorner = false;
-	bool didPushOutAxis = false;
-
-	
-	// handle up,down,left,right push out (because we've done corners, we can skip scenarios where we have both) ----------------------------------------------
-	//handle north
-	IntVector2 tileDirection = IntVector2(0, 1);
-	IntVector2 tileCoord = agentTileCoord + tileDirection;
-	didPushOutAxis = PushAgentOutOfTileNorth(agent, tileCoord);
-
-	//handle south
-	if (!didPushOutAxis)
-	{
-		//handle southeast
-		tileDirection = IntVector2(0,-1);
-		tileCoord = agentTileCoord + tileDirection;
-		didPushOutAxis = PushAgentOutOfTileSouth(agent, tileCoord);
-	}
-
-	//handle east
-	if (!didPushOutAxis)
-	{
-		//handle southeast
-		tileDirection = IntVector2(1,0);
-		tileCoord = agentTileCoord + tileDirection;
-		didPushOutAxis = PushAgentOutOfTileEast(agent, tileCoord);
-	}
-
-	//handle west
-	if (!didPushOutAxis)
-	{
-		//handle southeast
-		tileDirection = IntVector2(-1,0);
-		tileCoord = agentTileCoord + tileDirection;
-		didPushOutAxis = PushAgentOutOfTileWest(agent, tileCoord);
-	}
-
-	//handle northeast
-	tileDirection = IntVector2(1, 1);
-	tileCoord = agentTileCoord + tileDirection;
-
-	didPushOutCorner = PushAgentOutOfTileNorthEast(agent, tileCoord);
-
-	if (!didPushOutCorner)
-	{
-		//handle southeast
-		tileDirection = IntVector2(1, -1);
-		tileCoord = agentTileCoord + tileDirection;
-		didPushOutCorner = PushAgentOutOfTileSouthEast(agent, tileCoord);
-	}
-
-	if (!didPushOutCorner)
-	{
-		//handle northwest
-		tileDirection = IntVector2(-1, 1);
-		tileCoord = agentTileCoord + tileDirection;
-		didPushOutCorner = PushAgentOutOfTileNorthWest(agent, tileCoord);
-	}
-
-	if (!didPushOutCorner)
-	{
-		//handle southwest
-		tileDirection = IntVector2(-1, -1);
-		tileCoord = agentTileCoord + tileDirection;
-		didPushOutCorner = PushAgentOutOfTileSouthWest(agent, tileCoord);
-	}
-#ifdef CollisionDataAnalysis
-	// profiling ----------------------------------------------
-	g_collisionAnalysisData->End();
-	//  ----------------------------------------------
-#endif
+	m_agents.clear();
+	m_positionsX.clear();
+	m_positionsY.clear();
+	m_radii.clear();
+	m_tileMinsX.clear();
+	m_tileMinsY.clear();
+	m_collisionMasks.clear();
 }
 
 //  =========================================================================================
-bool Map::PushAgentOutOfTileNorth(Agent * agent, const IntVector2 & tileCoordinate)
+void AgentTileCollisionBatch::Add(Agent* agent, const IntVector2& tileCoordinate, uint8_t collisionMask)
 {
-	Tile* tile = GetTileAtCoordinate(tileCoordinate);
-	if (tile == nullptr)
-		return false;
-
-	if (tile->m_tileDefinition->m_allowsWalking)
-		return false;
-	
-	//check to see if our Y + the radius would overlap
-	float pushOutAmount = (agent->m_physicsDisc.center.y + agent->m_physicsDisc.radius) - (float)tileCoordinate.y;
-	
-	if (pushOutAmount > 0.f)
-	{
-		agent->m_position.y -= pushOutAmount;
-	}
-
-	agent->UpdatePhysicsData();
+	m_agents.push_back(agent);
+	m_positionsX.push_back(agent->m_position.x);
+	m_positionsY.push_back(agent->m_position.y);
+	m_radii.push_back(agent->m_physicsDisc.radius);
+	m_tileMinsX.push_back((float)tileCoordinate.x);
+	m_tileMinsY.push_back((float)tileCoordinate.y);
+	m_collisionMasks.push_back(collisionMask);
 }
 
 //  =========================================================================================
-bool Map::PushAgentOutOfTileSouth(Agent * agent, const IntVector2 & tileCoordinate)
+void Map::ResolveAgentToTileCollisions(const std::vector<Agent*>& agents)
 {
-	Tile* tile = GetTileAtCoordinate(tileCoordinate);
-	if (tile == nullptr)
-		return false;
-
-	if (tile->m_tileDefinition->m_allowsWalking)
-		return false;
+	ScopedAnalysisTimer<CollisionAnalysisPolicy> analysisTimer(g_collisionAnalysisData);
 
-	//check to see if our Y + the radius would overlap
-	float pushOutAmount = (float)tileCoordinate.y - (agent->m_physicsDisc.center.y - agent->m_physicsDisc.radius);
+	if (m_tileCollisionMasks.size() == 0)
+		RebuildTileCollisionMasks();
 
-	if (pushOutAmount > 0.f)
+	//agents in fully open tiles have nothing to push against
+	m_agentTileCollisionBatch.Clear();
+	for (int agentIndex = 0; agentIndex < (int)agents.size(); ++agentIndex)
 	{
-		agent->m_position.y += pushOutAmount;
-	}
-
-	agent->UpdatePhysicsData();
-}
-
-//  =========================================================================================
-bool Map::PushAgentOutOfTileEast(Agent * agent, const IntVector2 & tileCoordinate)
-{
-	Tile* tile = GetTileAtCoordinate(tileCoordinate);
-	if (tile == nullptr)
-		return false;
-
-	if (tile->m_tileDefinition->m_allowsWalking)
-		return false;
+		Agent* agent = agents[agentIndex];
+		IntVector2 agentTileCoord = GetTileCoordinateOfPosition(agent->m_position);
 
-	//check to see if our Y + the radius would overlap
-	float pushOutAmount = (agent->m_physicsDisc.center.x + agent->m_physicsDisc.radius) - (float)tileCoordinate.x;
-
-	if (pushOutAmount > 0)
-	{
-		agent->m_position.x -= pushOutAmount;
+		uint8_t collisionMask = GetTileCollisionMask(agentTileCoord);
+		if (collisionMask != 0)
+			m_agentTileCollisionBatch.Add(agent, agentTileCoord, collisionMask);
 	}
 
-	agent->UpdatePhysicsData();
-}
-
-//  =========================================================================================
-bool Map::PushAgentOutOfTileWest(Agent * agent, const IntVector2 & tileCoordinate)
-{
-	Tile* tile = GetTileAtCoordinate(tileCoordinate);
-	if (tile == nullptr)
-		return false;
-
-	if (tile->m_tileDefinition->m_allowsWalking)
-		return false;
-
-	//check to see if our Y + the radius would overlap
-	float pushOutAmount = (float)tileCoordinate.x - (agent->m_physicsDisc.center.x - agent->m_physicsDisc.radius);
+	AgentTileCollisionBatch& batch = m_agentTileCollisionBatch;
+	int numAgents = (int)batch.m_agents.size();
+	float* positionsX = batch.m_positionsX.data();
+	float* positionsY = batch.m_positionsY.data();
+	const float* radii = batch.m_radii.data();
+	const float* tileMinsX = batch.m_tileMinsX.data();
+	const float* tileMinsY = batch.m_tileMinsY.data();
+	const uint8_t* collisionMasks = batch.m_collisionMasks.data();
 
-	if (pushOutAmount > 0)
+	//blocked sides clamp the agent back inside its tile. selects instead of branches so this loop vectorizes
+	for (int agentIndex = 0; agentIndex < numAgents; ++agentIndex)
 	{
-		agent->m_position.x += pushOutAmount;
-	}
+		float radius = radii[agentIndex];
+		float positionX = positionsX[agentIndex];
+		float positionY = positionsY[agentIndex];
+		uint8_t collisionMask = collisionMasks[agentIndex];
 
-	agent->UpdatePhysicsData();
-}
+		float maxX = tileMinsX[agentIndex] + 1.f - radius;
+		float minX = tileMinsX[agentIndex] + radius;
+		float maxY = tileMinsY[agentIndex] + 1.f - radius;
+		float minY = tileMinsY[agentIndex] + radius;
 
-//  =========================================================================================
-bool Map::PushAgentOutOfTileNorthEast(Agent * agent, const IntVector2 & tileCoordinate)
-{
-	Tile* tile = GetTileAtCoordinate(tileCoordinate);
-	if (tile == nullptr)
-		return false;
+		positionX = (collisionMask & (1 << EAST_TILE_DIRECTION)) != 0 && positionX > maxX ? maxX : positionX;
+		positionX = (collisionMask & (1 << WEST_TILE_DIRECTION)) != 0 && positionX < minX ? minX : positionX;
+		positionY = (collisionMask & (1 << NORTH_TILE_DIRECTION)) != 0 && positionY > maxY ? maxY : positionY;
+		positionY = (collisionMask & (1 << SOUTH_TILE_DIRECTION)) != 0 && positionY < minY ? minY : positionY;
 
-	if (tile->m_tileDefinition->m_allowsWalking)
-		return false;
+		positionsX[agentIndex] = positionX;
+		positionsY[agentIndex] = positionY;
+	}
 
-	Vector2 collisionPoint = Vector2((float)tileCoordinate.x, (float)tileCoordinate.y);
+	//corners push away from the nearest blocked corner point. only the first one hit is handled
+	static const int cornerDirections[4] = { NORTHEAST_TILE_DIRECTION, SOUTHEAST_TILE_DIRECTION, NORTHWEST_TILE_DIRECTION, SOUTHWEST_TILE_DIRECTION };
+	static const float cornerOffsetsX[4] = { 1.f, 1.f, 0.f, 0.f };
+	static const float cornerOffsetsY[4] = { 1.f, 0.f, 1.f, 0.f };
 
-	bool isColliding = agent->m_physicsDisc.IsPointInside(collisionPoint);
-	if (isColliding)
+	for (int agentIndex = 0; agentIndex < numAgents; ++agentIndex)
 	{
-		float displacement = GetDistance(agent->m_position, collisionPoint);
-
-		float amountToPush = agent->m_physicsDisc.radius - displacement;
-		Vector2 pushOutDirection = (agent->m_position - collisionPoint).GetNormalized();
-
-		agent->m_position += pushOutDirection * (amountToPush);
-		agent->UpdatePhysicsData();
-	}
+		uint8_t collisionMask = collisionMasks[agentIndex];
+		float radius = radii[agentIndex];
 
-	return isColliding;	
-}
+		for (int cornerIndex = 0; cornerIndex < 4; ++cornerIndex)
+		{
+			if ((collisionMask & (1 << cornerDirections[cornerIndex])) == 0)
+				continue;
 
-//  =========================================================================================
-bool Map::PushAgentOutOfTileNorthWest(Agent * agent, const IntVector2 & tileCoordinate)
-{
-	Tile* tile = GetTileAtCoordinate(tileCoordinate);
-	if (tile == nullptr)
-		return false;
+			float displacementX = positionsX[agentIndex] - (tileMinsX[agentIndex] + cornerOffsetsX[cornerIndex]);
+			float displacementY = positionsY[agentIndex] - (tileMinsY[agentIndex] + cornerOffsetsY[cornerIndex]);
+			float distanceSquared = (displacementX * displacementX) + (displacementY * displacementY);
 
-	if (tile->m_tileDefinition->m_allowsWalking)
-		return false;
+			if (distanceSquared >= radius * radius || distanceSquared == 0.f)
+				continue;
 
-	Vector2 collisionPoint = Vector2((float)tileCoordinate.x + 1.f, (float)tileCoordinate.y);
+			float distance = sqrtf(distanceSquared);
+			float pushScale = (radius - distance) / distance;
+			positionsX[agentIndex] += displacementX * pushScale;
+			positionsY[agentIndex] += displacementY * pushScale;
+			break;
+		}
+	}
 
-	bool isColliding = agent->m_physicsDisc.IsPointInside(collisionPoint);
-	if (isColliding)
+	for (int agentIndex = 0; agentIndex < numAgents; ++agentIndex)
 	{
-		float displacement = GetDistance(agent->m_position, collisionPoint);
-
-		float amountToPush = agent->m_physicsDisc.radius - displacement;
-		Vector2 pushOutDirection = (agent->m_position - collisionPoint).GetNormalized();
-
-		agent->m_position += pushOutDirection * (amountToPush);
+		Agent* agent = batch.m_agents[agentIndex];
+		agent->m_position = Vector2(positionsX[agentIndex], positionsY[agentIndex]);
 		agent->UpdatePhysicsData();
 	}
-
-	return isColliding;
 }
 
 //  =========================================================================================
-bool Map::PushAgentOutOfTileSouthEast(Agent * agent, const IntVector2 & tileCoordinate)
+void Map::RebuildTileCollisionMasks()
 {
-	Tile* tile = GetTileAtCoordinate(tileCoordinate);
-	if (tile == nullptr)
-		return false;
-
-	if (tile->m_tileDefinition->m_allowsWalking)
-		return false;
+	m_tileCollisionMasks.assign(GetNumTiles(), 0);
 
-	Vector2 collisionPoint = Vector2((float)tileCoordinate.x, (float)tileCoordinate.y + 1.f);
-
-	bool isColliding = agent->m_physicsDisc.IsPointInside(collisionPoint);
-	if (isColliding)
+	for (int yCoordinate = 0; yCoordinate < m_dimensions.y; ++yCoordinate)
 	{
-		float displacement = GetDistance(agent->m_position, collisionPoint);
-
-		float amountToPush = agent->m_physicsDisc.radius - displacement;
-		Vector2 pushOutDirection = (agent->m_position - collisionPoint).GetNormalized();
+		for (int xCoordinate = 0; xCoordinate < m_dimensions.x; ++xCoordinate)
+		{
+			if (GetTileAtCoordinate(IntVector2(xCoordinate, yCoordinate))->AllowsWalking())
+				continue;
 
-		agent->m_position += pushOutDirection * (amountToPush);
-		agent->UpdatePhysicsData();
+			UpdateTileCollisionMasksAroundCoordinate(IntVector2(xCoordinate, yCoordinate));
+		}
 	}
-
-	return isColliding;
 }
 
 //  =========================================================================================
-bool Map::PushAgentOutOfTileSouthWest(Agent * agent, const IntVector2 & tileCoordinate)
+void Map::UpdateTileCollisionMasksAroundCoordinate(const IntVector2& coordinate)
 {
-	Tile* tile = GetTileAtCoordinate(tileCoordinate);
-	if (tile == nullptr)
-		return false;
-
-	if (tile->m_tileDefinition->m_allowsWalking)
-		return false;
-
-	Vector2 collisionPoint = Vector2((float)tileCoordinate.x + 1.f, (float)tileCoordinate.y + 1.f);
+	//nothing to keep current until the first collision pass builds them
+	if (m_tileCollisionMasks.size() == 0)
+		return;
 
-	bool isColliding = agent->m_physicsDisc.IsPointInside(collisionPoint);
-	if (isColliding)
+	static const IntVector2 directionOffsets[NUM_TILE_DIRECTIONS] = 
 	{
-		float displacement = GetDistance(agent->m_position, collisionPoint);
+		IntVector2(1, 0),	//east
+		IntVector2(-1, 0),	//west
+		IntVector2(0, 1),	//north
+		IntVector2(0, -1),	//south
+		IntVector2(1, 1),	//northeast
+		IntVector2(-1, 1),	//northwest
+		IntVector2(1, -1),	//southeast
+		IntVector2(-1, -1)	//southwest
+	};
 
-		float amountToPush = agent->m_physicsDisc.radius - displacement;
-		Vector2 pushOutDirection = (agent->m_position - collisionPoint).GetNormalized();
+	//the tile is the neighbor in the opposite direction for everything around it
+	bool isBlocking = !GetTileAtCoordinate(coordinate)->AllowsWalking();
+	for (int direction = 0; direction < NUM_TILE_DIRECTIONS; ++direction)
+	{
+		IntVector2 neighborCoordinate = IntVector2(coordinate.x - directionOffsets[direction].x, coordinate.y - directionOffsets[direction].y);
+		if (neighborCoordinate.x < 0 || neighborCoordinate.y < 0 || neighborCoordinate.x >= m_dimensions.x || neighborCoordinate.y >= m_dimensions.y)
+			continue;
 
-		agent->m_position += pushOutDirection * (amountToPush);
-		agent->UpdatePhysicsData();
+		uint8_t& collisionMask = m_tileCollisionMasks[neighborCoordinate.x + (neighborCoordinate.y * m_dimensions.x)];
+		if (isBlocking)
+			collisionMask |= (uint8_t)(1 << direction);
+		else
+			collisionMask &= (uint8_t)~(1 << direction);
 	}
-
-	return isColliding;
 }
 
 //  =========================================================================================
-bool Map::PushAgentOutOfTile(Agent* agent, const IntVector2& tileCoordinate, int tileDirection)
+uint8_t Map::GetTileCollisionMask(const IntVector2& coordinate) const
 {
-	PROFILER_PUSH();
-
-	//early outs
-	Tile* tile = GetTileAtCoordinate(tileCoordinate);
-	if(tile == nullptr)
-		return false;
-
-	if(tile->m_tileDefinition->m_allowsWalking)
-		return false;
-
-	Vector2 agentCenter = agent->m_position;
-
-		Vector2 collisionPoint;
-		switch(tileDirection)
-		{
-		case EAST_TILE_DIRECTION:
-			collisionPoint = Vector2((float)tileCoordinate.x, agentCenter.y);
-			break;
-		case WEST_TILE_DIRECTION:
-			collisionPoint = Vector2((float)tileCoordinate.x + 1, agentCenter.y);
-			break;
-		case NORTH_TILE_DIRECTION:
-			collisionPoint = Vector2(agentCenter.x, (float)tileCoordinate.y);
-			break;
-		case SOUTH_TILE_DIRECTION:
-			collisionPoint = Vector2(agentCenter.x, (float)tileCoordinate.y + 1.f);
-			break;
-		case NORTHEAST_TILE_DIRECTION:
-			collisionPoint = Vector2((float)tileCoordinate.x, (float)tileCoordinate.y);
-			break;
-		case NORTHWEST_TILE_DIRECTION:
-			collisionPoint = Vector2((float)tileCoordinate.x + 1.f, (float)tileCoordinate.y);
-			break;
-		case SOUTHEAST_TILE_DIRECTION:
-			collisionPoint = Vector2((float)tileCoordinate.x, (float)tileCoordinate.y + 1.f);
-			break;
-		case SOUTHWEST_TILE_DIRECTION:
-			collisionPoint = Vector2((float)tileCoordinate.x + 1.f, (float)tileCoordinate.y + 1.f);
-			break;
-		}
-
-		bool isColliding =  agent->m_physicsDisc.IsPointInside(collisionPoint);
-		if(isColliding)
-		{
-			float displacement = GetDistance(agentCenter, collisionPoint);
-
-			float amountToPush = agent->m_physicsDisc.radius - displacement;
-			Vector2 pushOutDirection = (agentCenter - collisionPoint).GetNormalized();
-
-			agent->m_position += pushOutDirection * (amountToPush);
-			agent->UpdatePhysicsData();
-		}	
+	if (coordinate.x < 0 || coordinate.y < 0 || coordinate.x >= m_dimensions.x || coordinate.y >= m_dimensions.y)
+		return 0;
 
-		return isColliding;
+	return m_tileCollisionMasks[coordinate.x + (coordinate.y * m_dimensions.x)];
 }
 
 //  =========================================================================================
@@ -1493,137 +2284,61 @@ PointOfInterest* Map::GeneratePointOfInterest(int poiType)
 {
 	ePointOfInterestType type = (ePointOfInterestType)poiType;
 
-	//determine if random location is unblocked
-	bool isLocationValid = false;
+	//the index only holds corners with a buildable footprint and at least one open access tile
 	IntVector2 randomCoordinate = IntVector2::ONE;
-	IntVector2 accessCoordinate = IntVector2::NEGATIVE_ONE;
+	bool isLocationFound = GetFreeSpaceIndex().GetRandomBuildingCoordinate(GetRandomStream(POINT_OF_INTEREST_RANDOM_STREAM), randomCoordinate);
+	ASSERT_OR_DIE(isLocationFound, "NO SPACE TO PLACE POI!!!");
 
-	std::vector<int> potentialAccessPoints = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+	//pick randomly between the open access tiles
+	std::vector<int> potentialAccessPoints = {0, 1, 2, 3, 4, 5, 6, 7};
+	ShuffleList(potentialAccessPoints, GetRandomStream(POINT_OF_INTEREST_RANDOM_STREAM));
 
-	int locationPlacementAttemptCount = 0;
-	while (!isLocationValid)
+	IntVector2 accessCoordinate = IntVector2::NEGATIVE_ONE;
+	for (int accessIndex = 0; accessIndex < (int)potentialAccessPoints.size(); ++accessIndex)
 	{
-		ASSERT_OR_DIE(locationPlacementAttemptCount != 100, "NO SPACE TO PLACE POI!!!");
+		const IntVector2& accessOffset = BUILDING_ACCESS_OFFSETS[potentialAccessPoints[accessIndex]];
+		IntVector2 potentialAccessCoordinate = IntVector2(randomCoordinate.x + accessOffset.x, randomCoordinate.y + accessOffset.y);
 
-		randomCoordinate = IntVector2::ONE;
-		accessCoordinate = IntVector2::NEGATIVE_ONE;
-		randomCoordinate = GetRandomNonBlockedCoordinateInMapBounds();
-		
-		//check tile to north, to the right, and to the northeast to see if they are even good
-		if(CheckIsCoordinateValid(IntVector2(randomCoordinate.x + 1, randomCoordinate.y)) 
-			&& CheckIsCoordinateValid(IntVector2(randomCoordinate.x, randomCoordinate.y + 1))
-			&& CheckIsCoordinateValid(IntVector2(randomCoordinate.x + 1, randomCoordinate.y + 1)))
+		if (FreeSpaceIndex::IsValidBuildingAccessCoordinate(*this, potentialAccessCoordinate))
 		{
-			//check tile to north, to the right, and to the northeast to see if they are blocked
-			if (!DoesTilePreventBuilding(IntVector2(randomCoordinate.x + 1, randomCoordinate.y))
-				&& !DoesTilePreventBuilding(IntVector2(randomCoordinate.x, randomCoordinate.y + 1))
-				&& !DoesTilePreventBuilding(IntVector2(randomCoordinate.x + 1, randomCoordinate.y + 1)))
-			{
-				
-				bool isAccessLocationValid =  false;
-				int accessIterationAttemptCount = 0;
-
-				ShuffleList(potentialAccessPoints);
-
-				int accessIndex = 0;
-				while (!isAccessLocationValid && accessIndex < (int)potentialAccessPoints.size())
-				{
-					switch (potentialAccessPoints[accessIndex])
-					{
-					case 0:
-						accessCoordinate = IntVector2(randomCoordinate.x, randomCoordinate.y - 1);
-						break;
-					case 1:
-						accessCoordinate = IntVector2(randomCoordinate.x + 1, randomCoordinate.y - 1);
-						break;
-					case 2:
-						accessCoordinate = IntVector2(randomCoordinate.x + 2, randomCoordinate.y);
-						break;
-					case 3:
-						accessCoordinate = IntVector2(randomCoordinate.x + 2, randomCoordinate.y + 1);
-						break;
-					case 4:
-						accessCoordinate = IntVector2(randomCoordinate.x + 1, randomCoordinate.y + 2);
-						break;
-					case 5:
-						accessCoordinate = IntVector2(randomCoordinate.x, randomCoordinate.y + 2);
-						break;
-					case 6:
-						accessCoordinate = IntVector2(randomCoordinate.x - 1, randomCoordinate.y + 1);
-						break;
-					case 7:
-						accessCoordinate = IntVector2(randomCoordinate.x - 1, randomCoordinate.y);
-						break;
-					}
-
-					if (CheckIsCoordinateValid(accessCoordinate) && !DoesTilePreventBuilding(accessCoordinate))
-					{
-						isAccessLocationValid = true;
-						isLocationValid = true;
-					}
-
-					if (!isAccessLocationValid)
-					{
-						++accessIndex;
-					}											
-				}
-
-				if (isAccessLocationValid)
-				{
-					isLocationValid = true;
-				}
-
-				locationPlacementAttemptCount++;
-			}
-		}		
+			accessCoordinate = potentialAccessCoordinate;
+			break;
+		}
 	}
 
 	//Location is valid, therefore we can replace tiles with building tiles
 	Rgba buildingColor = Rgba::WHITE;
-	std::string spriteName = "Building";
 	switch (poiType)
 	{
 	case ARMORY_POI_TYPE:
 		buildingColor = Rgba::LIGHT_RED_TRANSPARENT;
-		spriteName = "Armory";
 		break;
 	case LUMBERYARD_POI_TYPE:
 		buildingColor = LUMBERYARD_TINT;
-		spriteName = "Lumberyard";
 		break;
 	case MED_STATION_POI_TYPE:
 		buildingColor = MED_STATION_TINT;
-		spriteName = "MedStation";
 		break;
 	case WELL_POI_TYPE:
 		buildingColor = WELL_TINT;
-		spriteName = "Well";
 		break;
 	}
 
+	TileDefinition* buildingDefinition = TileDefinition::GetBuildingDefinitionForPointOfInterestType(poiType);
+
 	//starting tile
-	Tile* tile = GetTileAtCoordinate(randomCoordinate);
-	tile->m_tileDefinition = TileDefinition::s_tileDefinitions.find(spriteName.c_str())->second;
-	tile->m_tint = buildingColor;
+	SetTileAtCoordinate(randomCoordinate, buildingDefinition, buildingColor);
 
 	//tile to east
-	tile = GetTileAtCoordinate(IntVector2(randomCoordinate.x + 1, randomCoordinate.y));
-	tile->m_tileDefinition = TileDefinition::s_tileDefinitions.find(spriteName.c_str())->second;
-	tile->m_tint = buildingColor;
+	SetTileAtCoordinate(IntVector2(randomCoordinate.x + 1, randomCoordinate.y), buildingDefinition, buildingColor);
 
 	//tile to northeast
-	tile = GetTileAtCoordinate(IntVector2(randomCoordinate.x + 1, randomCoordinate.y + 1));
-	tile->m_tileDefinition = TileDefinition::s_tileDefinitions.find(spriteName.c_str())->second;
-	tile->m_tint = buildingColor;
+	SetTileAtCoordinate(IntVector2(randomCoordinate.x + 1, randomCoordinate.y + 1), buildingDefinition, buildingColor);
 
 	//tile to north
-	tile = GetTileAtCoordinate(IntVector2(randomCoordinate.x, randomCoordinate.y + 1));
-	tile->m_tileDefinition = TileDefinition::s_tileDefinitions.find(spriteName.c_str())->second;
-	tile->m_tint = buildingColor;
+	SetTileAtCoordinate(IntVector2(randomCoordinate.x, randomCoordinate.y + 1), buildingDefinition, buildingColor);
 
-	tile = GetTileAtCoordinate(IntVector2(accessCoordinate.x, accessCoordinate.y));
-	tile->m_tileDefinition = TileDefinition::s_tileDefinitions.find("BuildingAccess")->second;
-	tile->m_tint = buildingColor;
+	SetTileAtCoordinate(accessCoordinate, TileDefinition::s_buildingAccessDefinition, buildingColor);
 
 	PointOfInterest* poi = new PointOfInterest(type, randomCoordinate, accessCoordinate, this);
 
@@ -1643,7 +2358,7 @@ IntVector2 Map::GetTileCoordinateOfPosition(const Vector2& position)
 //  =========================================================================================
 Vector2 Map::GetWorldPositionOfMapCoordinate(const IntVector2& position)
 {
-	Vector2 worldPosition = m_tiles[position.x + (position.y * m_dimensions.x)]->GetTileWorldPosition();
+	Vector2 worldPosition = Vector2(position);
 	return worldPosition;
 }
 
@@ -1668,42 +2383,28 @@ bool Map::CheckIsCoordinateValid(const IntVector2 & coordinate)
 //  =========================================================================================
 Vector2 Map::GetRandomNonBlockedPositionInMapBounds()
 {
-	bool isNonBlocked = false;
 	IntVector2 randomCoord;
-
-	while (isNonBlocked == false)
-	{
-		//we know outer edges are no good so might as well skip
-		randomCoord = IntVector2(GetRandomIntInRange(1.f, m_dimensions.x - 1), GetRandomIntInRange(1.f, m_dimensions.y - 1));
-
-		Tile* correspondingTileCoordinate = GetTileAtCoordinate(randomCoord);
-	
-		if (correspondingTileCoordinate->m_tileDefinition->m_allowsWalking)
-		{
-			isNonBlocked = true;
-		}	
-	}
+	bool isPositionFound = GetFreeSpaceIndex().GetRandomWalkableCoordinate(GetRandomStream(AGENT_SPAWN_RANDOM_STREAM), randomCoord);
+	ASSERT_OR_DIE(isPositionFound, "NO SPACE TO PLACE AGENT!!!");
 
 	return Vector2(0.5f, 0.5f) + Vector2(randomCoord);
 }
 
 //  =========================================================================================
-IntVector2 Map::GetRandomNonBlockedCoordinateInMapBounds()
+FreeSpaceIndex& Map::GetFreeSpaceIndex()
 {
-	bool isBlocked = true;
-	IntVector2 randomPoint;
+	if (!m_freeSpaceIndex.IsBuilt())
+		m_freeSpaceIndex.Rebuild(*this);
 
-	while (isBlocked)
-	{
-		randomPoint = IntVector2(GetRandomIntInRange(OUTER_WALL_THICKNESS, m_dimensions.x - OUTER_WALL_THICKNESS - BUILDING_DIMENSIONS.x), GetRandomIntInRange(OUTER_WALL_THICKNESS, m_dimensions.y - OUTER_WALL_THICKNESS - BUILDING_DIMENSIONS.y));
-		isBlocked = IsTileBlockingAtCoordinate(randomPoint) || DoesTilePreventBuilding(randomPoint);
-	}
-
-	return randomPoint;
+	return m_freeSpaceIndex;
 }
 
 //  =========================================================================================
 IntVector2 Map::GetRandomCoordinateInMapBounds()
 {
-	return IntVector2(GetRandomIntInRange(0, m_dimensions.x - 1), GetRandomIntInRange(0, m_dimensions.y - 1));
+	RandomStream& bombardmentStream = GetRandomStream(BOMBARDMENT_RANDOM_STREAM);
+
+	int x = bombardmentStream.GetNextIntInRange(0, m_dimensions.x - 1);
+	int y = bombardmentStream.GetNextIntInRange(0, m_dimensions.y - 1);
+	return IntVector2(x, y);
 }
@@ -1,12 +1,22 @@
 #pragma once
 #include "Game\Definitions\MapDefinition.hpp"
 #include "Game\Map\Tile.hpp"
+#include "Game\Helpers\FreeSpaceIndex.hpp"
 #include "Game\SimulationData.hpp"
+#include "Game\Helpers\SlackTaskQueue.hpp"
+#include "Game\Helpers\TimingWheel.hpp"
+#include "Game\Helpers\RandomStream.hpp"
+#include "Game\Helpers\ReplayLog.hpp"
+#include "Game\Helpers\RenderVertexWorker.hpp"
+#include "Game\Agents\Agent.hpp"
 #include "Engine\Math\IntVector2.hpp"
 #include "Engine\Renderer\RenderScene2D.hpp"
 #include "Engine\Utility\Grid.hpp"
+#include "Engine\Utility\Tags.hpp"
+#include "Engine\Core\Rgba.hpp"
 #include <string>
 #include <vector>
+#include <map>
 
 //forward declarations
 enum ePointOfInterestType;
@@ -14,10 +24,13 @@ class Agent;
 class PointOfInterest;
 class Bombardment;
 class Fire;
-class Stopwatch;
 class Mesh;
+class Sprite;
+class IsoSpriteAnimSet;
 class PlayingState;
 class SimulationDefinition;
+class SnapshotWriter;
+class SnapshotReader;
 
 enum eTileDirection
 {
@@ -32,6 +45,33 @@ enum eTileDirection
 	NUM_TILE_DIRECTIONS
 };
 
+//per frame geometry that keeps its builder and gpu mesh alive and rewrites them in place. End returns false when there is nothing to draw
+struct PooledDynamicMesh
+{
+	void Begin();
+	bool End();
+	void Destroy();
+
+	MeshBuilder* m_builder = nullptr;
+	Mesh* m_mesh = nullptr;
+	int m_vertexHighWaterMark = 0;
+};
+
+//agents next to a blocked tile, gathered into flat arrays so the push out runs as one tight loop
+struct AgentTileCollisionBatch
+{
+	void Clear();
+	void Add(Agent* agent, const IntVector2& tileCoordinate, uint8_t collisionMask);
+
+	std::vector<Agent*> m_agents;
+	std::vector<float> m_positionsX;
+	std::vector<float> m_positionsY;
+	std::vector<float> m_radii;
+	std::vector<float> m_tileMinsX;
+	std::vector<float> m_tileMinsY;
+	std::vector<uint8_t> m_collisionMasks;
+};
+
 enum eAgentSortType
 {
 	X_AGENT_SORT_TYPE,
@@ -40,6 +80,11 @@ enum eAgentSortType
 	NUM_SORT_TYPES
 };
 
+class Map;
+typedef void (Map::*AgentUpdateFunction)(float deltaSeconds);
+//agent is complete here so every translation unit agrees on the member pointer's size
+typedef bool (Agent::*AgentPathFunction)(const Vector2& goalDestination);
+
 class Map
 {
 public:
@@ -52,21 +97,47 @@ public:
 	void Update(float deltaSeconds);
 
 	void UpdateAgents(float deltaSeconds);
+	void UpdateAgentAnimations(float deltaSeconds);
+	template <typename SimulationPolicy>
+	void UpdateAgentsUnbudgeted(float deltaSeconds);
+	template <typename SimulationPolicy>
 	void UpdateAgentsBudgeted(float deltaSeconds);
+	void SelectAgentUpdateFunction();
+	void SelectSlackTasks();
 	void Render();
 
+	//render snapshots  ----------------------------------------------
+	void PublishRenderSnapshot();
+
+	//view culling  ----------------------------------------------
+	void SetViewBounds(const AABB2& viewBounds);
+
+	//determinism  ----------------------------------------------
+	void SeedRandomStreams();
+	void BeginReplay();
+	bool IsDeterministic();
+	RandomStream& GetRandomStream(eRandomStreamType streamType) { return m_randomStreams[streamType]; }
+
 	void Reload(SimulationDefinition* definition);
+	Agent* CreateAgent(const Vector2& position);
+
+	//checkpoints  ----------------------------------------------
+	bool SaveSnapshot(const std::string& filePath);
+	bool LoadSnapshot(const std::string& filePath);
+	void WriteSnapshot(SnapshotWriter& writer);
+	bool ReadSnapshot(SnapshotReader& reader);
 	void SetMapType(MapDefinition* newMapDefintion) { m_mapDefinition = newMapDefintion; }
 	IntVector2 GetDimensions() { return m_dimensions; }
 	float GetMapDistanceSquared(){ return (m_dimensions.x * m_dimensions.y) * (m_dimensions.x * m_dimensions.y);}
 
 	//optimized mesh generation  ----------------------------------------------
-	void CreateMapMesh();
-	void CreateDebugMapMesh();
-	void CreateDynamicAgentMesh();
-	Mesh* CreateDynamicBombardmentMesh();
-	Mesh* CreateDynamicFireMesh();
-	Mesh* CreateTextMesh();
+	void UpdateMapMeshes();
+	void UpdateDebugMapMeshes();
+	void CreateMapChunkMesh(int chunkIndex);
+	void CreateDebugMapChunkMesh(int chunkIndex);
+	void DeleteMapChunkMeshes();
+	void UploadDynamicMeshes();
+	bool UpdateTextMesh();
 
 	//Cleanup functions  ----------------------------------------------
 	void DeleteDeadEntities();
@@ -89,20 +160,43 @@ public:
 	bool CheckIsPositionValid(const Vector2& position);
 	bool CheckIsCoordinateValid(const IntVector2& coordinate);
 	Vector2 GetRandomNonBlockedPositionInMapBounds();
-	IntVector2 GetRandomNonBlockedCoordinateInMapBounds();
+	FreeSpaceIndex& GetFreeSpaceIndex();
 	IntVector2 GetRandomCoordinateInMapBounds();
 	void GetAsGrid(Grid<int>& outMapGrid);
 	void InitializeMapGrid();
 	void UpdateMapGrid();
+	void WriteTileChunkToGrid(int chunkIndex, Grid<int>& outMapGrid, bool isGridCleared);
+	void GetTileChunkBounds(int chunkIndex, IntVector2& outStart, IntVector2& outEnd) const;
 	bool IsTileBlockingAtCoordinate(const IntVector2& coordinate);
 	bool DoesTilePreventBuilding(const IntVector2& coordinate);
-	Tile* GetTileAtCoordinate(const IntVector2& coordinate);
-	Tile* GetTileAtWorldPosition(const Vector2& position);
 	Vector2 GetCenter();
 
+	//tiles  ----------------------------------------------
+	void GenerateTiles();
+	uint64_t GetTileArtifactKey() const;
+	bool LoadTileArtifact(uint64_t key);
+	bool SaveTileArtifact(uint64_t key);
+	void InitializeTiles(TileDefinition* fillDefinition);
+	void FillTiles(TileDefinition* fillDefinition);
+	int GetNumTiles() const { return m_dimensions.x * m_dimensions.y; }
+	IntVector2 GetTileCoordinateOfIndex(int tileIndex) const { return IntVector2(tileIndex % m_dimensions.x, tileIndex / m_dimensions.x); }
+	const Tile* GetTileAtCoordinate(const IntVector2& coordinate) const; //nullptr off the map
+	const Tile* GetTileAtWorldPosition(const Vector2& position);
+	const Tile& GetTileAtIndex(int tileIndex) const;
+	const Rgba& GetTileTint(const Tile& tile) const { return m_tileTints[tile.m_tintIndex]; }
+	void SetTileAtCoordinate(const IntVector2& coordinate, TileDefinition* definition); //keeps the current tint
+	void SetTileAtCoordinate(const IntVector2& coordinate, TileDefinition* definition, const Rgba& tint);
+	uint8_t GetOrAddTileTintIndex(const Rgba& tint);
+	bool DoesTileHaveTags(int tileIndex, const std::string& tags);
+	Tags& GetTileTagsAtIndex(int tileIndex);
+	TileChunk& GetTileChunkAtCoordinate(const IntVector2& coordinate) { return m_tileChunks[(coordinate.x >> TILE_CHUNK_SIZE_BITS) + ((coordinate.y >> TILE_CHUNK_SIZE_BITS) * m_numTileChunks.x)]; }
+	const TileChunk& GetTileChunkAtCoordinate(const IntVector2& coordinate) const { return m_tileChunks[(coordinate.x >> TILE_CHUNK_SIZE_BITS) + ((coordinate.y >> TILE_CHUNK_SIZE_BITS) * m_numTileChunks.x)]; }
+
 	//point of interest helpers  ----------------------------------------------
 	PointOfInterest* GeneratePointOfInterest(int poiType);
 	PointOfInterest* GetPointOfInterestById(int poiId);
+	void InitializePointOfInterestPathDistances();
+	float GetPathDistanceBetweenPointsOfInterest(PointOfInterest* fromPoi, PointOfInterest* toPoi);
 
 	//bombardment  ----------------------------------------------
 	void DetectBombardmentToAgentCollision(Bombardment* bombardment);
@@ -111,31 +205,34 @@ public:
 	// fire ----------------------------------------------
 	bool DoesBombardmentStartFire();
 	Fire* GetFireById(int entityId);
-	void SpawnFire(Tile* spawnTile);
+	void SpawnFire(const IntVector2& coordinate);
 
 	//agent to tile collision  ----------------------------------------------
-	void DetectAgentToTileCollision(Agent* agent);
-	bool PushAgentOutOfTileNorth(Agent* agent, const IntVector2& tileCoordinate);
-	bool PushAgentOutOfTileSouth(Agent* agent, const IntVector2& tileCoordinate);
-	bool PushAgentOutOfTileEast(Agent* agent, const IntVector2& tileCoordinate);
-	bool PushAgentOutOfTileWest(Agent* agent, const IntVector2& tileCoordinate);
-
-	bool PushAgentOutOfTileNorthEast(Agent* agent, const IntVector2& tileCoordinate);
-	bool PushAgentOutOfTileNorthWest(Agent* agent, const IntVector2& tileCoordinate);
-	bool PushAgentOutOfTileSouthEast(Agent* agent, const IntVector2& tileCoordinate);
-	bool PushAgentOutOfTileSouthWest(Agent* agent, const IntVector2& tileCoordinate);
-
-	bool PushAgentOutOfTile(Agent* agent, const IntVector2& tileCoordinate, int tileDirection);
+	void ResolveAgentToTileCollisions(const std::vector<Agent*>& agents);
+	void RebuildTileCollisionMasks();
+	void UpdateTileCollisionMasksAroundCoordinate(const IntVector2& coordinate);
+	uint8_t GetTileCollisionMask(const IntVector2& coordinate) const;
 
 public:
 	std::string m_name;
 	IntVector2 m_dimensions;
 	MapDefinition* m_mapDefinition = nullptr;
 	SimulationDefinition* m_activeSimulationDefinition = nullptr;
-	std::vector<Tile*> m_tiles;
+
+	//tiles live in fixed size chunks of compact records. chunks that match their fill stay a single record
+	std::vector<TileChunk> m_tileChunks;
+	IntVector2 m_numTileChunks;
+	std::vector<Rgba> m_tileTints; //palette indexed by Tile::m_tintIndex
+	std::map<int, Tags> m_tileTags; //only the few tiles gen steps have tagged. keyed by tile index
 	Grid<int>* m_mapAsGrid = nullptr;
 	AABB2 m_mapWorldBounds;
 	bool m_isMapGridDirty = false;
+	uint32_t m_mapGridVersion = 0; //bumped whenever the grid changes so cached paths can be dropped
+	FreeSpaceIndex m_freeSpaceIndex; //built on first placement after the tiles are reset
+
+	//bit (1 << eTileDirection) is set when that neighbor blocks walking. empty until first collision pass after the tiles are reset
+	std::vector<uint8_t> m_tileCollisionMasks;
+	AgentTileCollisionBatch m_agentTileCollisionBatch;
 
 	//lists
 	std::vector<Agent*> m_agentsOrderedByPriority;
@@ -150,24 +247,67 @@ public:
 	std::vector<PointOfInterest*> m_medStations;
 	std::vector<PointOfInterest*> m_wells;
 
+	//path distance between every pair of poi access positions. row major by m_indexInPointOfInterestList
+	std::vector<float> m_pointOfInterestPathDistances;
+
 	std::vector<Bombardment*> m_activeBombardments;
 	std::vector<Fire*> m_fires;
 
 	//meshes for rendering
 	MeshBuilder* m_mapBuilder = nullptr;
 	MeshBuilder* m_debugBuilder = nullptr;
-	MeshBuilder* m_agentBuilder = nullptr;
 
-	Mesh* m_mapMesh = nullptr;
-	Mesh* m_debugMapMesh = nullptr;
+	//one mesh per tile chunk so a tile change only rebuilds its own chunk
+	std::vector<Mesh*> m_mapChunkMeshes;
+	std::vector<Mesh*> m_debugMapChunkMeshes;
 	Mesh* m_agentMesh = nullptr;
 
-	Stopwatch* m_bombardmentTimer = nullptr;
-	Stopwatch* m_threatTimer = nullptr;
-	Stopwatch* m_sortTimer = nullptr;
+	//resolved the first time an agent is made
+	IsoSpriteAnimSet* m_agentAnimationSet = nullptr;
+
+	Mesh* m_bombardmentMesh = nullptr;
+	Mesh* m_fireMesh = nullptr;
+	PooledDynamicMesh m_textMesh;
+
+	//simulation writes one snapshot per tick. the worker builds vertices from the newest and m_renderVertexFrame is the frame being drawn
+	RenderSnapshotBuffer m_renderSnapshots;
+	uint64_t m_renderSnapshotTick = 0;
+	RenderVertexWorker m_renderVertexWorker;
+	RenderVertexFrame* m_renderVertexFrame = nullptr;
+
+	//last view handed to the worker. nothing is culled until the playing state hands one over
+	AABB2 m_viewBounds;
+	bool m_isViewCulled = false;
+
+	//left out of the frame being drawn
+	int m_numAgentsCulled = 0;
+	int m_numFiresCulled = 0;
+	int m_numBombardmentsCulled = 0;
+
+	//every game timer on the map (agents, planners, poi, bombardments) lives in this wheel
+	TimingWheel m_timingWheel;
+	TimerHandle m_bombardmentTimer = INVALID_TIMER_HANDLE;
+	TimerHandle m_threatTimer = INVALID_TIMER_HANDLE;
+	TimerHandle m_sortTimer = INVALID_TIMER_HANDLE;
 
 	PlayingState* m_playingState = nullptr;
 
+	//resolved once per simulation from the definition's optimization flags
+	AgentUpdateFunction m_agentUpdateFunction = nullptr;
+	AgentPathFunction m_agentPathFunction = nullptr;
+
+	//low priority maintenance run with whatever is left of the agent update budget
+	SlackTaskQueue m_slackTaskQueue;
+
+	//seeded from the simulation definition. nothing in the sim should draw from the global rng
+	int m_randomSeed = 0;
+	RandomStream m_randomStreams[NUM_RANDOM_STREAMS];
+
+	//external inputs for the current frame. written while recording, read back while playing
+	ReplayLog m_replayLog;
+	ReplayFrame m_currentReplayFrame;
+	float m_simulationDeltaSeconds = 0.f;
+
 	float m_threat = 500.f;
 
 private:
@@ -13,6 +13,9 @@ public:
 	~MapGenStep() {};
 	virtual void Run( Map& map ) = 0; // "pure virtual", MUST be overridden by subclasses
 
+	//steps that read files hash them in so editing the file invalidates cached layouts
+	virtual void AppendArtifactKey(uint64_t& inOutKey) const { UNUSED(inOutKey); }
+
 public:
 	static MapGenStep* CreateMapGenStep( const tinyxml2::XMLElement& genStepXmlElement );
 
@@ -1,6 +1,8 @@
 #include "Game\Map\MapGenStep_CellularAutomata.hpp"
 #include "Engine\Core\ErrorWarningAssert.hpp"
 #include "Game/Map/Map.hpp"
+#include "Engine\Math\MathUtils.hpp"
+#include <thread>
 
 //  =========================================================================================
 MapGenStep_CellularAutomata::MapGenStep_CellularAutomata( const tinyxml2::XMLElement& generationStepElement )
@@ -18,6 +20,8 @@ MapGenStep_CellularAutomata::MapGenStep_CellularAutomata( const tinyxml2::XMLEle
 
 	m_chanceToMutate = ParseXmlAttribute(generationStepElement, "chanceToMutate", m_chanceToMutate);
 
+	//no range means any neighbor of the type will do
+	m_isAnyNeighborCount = generationStepElement.Attribute("ifNeighborCount") == nullptr;
 	m_ifNeighborCount = ParseXmlAttribute(generationStepElement, "ifNeighborCount", m_ifNeighborCount);
 	if(m_ifNeighborCount.max > 8)
 	{
@@ -32,118 +36,177 @@ MapGenStep_CellularAutomata::MapGenStep_CellularAutomata( const tinyxml2::XMLEle
 //  =========================================================================================
 void MapGenStep_CellularAutomata::Run( Map& map )
 {
-	std::vector<int> tileIndexesToChange;
-	
-	for(int tileIndex = 0; tileIndex < (int)map.m_tiles.size(); tileIndex++)
-	{	
-		if(map.m_tiles[tileIndex]->m_tileDefinition == m_ifType)
-		{
-			float randomChance = GetRandomFloatZeroToOne();
-			if(randomChance <= m_chanceToMutate)
-			{
-				if(m_ifNeighborType != nullptr)
-				{				
-					int neighborCount = 0;
-					std::vector<int> neighboringTiles = GetNeighboringTiles(tileIndex, map);
-					for(size_t neighboringTileIndex = 0; neighboringTileIndex < neighboringTiles.size(); neighboringTileIndex++)
-					{
-						int neighborIndex = neighboringTiles[neighboringTileIndex];
-						if(map.m_tiles[neighborIndex]->m_tileDefinition == m_ifNeighborType)
-						{
-							neighborCount++;
-						}
-					}
-					if(m_ifNeighborCount.min == -1 && m_ifNeighborCount.max == -1)
-					{
-						if(neighborCount > 0)
-						{
-							tileIndexesToChange.push_back(tileIndex);
-						}
-					}
-					else if(neighborCount >= m_ifNeighborCount.min && neighborCount <= m_ifNeighborCount.max)
-					{
-						tileIndexesToChange.push_back(tileIndex);
-					}
-				}
-				else
-				{
-					tileIndexesToChange.push_back(tileIndex);
-				}				
-			}		
-		}			
-	}
+	//one generation per Run. the map definition's iterations repeat the step
+	RandomStream& mapGenerationStream = map.GetRandomStream(MAP_GENERATION_RANDOM_STREAM);
 
-	for(size_t tileIndex = 0; tileIndex < tileIndexesToChange.size(); tileIndex++)
+	IntVector2 dimensions = map.GetDimensions();
+	m_wordsPerRow = (dimensions.x + 63) >> 6;
+	int numWords = (dimensions.y + 2) * m_wordsPerRow;
+
+	m_ifTypeBits.assign(numWords, 0);
+	m_neighborTypeBits.assign(numWords, 0);
+	m_chanceBits.assign(numWords, ~(uint64_t)0);
+	m_changedBits.assign(numWords, 0);
+
+	//one pass over the tiles to build the planes. row y lives at y + 1
+	for(int yCoordinate = 0; yCoordinate < dimensions.y; yCoordinate++)
 	{
-		int currentIndex = tileIndexesToChange[tileIndex];
+		uint64_t* ifTypeRow = &m_ifTypeBits[(yCoordinate + 1) * m_wordsPerRow];
+		uint64_t* neighborTypeRow = &m_neighborTypeBits[(yCoordinate + 1) * m_wordsPerRow];
 
-		map.m_tiles[currentIndex]->m_tileDefinition = m_changeToType;
+		for(int xCoordinate = 0; xCoordinate < dimensions.x; xCoordinate++)
+		{
+			const TileDefinition* definition = map.GetTileAtCoordinate(IntVector2(xCoordinate, yCoordinate))->GetDefinition();
+			uint64_t bit = (uint64_t)1 << (xCoordinate & 63);
+
+			if(definition == m_ifType)
+				ifTypeRow[xCoordinate >> 6] |= bit;
+			if(definition == m_ifNeighborType)
+				neighborTypeRow[xCoordinate >> 6] |= bit;
+		}
 	}
-}
 
-//  =========================================================================================
-std::vector<int> MapGenStep_CellularAutomata::GetNeighboringTiles(int currentTileIndex, const Map& map)
-{
-	std::vector<int> neighboringTilesIndexes;	
-	Vector2 currentTileCoords = map.m_tiles[currentTileIndex]->GetTileWorldPosition();
+	//hardware_concurrency is allowed to report 0 when it can't tell
+	int maxThreads = (int)std::thread::hardware_concurrency();
+	if(maxThreads < 1)
+		maxThreads = 1;
 
-	Vector2 eastTile = Vector2(currentTileCoords.x + 1, currentTileCoords.y);
-	int eastIndex = (eastTile.x * map.m_dimensions.y) + eastTile.y;
+	int numThreads = ClampInt(dimensions.y / CELLULAR_AUTOMATA_MIN_ROWS_PER_THREAD, 1, maxThreads);
+	int rowsPerThread = (dimensions.y + numThreads - 1) / numThreads;
 
-	if(eastIndex > 0 && eastIndex < (int)map.m_tiles.size())
+	//chance rolls stay on this thread in tile order so the stream is the same however many threads update
+	if(m_chanceToMutate < 1.f)
 	{
-		neighboringTilesIndexes.push_back(eastIndex);
-	}
-	
+		for(int wordIndex = m_wordsPerRow; wordIndex < numWords - m_wordsPerRow; wordIndex++)
+		{
+			uint64_t candidates = m_ifTypeBits[wordIndex];
+			uint64_t chanceWord = 0;
+			while(candidates != 0)
+			{
+				uint64_t lowestBit = candidates & (~candidates + 1);
+				if(mapGenerationStream.GetNextFloatZeroToOne() <= m_chanceToMutate)
+					chanceWord |= lowestBit;
 
-	Vector2 westTile = Vector2(currentTileCoords.x - 1 , currentTileCoords.y);
-	int westIndex = (westTile.x * map.m_dimensions.y) + westTile.y;
-	if(westIndex > 0 && westIndex < (int)map.m_tiles.size())
-	{
-		neighboringTilesIndexes.push_back(westIndex);
-	}
+				candidates ^= lowestBit;
+			}
 
-	Vector2 northTile = Vector2(currentTileCoords.x, currentTileCoords.y + 1);
-	int northIndex = (northTile.x * map.m_dimensions.y) + northTile.y;
-	if(northIndex > 0 && northIndex < (int)map.m_tiles.size())
-	{
-		neighboringTilesIndexes.push_back(northIndex);
+			m_chanceBits[wordIndex] = chanceWord;
+		}
 	}
 
-	Vector2 southTile = Vector2(currentTileCoords.x, currentTileCoords.y - 1);
-	int southIndex = (southTile.x * map.m_dimensions.y) + southTile.y;
-	if(southIndex > 0 && southIndex < (int)map.m_tiles.size())
+	if(numThreads == 1)
 	{
-		neighboringTilesIndexes.push_back(southIndex);
+		UpdateRows(0, dimensions.y);
 	}
-
-	Vector2 northEastTile = Vector2(currentTileCoords.x + 1, currentTileCoords.y + 1);
-	int northEastIndex = (northEastTile.x * map.m_dimensions.y) + northEastTile.y;
-	if(northEastIndex > 0 && northEastIndex < (int)map.m_tiles.size())
+	else
 	{
-		neighboringTilesIndexes.push_back(northEastIndex);
+		//planes are only read here. each thread only writes its own rows of the changed bits
+		std::vector<std::thread> threads;
+		for(int threadIndex = 0; threadIndex < numThreads; threadIndex++)
+		{
+			int startRow = threadIndex * rowsPerThread;
+			int endRow = ClampInt(startRow + rowsPerThread, 0, dimensions.y);
+			threads.push_back(std::thread(&MapGenStep_CellularAutomata::UpdateRows, this, startRow, endRow));
+		}
+
+		for(int threadIndex = 0; threadIndex < (int)threads.size(); threadIndex++)
+		{
+			threads[threadIndex].join();
+		}
 	}
 
-	Vector2 northWestTile = Vector2(currentTileCoords.x - 1, currentTileCoords.y + 1);
-	int northWestIndex = (northWestTile.x * map.m_dimensions.y) + northWestTile.y;
-	if(northWestIndex > 0 && northWestIndex < (int)map.m_tiles.size())
+	//write back only the tiles that changed
+	for(int yCoordinate = 0; yCoordinate < dimensions.y; yCoordinate++)
 	{
-		neighboringTilesIndexes.push_back(northWestIndex);
+		const uint64_t* changedRow = &m_changedBits[(yCoordinate + 1) * m_wordsPerRow];
+		for(int wordIndex = 0; wordIndex < m_wordsPerRow; wordIndex++)
+		{
+			uint64_t changedWord = changedRow[wordIndex];
+			for(int bitIndex = 0; changedWord != 0; bitIndex++, changedWord >>= 1)
+			{
+				if((changedWord & 1) != 0)
+					map.SetTileAtCoordinate(IntVector2((wordIndex << 6) + bitIndex, yCoordinate), m_changeToType);
+			}
+		}
 	}
 
-	Vector2 southEastTile = Vector2(currentTileCoords.x + 1, currentTileCoords.y - 1);
-	int southEastIndex = (southEastTile.x * map.m_dimensions.y) + southEastTile.y;
-	if(southEastIndex > 0 && southEastIndex < (int)map.m_tiles.size())
+	//don't hold onto big map planes between runs
+	std::vector<uint64_t>().swap(m_ifTypeBits);
+	std::vector<uint64_t>().swap(m_neighborTypeBits);
+	std::vector<uint64_t>().swap(m_chanceBits);
+	std::vector<uint64_t>().swap(m_changedBits);
+}
+
+//  =========================================================================================
+void MapGenStep_CellularAutomata::UpdateRows(int startRow, int endRow)
+{
+	for(int yCoordinate = startRow; yCoordinate < endRow; yCoordinate++)
 	{
-		neighboringTilesIndexes.push_back(southEastIndex);
+		int rowStart = (yCoordinate + 1) * m_wordsPerRow;
+
+		for(int wordIndex = 0; wordIndex < m_wordsPerRow; wordIndex++)
+		{
+			int index = rowStart + wordIndex;
+			uint64_t changeWord = m_ifTypeBits[index] & m_chanceBits[index];
+
+			if(changeWord != 0 && m_ifNeighborType != nullptr)
+			{
+				//bit sliced counter. bit n of neighborCountBits[k] is bit k of tile n's neighbor count
+				uint64_t neighborCountBits[4] = { 0, 0, 0, 0 };
+				uint64_t anyNeighborBits = 0;
+
+				for(int rowOffset = -1; rowOffset <= 1; rowOffset++)
+				{
+					int neighborIndex = index + (rowOffset * m_wordsPerRow);
+					uint64_t centerWord = m_neighborTypeBits[neighborIndex];
+					uint64_t westWord = wordIndex > 0 ? m_neighborTypeBits[neighborIndex - 1] : 0;
+					uint64_t eastWord = wordIndex < m_wordsPerRow - 1 ? m_neighborTypeBits[neighborIndex + 1] : 0;
+
+					uint64_t neighborWords[3] = { (centerWord << 1) | (westWord >> 63), (centerWord >> 1) | (eastWord << 63), centerWord };
+					int numNeighborWords = rowOffset == 0 ? 2 : 3;
+
+					for(int neighborWordIndex = 0; neighborWordIndex < numNeighborWords; neighborWordIndex++)
+					{
+						uint64_t carry = neighborWords[neighborWordIndex];
+						anyNeighborBits |= carry;
+
+						for(int countBitIndex = 0; countBitIndex < 4 && carry != 0; countBitIndex++)
+						{
+							uint64_t nextCarry = neighborCountBits[countBitIndex] & carry;
+							neighborCountBits[countBitIndex] ^= carry;
+							carry = nextCarry;
+						}
+					}
+				}
+
+				if(m_isAnyNeighborCount)
+					changeWord &= anyNeighborBits;
+				else
+					changeWord &= GetMatchingNeighborCountBits(neighborCountBits);
+			}
+
+			m_changedBits[index] = changeWord;
+		}
 	}
+}
 
-	Vector2 southWestTile = Vector2(currentTileCoords.x - 1, currentTileCoords.y - 1);
-	int southWestIndex = (southWestTile.x * map.m_dimensions.y) + southWestTile.y;
-	if(southWestIndex > 0 && southWestIndex < (int)map.m_tiles.size())
+//  =========================================================================================
+uint64_t MapGenStep_CellularAutomata::GetMatchingNeighborCountBits(const uint64_t* neighborCountBits) const
+{
+	uint64_t matchingBits = 0;
+	for(int neighborCount = m_ifNeighborCount.min; neighborCount <= m_ifNeighborCount.max; neighborCount++)
 	{
-		neighboringTilesIndexes.push_back(southWestIndex);
+		uint64_t countEqualBits = ~(uint64_t)0;
+		for(int countBitIndex = 0; countBitIndex < 4; countBitIndex++)
+		{
+			if((neighborCount >> countBitIndex) & 1)
+				countEqualBits &= neighborCountBits[countBitIndex];
+			else
+				countEqualBits &= ~neighborCountBits[countBitIndex];
+		}
+
+		matchingBits |= countEqualBits;
 	}
 
-	return neighboringTilesIndexes;
-}
\ No newline at end of file
+	return matchingBits;
+}
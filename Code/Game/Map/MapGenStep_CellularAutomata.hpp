@@ -3,6 +3,10 @@
 #include "Game\Map\MapGenStep.hpp"
 #include "Engine\Math\IntRange.hpp"
 #include <vector>
+#include <stdint.h>
+
+//below this many rows per thread the split costs more than it saves
+constexpr int CELLULAR_AUTOMATA_MIN_ROWS_PER_THREAD = 64;
 
 class MapGenStep_CellularAutomata : public MapGenStep
 {
@@ -11,7 +15,9 @@ public:
 	~MapGenStep_CellularAutomata() {};
 	void Run( Map& map ); // "pure virtual", MUST be overridden by subclasses
 
-	std::vector<int> GetNeighboringTiles(int currentTileIndex, const Map& map);
+private:
+	void UpdateRows(int startRow, int endRow);
+	uint64_t GetMatchingNeighborCountBits(const uint64_t* neighborCountBits) const;
 
 private:
 	std::string		m_name;
@@ -19,8 +25,14 @@ private:
 	TileDefinition* m_changeToType = nullptr;
 	TileDefinition* m_ifNeighborType = nullptr;
 	IntRange m_ifNeighborCount = IntRange(-1);
+	bool m_isAnyNeighborCount = true;
 	float m_chanceToMutate = 1.f;
 	float m_chanceToRun = 1.f;
-	IntRange m_iterations = IntRange(1);
 
+	//bitboards for the current Run. one bit per tile, rows padded to whole words with an empty row above and below the map
+	int m_wordsPerRow = 0;
+	std::vector<uint64_t> m_ifTypeBits;
+	std::vector<uint64_t> m_neighborTypeBits;
+	std::vector<uint64_t> m_chanceBits;
+	std::vector<uint64_t> m_changedBits;
 };
@@ -20,19 +20,19 @@ MapGenStep_FillAndEdge::MapGenStep_FillAndEdge( const tinyxml2::XMLElement& gene
 //  =========================================================================================
 void MapGenStep_FillAndEdge::Run( Map& map )
 {
+	//fill collapses every chunk back to a single record
+	map.FillTiles(m_fillTileDef);
+
 	//edge
-	for(int tileIndex = 0; tileIndex < (int)map.m_tiles.size(); tileIndex++)
+	for(int xCoordinate = 0; xCoordinate < map.m_dimensions.x; xCoordinate++)
 	{
-		int xCoordinate = map.m_tiles[tileIndex]->m_tileCoords.x;
-		int yCoordinate = map.m_tiles[tileIndex]->m_tileCoords.y;
+		map.SetTileAtCoordinate(IntVector2(xCoordinate, 0), m_edgeTileDef);
+		map.SetTileAtCoordinate(IntVector2(xCoordinate, map.m_dimensions.y - 1), m_edgeTileDef);
+	}
 
-		if(xCoordinate == 0 || xCoordinate == (map.m_dimensions.x - 1) || yCoordinate == 0 || yCoordinate == (map.m_dimensions.y - 1)) //if we are on the edge
-		{
-			map.m_tiles[tileIndex]->m_tileDefinition = m_edgeTileDef;		
-		}
-		else
-		{
-			map.m_tiles[tileIndex]->m_tileDefinition = m_fillTileDef;	
-		}
-	}	
+	for(int yCoordinate = 0; yCoordinate < map.m_dimensions.y; yCoordinate++)
+	{
+		map.SetTileAtCoordinate(IntVector2(0, yCoordinate), m_edgeTileDef);
+		map.SetTileAtCoordinate(IntVector2(map.m_dimensions.x - 1, yCoordinate), m_edgeTileDef);
+	}
 }
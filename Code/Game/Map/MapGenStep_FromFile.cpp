@@ -4,12 +4,27 @@
 #include <vector>
 #include "Game/GameCommon.hpp"
 #include "Game/Map/Map.hpp"
+#include "Game/Helpers/MapArtifactCache.hpp"
 
 MapGenStep_FromFile::MapGenStep_FromFile( const tinyxml2::XMLElement& generationStepElement )
 	: MapGenStep( generationStepElement )
 {
 	m_filename = ParseXmlAttribute(generationStepElement, "fileName", m_filename);
+}
+
+//  =========================================================================================
+void MapGenStep_FromFile::AppendArtifactKey(uint64_t& inOutKey) const
+{
+	//hashing the raw file is much cheaper than decoding it
+	inOutKey = HashArtifactString(m_filename, inOutKey);
+	HashArtifactFile("Data/Images/" + m_filename, inOutKey);
+}
 
+//  =========================================================================================
+void MapGenStep_FromFile::LoadTexels()
+{
+	//decoded on first use so maps that come from the cache never pay for it
+	m_areTexelsLoaded = true;
 	Image newMapImage = Image("Data/Images/" + m_filename);
 
 	m_imageBounds = newMapImage.GetDimensions();
@@ -22,8 +37,12 @@ MapGenStep_FromFile::MapGenStep_FromFile( const tinyxml2::XMLElement& generation
 	}
 }
 
+//  =========================================================================================
 void MapGenStep_FromFile::Run( Map& map )
 {
+	if(!m_areTexelsLoaded)
+		LoadTexels();
+
 	int tileReplacementStartIndex = 0;
 	int xDifference = 0;
 	int yDifference = 0;
@@ -31,38 +50,43 @@ void MapGenStep_FromFile::Run( Map& map )
 	int startingX = 0;
 	int startingY = 0;
 
+	RandomStream& mapGenerationStream = map.GetRandomStream(MAP_GENERATION_RANDOM_STREAM);
+
 	if(map.GetDimensions().x > m_imageBounds.x)
 	{
 		xDifference = map.GetDimensions().x - m_imageBounds.x;
-		startingX = GetRandomIntInRange(0, xDifference);
+		startingX = mapGenerationStream.GetNextIntInRange(0, xDifference);
 	}
 	if(map.GetDimensions().y > m_imageBounds.y)
 	{
 		yDifference = map.GetDimensions().y - m_imageBounds.y;
-		startingY = GetRandomIntInRange(0, yDifference);
+		startingY = mapGenerationStream.GetNextIntInRange(0, yDifference);
 	}	
 	
 	tileReplacementStartIndex = startingX * startingY;
+
+	//resolved once rather than per texel
+	TileDefinition* grassDefinition = TileDefinition::GetDefinitionByName("Grass");
 	
-	for(int tileIndex = tileReplacementStartIndex; tileIndex < (int)map.m_tiles.size(); tileIndex++)
+	for(int tileIndex = tileReplacementStartIndex; tileIndex < map.GetNumTiles(); tileIndex++)
 	{
 		TileDefinition* changeTileDef = nullptr;
 		Rgba color = m_texelRgbas[tileIndex];		
 		float colorAlpha = color.GetAlphaAsFloat();
 
-		float randomChance = GetRandomFloatZeroToOne();
+		float randomChance = mapGenerationStream.GetNextFloatZeroToOne();
 
 		if(randomChance < colorAlpha)
 		{
 			color.a = (unsigned char)255;
 			if(color == Rgba::GREEN)
 			{
-				changeTileDef = TileDefinition::s_tileDefinitions["Grass"];
+				changeTileDef = grassDefinition;
 			}
 
 			if(changeTileDef != nullptr)
 			{
-				map.m_tiles[tileIndex]->m_tileDefinition = changeTileDef;
+				map.SetTileAtCoordinate(map.GetTileCoordinateOfIndex(tileIndex), changeTileDef);
 			}
 		}		
 	}	
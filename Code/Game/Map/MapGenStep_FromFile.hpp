@@ -9,10 +9,15 @@ public:
 	explicit MapGenStep_FromFile( const tinyxml2::XMLElement& genStepXmlElement );
 	~MapGenStep_FromFile() {};
 	void Run( Map& map ); // "pure virtual", MUST be overridden by subclasses
+	void AppendArtifactKey(uint64_t& inOutKey) const override;
+
+private:
+	void LoadTexels();
 
 private:
 	std::string	m_name;
 	std::string m_filename = "invalid";
 	std::vector<Rgba> m_texelRgbas;
 	IntVector2 m_imageBounds;
+	bool m_areTexelsLoaded = false;
 };
@@ -15,25 +15,21 @@ MapGenStep_Mutate::MapGenStep_Mutate( const tinyxml2::XMLElement& generationStep
 
 void MapGenStep_Mutate::Run( Map& map )
 {
-	for(int tileIndex = 0; tileIndex < (int)map.m_tiles.size(); tileIndex++)
+	RandomStream& mapGenerationStream = map.GetRandomStream(MAP_GENERATION_RANDOM_STREAM);
+
+	for(int tileIndex = 0; tileIndex < map.GetNumTiles(); tileIndex++)
 	{		
-		float randomChance = GetRandomFloatZeroToOne();
+		float randomChance = mapGenerationStream.GetNextFloatZeroToOne();
 		if(randomChance < m_chanceToMutate)
 		{
-			if(m_ifTags != "")
-			{
-				if(map.m_tiles[tileIndex]->m_tags.HasTags(m_ifTags))
-				{
-					map.m_tiles[tileIndex]->m_tileDefinition = m_mutateTileDef;
-					map.m_tiles[tileIndex]->m_tags.SetOrRemoveTags(m_setTags);
-				}						
-			}
-			else
-			{
-				map.m_tiles[tileIndex]->m_tileDefinition = m_mutateTileDef;
-				map.m_tiles[tileIndex]->m_tags.SetOrRemoveTags(m_setTags);
-			}
-			
+			if(m_ifTags != "" && !map.DoesTileHaveTags(tileIndex, m_ifTags))
+				continue;
+
+			map.SetTileAtCoordinate(map.GetTileCoordinateOfIndex(tileIndex), m_mutateTileDef);
+
+			//tags are sparse so untagged tiles never get an entry
+			if(m_setTags != "")
+				map.GetTileTagsAtIndex(tileIndex).SetOrRemoveTags(m_setTags);
 		}			
 	}
 }
@@ -1,43 +1,93 @@
 #include "Game\Map\Tile.hpp"
-#include "Game\GameCommon.hpp"
-#include "Engine\Renderer\Renderer.hpp"
-#include "Engine\Renderer\Renderable2D.hpp"
-#include "Engine\Renderer\MeshBuilder.hpp"
-#include "Engine\Window\Window.hpp"
-#include "Game\GameCommon.hpp"
-#include "Engine\Core\StringUtils.hpp"
 
 //  =========================================================================================
-Tile::Tile()
+Tile::Tile(const TileDefinition* definition, uint8_t tintIndex)
 {
+	m_definitionIndex = definition->m_index;
+	m_tintIndex = tintIndex;
+
+	if (definition->m_allowsWalking)
+		m_flags |= TILE_ALLOWS_WALKING_FLAG;
+	if (definition->m_allowsBuilding)
+		m_flags |= TILE_ALLOWS_BUILDING_FLAG;
+	if (definition->m_isFire)
+		m_flags |= TILE_IS_FIRE_FLAG;
+	if (definition->m_isHazard)
+		m_flags |= TILE_IS_HAZARD_FLAG;
+	if (definition->m_isBuilding)
+		m_flags |= TILE_IS_BUILDING_FLAG;
 }
 
 //  =========================================================================================
-Tile::~Tile()
+void TileChunk::Initialize(const Tile& fillTile, int numTilesInBoundsX, int numTilesInBoundsY)
 {
-	m_tileDefinition = nullptr;
+	m_numTilesInBoundsX = numTilesInBoundsX;
+	m_numTilesInBoundsY = numTilesInBoundsY;
+	Fill(fillTile);
 }
 
 //  =========================================================================================
-void Tile::Initialize()
+void TileChunk::Fill(const Tile& fillTile)
 {
+	//drop back to a single record
+	std::vector<Tile>().swap(m_tiles);
+	m_fillTile = fillTile;
+
+	m_numBlockingTiles = 0;
+	CountTile(fillTile, m_numTilesInBoundsX * m_numTilesInBoundsY);
+
+	m_isGridDirty = true;
+	m_isMeshDirty = true;
+	m_isDebugMeshDirty = true;
 }
 
 //  =========================================================================================
-AABB2 Tile::GetBounds()
+void TileChunk::SetTile(int localIndex, const Tile& tile)
 {
-	Vector2 tileMins = GetTileWorldPosition();
-	return AABB2(tileMins, tileMins + Vector2::ONE);	
+	const Tile& oldTile = GetTile(localIndex);
+	if (oldTile == tile)
+		return;
+
+	CountTile(oldTile, -1);
+	CountTile(tile, 1);
+
+	if (oldTile.AllowsWalking() != tile.AllowsWalking())
+		m_isGridDirty = true;
+
+	//both meshes are tinted per tile so any change shows up in them
+	m_isMeshDirty = true;
+	m_isDebugMeshDirty = true;
+
+	//first differing tile allocates the chunk
+	if (m_tiles.empty())
+		m_tiles.assign(TILES_PER_CHUNK, m_fillTile);
+
+	m_tiles[localIndex] = tile;
 }
 
 //  =========================================================================================
-void Tile::Render()
+void TileChunk::SetTiles(const Tile* tiles)
 {
-	Renderer* theRenderer = Renderer::GetInstance();
+	m_tiles.assign(tiles, tiles + TILES_PER_CHUNK);
+
+	//records past the map edge are never counted
+	m_numBlockingTiles = 0;
+	for (int localY = 0; localY < m_numTilesInBoundsY; ++localY)
+	{
+		for (int localX = 0; localX < m_numTilesInBoundsX; ++localX)
+		{
+			CountTile(m_tiles[localX + (localY << TILE_CHUNK_SIZE_BITS)], 1);
+		}
+	}
 
-	theRenderer->DrawTexturedAABB(GetBounds(), *theRenderer->CreateOrGetTexture("Data/Images/Terrain_8x8.png"), m_tileDefinition->m_baseSpriteUVCoords.mins, m_tileDefinition->m_baseSpriteUVCoords.maxs, m_tint);
-	
-	theRenderer->SetTexture(*theRenderer->CreateOrGetTexture("default"));
+	m_isGridDirty = true;
+	m_isMeshDirty = true;
+	m_isDebugMeshDirty = true;
+}
 
-	theRenderer = nullptr;
+//  =========================================================================================
+void TileChunk::CountTile(const Tile& tile, int count)
+{
+	if (!tile.AllowsWalking())
+		m_numBlockingTiles += count;
 }
@@ -1,35 +1,91 @@
 #pragma once
-#include "Engine\Math\IntVector2.hpp"
-#include "Engine\Utility\Tags.hpp"
-#include "Engine\Math\AABB2.hpp"
-#include "Engine\Core\Widget.hpp"
 #include "Game\Definitions\TileDefinition.hpp"
-#include "Engine\Core\Rgba.hpp"
+#include <stdint.h>
 #include <vector>
 
+//tiles are stored in square chunks so big maps only pay for the regions that differ from their fill
+constexpr int TILE_CHUNK_SIZE_BITS = 5;
+constexpr int TILE_CHUNK_SIZE = 1 << TILE_CHUNK_SIZE_BITS;
+constexpr int TILE_CHUNK_MASK = TILE_CHUNK_SIZE - 1;
+constexpr int TILES_PER_CHUNK = TILE_CHUNK_SIZE * TILE_CHUNK_SIZE;
 
-class Tile //:public Widget
+//copied from the definition so hot checks don't chase the definition pointer
+enum eTileFlags
 {
-public:
+	TILE_ALLOWS_WALKING_FLAG = 1 << 0,
+	TILE_ALLOWS_BUILDING_FLAG = 1 << 1,
+	TILE_IS_FIRE_FLAG = 1 << 2,
+	TILE_IS_HAZARD_FLAG = 1 << 3,
+	TILE_IS_BUILDING_FLAG = 1 << 4
+};
 
-	Tile();
-	Tile(const std::string& name)// : Widget(name)
-	{
-		//board creation
-	}
+//compact per tile record. definition and tint are indices into TileDefinition::s_tileDefinitionsByIndex and the map's tint palette
+struct Tile
+{
+	Tile() {}
+	Tile(const TileDefinition* definition, uint8_t tintIndex);
 
-	~Tile();
-	void Initialize();
+	TileDefinition* GetDefinition() const { return TileDefinition::s_tileDefinitionsByIndex[m_definitionIndex]; }
+	bool AllowsWalking() const { return (m_flags & TILE_ALLOWS_WALKING_FLAG) != 0; }
+	bool AllowsBuilding() const { return (m_flags & TILE_ALLOWS_BUILDING_FLAG) != 0; }
+	bool IsFire() const { return (m_flags & TILE_IS_FIRE_FLAG) != 0; }
+	bool IsHazard() const { return (m_flags & TILE_IS_HAZARD_FLAG) != 0; }
+	bool IsBuilding() const { return (m_flags & TILE_IS_BUILDING_FLAG) != 0; }
 
-	void SetTileType(TileDefinition* newTileDefintion){ m_tileDefinition = newTileDefintion;}
-	Vector2 GetTileWorldPosition(){ return Vector2(m_tileCoords);}
-	AABB2 GetBounds();
+	bool operator==(const Tile& other) const { return m_definitionIndex == other.m_definitionIndex && m_tintIndex == other.m_tintIndex; }
+	bool operator!=(const Tile& other) const { return !(*this == other); }
 
-	void Render();
+	uint8_t m_definitionIndex = 0;
+	uint8_t m_flags = 0;
+	uint8_t m_tintIndex = 0;
+};
 
+//  ----------------------------------------------
+class TileChunk
+{
 public:
-	IntVector2 m_tileCoords;
-	TileDefinition* m_tileDefinition = nullptr;
-	Tags m_tags;
-	Rgba m_tint = Rgba::WHITE;
-};
\ No newline at end of file
+	void Initialize(const Tile& fillTile, int numTilesInBoundsX, int numTilesInBoundsY);
+	void Fill(const Tile& fillTile);
+
+	const Tile& GetTile(int localIndex) const { return m_tiles.empty() ? m_fillTile : m_tiles[localIndex]; }
+	void SetTile(int localIndex, const Tile& tile);
+	void SetTiles(const Tile* tiles); //copies a full chunk of records
+
+	//nullptr while the chunk is uniform
+	const Tile* GetTileData() const { return m_tiles.empty() ? nullptr : m_tiles.data(); }
+	const Tile& GetFillTile() const { return m_fillTile; }
+
+	static int GetLocalIndex(int xCoordinate, int yCoordinate) { return (xCoordinate & TILE_CHUNK_MASK) + ((yCoordinate & TILE_CHUNK_MASK) << TILE_CHUNK_SIZE_BITS); }
+
+	//region queries so grid writes can skip whole chunks
+	bool IsUniform() const { return m_tiles.empty(); }
+	bool IsAllWalkable() const { return m_numBlockingTiles == 0; }
+
+	bool IsGridDirty() const { return m_isGridDirty; }
+	void SetGridDirty(bool isGridDirty) { m_isGridDirty = isGridDirty; }
+
+	bool IsMeshDirty() const { return m_isMeshDirty; }
+	void SetMeshDirty(bool isMeshDirty) { m_isMeshDirty = isMeshDirty; }
+	bool IsDebugMeshDirty() const { return m_isDebugMeshDirty; }
+	void SetDebugMeshDirty(bool isDebugMeshDirty) { m_isDebugMeshDirty = isDebugMeshDirty; }
+
+private:
+	void CountTile(const Tile& tile, int count);
+
+private:
+	//empty until a tile differs from the fill
+	std::vector<Tile> m_tiles;
+	Tile m_fillTile;
+
+	//edge chunks hang off the map so only in bounds tiles are counted
+	int m_numTilesInBoundsX = 0;
+	int m_numTilesInBoundsY = 0;
+	int m_numBlockingTiles = 0;
+
+	//the map's pathing grid needs this chunk rewritten
+	bool m_isGridDirty = true;
+
+	//the chunk's tile and debug meshes need rebuilding
+	bool m_isMeshDirty = true;
+	bool m_isDebugMeshDirty = true;
+};
@@ -3,6 +3,7 @@
 #include "Game\GameCommon.hpp"
 #include "Engine\Core\StringUtils.hpp"
 #include "Engine\Core\EngineCommon.hpp"
+#include "Engine\Time\Time.hpp"
 
 
 
@@ -87,21 +88,75 @@ void SimulationData::WriteGeneralData()
 
 	AddCell(Stringf("%s: %s", BUDGETED_OUTPUT_TEXT, budgetedText.c_str()));
 	AddNewLine();
+
+	//tunables (swept alongside the definition values)
+	AddCell(Stringf("%s: %i", UTILITY_STORAGE_DIVISIONS_OUTPUT_TEXT, m_simulationDefinitionReference->m_utilityStorageDivisions));
+	AddNewLine();
+
+	AddCell(Stringf("%s: %f", SORT_TIMER_OUTPUT_TEXT, m_simulationDefinitionReference->m_sortTimerInSeconds));
+	AddNewLine();
+
+	AddCell(Stringf("%s: %f", AGENT_COPY_RADIUS_OUTPUT_TEXT, m_simulationDefinitionReference->m_agentCopyDestinationPositionRadius));
+	AddNewLine();
+
+	AddCell(Stringf("%s: %f", PLANNING_SLICE_BUDGET_OUTPUT_TEXT, m_simulationDefinitionReference->m_planningSliceBudgetInSeconds));
+	AddNewLine();
+
+	AddCell(Stringf("%s: %i", RANDOM_SEED_OUTPUT_TEXT, m_simulationDefinitionReference->m_randomSeed));
+	AddNewLine();
 }
 
 
 //  =============================================================================
 bool SimulationData::ExportCSV(const std::string& filePath, const std::string& fileName)
 {
+	WriteSamples();
+
 	bool success = WriteToFile(Stringf("%s%s", filePath.c_str(), fileName.c_str()));
 	ResetData();
 
 	return success;
 }
 
+//  =============================================================================
+bool SimulationData::ExportLatencyPercentilesCSV(const std::string& filePath, const std::string& fileName)
+{
+	//count, min, p50, p90, p99, p99.9, max. durations in seconds
+	CSVEditor percentilesEditor;
+	percentilesEditor.AddCell(Stringf("%i", (int)m_latencyHistogram.GetTotalCount()), true);
+	percentilesEditor.AddCell(Stringf("%f", (float)PerformanceCounterToSeconds(m_latencyHistogram.GetMinValue())), true);
+
+	for (int percentileIndex = 0; percentileIndex < NUM_LATENCY_PERCENTILES; ++percentileIndex)
+	{
+		uint64_t percentileHPC = m_latencyHistogram.GetValueAtPercentile(g_latencyPercentileValues[percentileIndex]);
+		percentilesEditor.AddCell(Stringf("%f", (float)PerformanceCounterToSeconds(percentileHPC)), true);
+	}
+
+	percentilesEditor.AddCell(Stringf("%f", (float)PerformanceCounterToSeconds(m_latencyHistogram.GetMaxValue())), true);
+
+	return percentilesEditor.WriteToFile(Stringf("%s%s", filePath.c_str(), fileName.c_str()));
+}
+
 //  =============================================================================
 void SimulationData::ResetData()
 {
 	ClearContent();
+	m_samples.clear();
+	m_latencyHistogram.Reset();
+}
+
+//  =============================================================================
+void SimulationData::WriteSamples()
+{
+	for (int sampleIndex = 0; sampleIndex < (int)m_samples.size(); ++sampleIndex)
+	{
+		//check to see if we are at capacity. If so we can skip adding cells
+		if (IsAtCapacity())
+			break;
+
+		AddCell(Stringf("%f", (float)PerformanceCounterToSeconds(m_samples[sampleIndex])), true);
+	}
+
+	m_samples.clear();
 }
 
@@ -3,7 +3,10 @@
 #include <string>
 #include "Engine\File\CSVEditor.hpp"
 #include "Game\Definitions\SimulationDefinition.hpp"
+#include "Game\Helpers\LatencyHistogram.hpp"
 
+//caps the raw samples kept per file. the csv itself still stops at its own capacity when they are formatted
+constexpr size_t MAX_SIMULATION_SAMPLES = 1 << 20;
 
 class SimulationData : public CSVEditor
 {
@@ -16,10 +19,20 @@ public:
 	void WriteGeneralData();
 
 	bool ExportCSV(const std::string& filePath, const std::string& fileName);
+	bool ExportLatencyPercentilesCSV(const std::string& filePath, const std::string& fileName);
 	void ResetData();
 
+private:
+	void WriteSamples();
+
 public:
 	SimulationDefinition* m_simulationDefinitionReference = nullptr;
 	uint64_t m_count = 0;
+
+	//raw hpc durations filled by the analysis sample writer. only formatted on export
+	std::vector<uint64_t> m_samples;
+
+	//every recorded duration from every thread. written next to the samples as percentiles
+	LatencyHistogram m_latencyHistogram;
 };
 
@@ -2,6 +2,8 @@
 #include "Engine\Renderer\Renderer.hpp";
 #include "Engine\Math\AABB2.hpp"
 
+std::map<std::string, IsoSprite*> IsoSprite::s_isoSprites;
+
 IsoSprite::IsoSprite(IsoSpriteDefinition* definition)
 {
 	m_definition = definition;
@@ -15,6 +17,38 @@ IsoSprite::IsoSprite(IsoSpriteDefinition* definition)
 			m_sprites.push_back(new Sprite(spriteDefinition));
 		}
 	}
+
+	//sources should be unique so each facing maps to at most one sprite
+	for(int facingIndex = 0; facingIndex < (int)m_definition->m_facingStructs.size(); facingIndex++)
+	{
+		Sprite* facingSprite = nullptr;
+		for(int spriteIndex = 0; spriteIndex < (int)m_sprites.size(); spriteIndex++)
+		{
+			if(m_sprites[spriteIndex]->m_definition->m_id == m_definition->m_facingStructs[facingIndex].m_src)
+			{
+				facingSprite = m_sprites[spriteIndex];
+				break;
+			}
+		}
+
+		m_spritesByFacing.push_back(facingSprite);
+	}
+}
+
+IsoSprite* IsoSprite::CreateOrGetIsoSprite(const std::string& isoSpriteId)
+{
+	std::map<std::string, IsoSprite*>::iterator isoSpriteIterator = s_isoSprites.find(isoSpriteId);
+	if(isoSpriteIterator != s_isoSprites.end())
+		return isoSpriteIterator->second;
+
+	IsoSpriteDefinition* isoSpriteDefinition = GetIsoSpriteDefinitionById(isoSpriteId);
+	if(isoSpriteDefinition == nullptr)
+		return nullptr;
+
+	IsoSprite* newIsoSprite = new IsoSprite(isoSpriteDefinition);
+	s_isoSprites[isoSpriteId] = newIsoSprite;
+
+	return newIsoSprite;
 }
 
 IntVector2 IsoSprite::GetDimensionsForDirection(IntVector2 direction)
@@ -82,20 +116,15 @@ Texture* IsoSprite::GetCurrentTextureByDirection(IntVector2 direction)
 
 Sprite* IsoSprite::GetCurrentSpriteByDirection(IntVector2 direction)
 {
-	std::string source = m_definition->GetSourceByDirection(direction);
-
-	for(int spriteIndex = 0; spriteIndex < (int)m_sprites.size(); spriteIndex++)
+	for(int facingIndex = 0; facingIndex < (int)m_spritesByFacing.size(); facingIndex++)
 	{
-		SpriteDefinition* spriteDefinition = m_sprites[spriteIndex]->m_definition;
-		if(source == spriteDefinition->m_id)
+		if(m_definition->m_facingStructs[facingIndex].m_direction == direction)
 		{
-			spriteDefinition = nullptr;
-
-			return m_sprites[spriteIndex];
-
+			return m_spritesByFacing[facingIndex];
 		}
-		spriteDefinition = nullptr;
 	}
+
+	return nullptr;
 }
 
 IntVector2 IsoSprite::GetCurrentSpriteScaleByDirection(IntVector2 direction)
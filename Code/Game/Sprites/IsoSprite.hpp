@@ -11,6 +11,7 @@ class IsoSprite
 {
 public:
 	explicit IsoSprite(IsoSpriteDefinition* isoDefinition);
+	static IsoSprite* CreateOrGetIsoSprite(const std::string& isoSpriteId);
 	IntVector2 IsoSprite::GetDimensionsForDirection(IntVector2 direction);
 	IsoSpriteDefinition* GetIsoSpriteDefinition() const;
 	AABB2 GetCurrentUVsByDirection(IntVector2 direction);
@@ -21,5 +22,10 @@ public:
 private:
 	IsoSpriteDefinition* m_definition;
 	std::vector<Sprite*> m_sprites;
+
+	//sprite for each of the definition's facings so direction lookups don't compare source names
+	std::vector<Sprite*> m_spritesByFacing;
+
+	static std::map<std::string, IsoSprite*> s_isoSprites;
 };
 
@@ -2,106 +2,65 @@
 #include "Engine\Core\EngineCommon.hpp"
 #include "Engine\Profiler\Profiler.hpp"
 
+std::map<std::string, IsoSpriteAnim*> IsoSpriteAnim::s_anims;
+
 //  =============================================================================
-IsoSpriteAnim::IsoSpriteAnim( IsoSpriteAnimDefinition* animDef, float totalAnimationTime)
+IsoSpriteAnim::IsoSpriteAnim( IsoSpriteAnimDefinition* animDef )
 {
 	m_animDef = animDef;
-	m_elapsedSeconds = 0.0f;
-	m_isPlaying = true;
-	m_isFinished = false;
-	m_totalAnimationTime = animDef->GetDuration();
+	m_duration = animDef->GetDuration();
 
+	float frameEndTime = 0.f;
 	for(int isoSpriteIndex = 0; isoSpriteIndex < animDef->m_frameStructs.size(); isoSpriteIndex++)
 	{
-		IsoSpriteDefinition* isoSriteDefinition = GetIsoSpriteDefinitionById(m_animDef->m_frameStructs[isoSpriteIndex].m_frameSource);
+		frameEndTime += m_animDef->m_frameStructs[isoSpriteIndex].m_animationTimePercentage;
 
-		if(isoSriteDefinition != nullptr)
+		//iso sprites are shared between every animation that shows the same frame
+		IsoSprite* isoSprite = IsoSprite::CreateOrGetIsoSprite(m_animDef->m_frameStructs[isoSpriteIndex].m_frameSource);
+		if(isoSprite != nullptr)
 		{
-			TODO("Could manage this like a texutre and do a CreateOrGetIsoSprite/CreateOrGetSprite so that we aren't creating identical copies of the same sprites across animations");
-			m_isoSprites.push_back(new IsoSprite(isoSriteDefinition));
+			m_isoSprites.push_back(isoSprite);
+			m_frameEndTimes.push_back(frameEndTime);
 		}
 	}
 }
 
 //  =============================================================================
-void IsoSpriteAnim::Update( float deltaSeconds )
+IsoSpriteAnim::~IsoSpriteAnim()
 {
-	//PROFILER_PUSH();
-
-	m_elapsedSeconds += deltaSeconds;
-	float fractionelapsed = GetFractionElapsed();
-	if(fractionelapsed >= 1.f)
-	{
-		if(m_animDef->m_doesLoop == true)
-		{
-			m_elapsedSeconds = 0.0f;
-			PlayFromStart();
-		}
-		else
-		{
-			m_isFinished = true;
-			m_isPlaying = false;		
-		}				
-	}
-	else
-	{
-		m_currentIsoSpriteIndex = GetCurrentIsoSpriteIndex();
-	}
+	//iso sprites belong to IsoSprite's cache
+	m_isoSprites.clear();
 }
 
 //  =============================================================================
-int IsoSpriteAnim::GetCurrentIsoSpriteIndex()	
+IsoSpriteAnim* IsoSpriteAnim::CreateOrGetAnim( const std::string& animId )
 {
-	return GetIsoSpriteIndexForTime(m_elapsedSeconds);
-}
+	std::map<std::string, IsoSpriteAnim*>::iterator animIterator = s_anims.find(animId);
+	if(animIterator != s_anims.end())
+		return animIterator->second;
 
-//  =============================================================================
-void IsoSpriteAnim::PlayFromStart()
-{
-	m_elapsedSeconds = 0.0f;
-	m_isFinished = false;
-	m_isPlaying = true;	
-}
+	std::map<std::string, IsoSpriteAnimDefinition*>::iterator defIterator = IsoSpriteAnimDefinition::s_isoSpriteAnimDefinitions.find(animId);
+	if(defIterator == IsoSpriteAnimDefinition::s_isoSpriteAnimDefinitions.end())
+		return nullptr;
 
-//  =============================================================================
-float IsoSpriteAnim::GetSecondsRemaining() const
-{
-	return m_totalAnimationTime - m_elapsedSeconds;
-}
+	IsoSpriteAnim* newAnim = new IsoSpriteAnim(defIterator->second);
+	s_anims[animId] = newAnim;
 
-//  =============================================================================
-float IsoSpriteAnim::GetFractionElapsed() const
-{
-	return m_elapsedSeconds/m_animDef->GetDuration();
+	return newAnim;
 }
 
 //  =============================================================================
-float IsoSpriteAnim::GetFractionRemaining() const
+int IsoSpriteAnim::GetFrameIndexForTime(float elapsedSeconds) const
 {
-	return 1.0f - (m_elapsedSeconds/m_totalAnimationTime);
-}
-
-//  =============================================================================
-float IsoSpriteAnim::GetFractionElapsedForTime(float time) const
-{
-	if(m_totalAnimationTime == 0)
+	for(int frameIndex = 0; frameIndex < (int)m_frameEndTimes.size(); frameIndex++)
 	{
-		return 0.f;
+		if(elapsedSeconds <= m_frameEndTimes[frameIndex])
+		{
+			return frameIndex;
+		}
 	}
 
-	return time/m_totalAnimationTime;
-}
-
-//  =============================================================================
-void IsoSpriteAnim::SetSecondsElapsed( float secondsElapsed )   
-{
-	m_elapsedSeconds = secondsElapsed;
-}
-
-//  =============================================================================
-void IsoSpriteAnim::SetFractionElapsed( float fractionElapsed )
-{
-	m_elapsedSeconds = fractionElapsed * m_totalAnimationTime;
+	return (int)m_frameEndTimes.size() - 1;
 }
 
 //  =============================================================================
@@ -109,28 +68,3 @@ std::string IsoSpriteAnim::GetName() const
 {
 	return m_animDef->m_id;
 }
-
-//  =============================================================================
-int IsoSpriteAnim::GetIsoSpriteIndexForTime(float time)
-{
-	//float percentageElapsed = GetFractionElapsedForTime(time);
-	float currentSum = 0.f;
-
-	for(int isoSpriteIndex = 0; isoSpriteIndex < (int)m_animDef->m_frameStructs.size(); isoSpriteIndex++)
-	{
-		currentSum += m_animDef->m_frameStructs[isoSpriteIndex].m_animationTimePercentage;
-
-		if(m_elapsedSeconds <= currentSum)
-		{
-			return isoSpriteIndex;
-		}
-	}
-
-	return (int)m_animDef->m_frameStructs.size() - 1;
-}
-
-//  =============================================================================
-void IsoSpriteAnim::SetTotalTime(float totalTimeToPlay)
-{
-	m_totalAnimationTime = totalTimeToPlay;
-}
\ No newline at end of file
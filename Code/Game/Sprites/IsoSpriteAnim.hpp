@@ -1,44 +1,32 @@
+#pragma once
 #include "Game\Definitions\SpriteDefinitions\IsoSpriteAnimDefinition.hpp"
 #include "Engine\Renderer\Texture.hpp"
 #include "Engine\Math\AABB2.hpp"
 #include "Game\Sprites\IsoSprite.hpp"
 
+//shared frame data for one animation definition. playback time lives with whoever is playing it (see IsoSpriteAnimState)
 class IsoSpriteAnim
 {
 public:
-	IsoSpriteAnim( IsoSpriteAnimDefinition* animDef, float totalAnimationTime);
+	explicit IsoSpriteAnim( IsoSpriteAnimDefinition* animDef );
 	~IsoSpriteAnim();
 
-	void Update( float deltaSeconds );
-	void PlayFromStart();
-	bool IsFinished() const { return m_isFinished; }
-	float GetElapsedSeconds() const { return m_elapsedSeconds; }
-	float GetFractionElapsed() const; // Hint: Asks its SpriteAnimDefinition for total duration
-	float GetSecondsRemaining() const;
-	float GetFractionRemaining() const;
-	float GetFractionElapsedForTime(float time) const;
-	void SetSecondsElapsed( float secondsElapsed );
-	void SetFractionElapsed( float fractionElapsed );
-	void SetTotalTime(float totalTimeToPlay);
+	static IsoSpriteAnim* CreateOrGetAnim( const std::string& animId );
 
-	int GetIsoSpriteIndexForTime(float time);
-
-	int GetCurrentIsoSpriteIndex();
+	float GetDuration() const { return m_duration; }
+	bool DoesLoop() const { return m_animDef->m_doesLoop; }
+	int GetNumFrames() const { return (int)m_isoSprites.size(); }
+	int GetFrameIndexForTime(float elapsedSeconds) const;
+	IsoSprite* GetIsoSprite(int frameIndex) const { return m_isoSprites[frameIndex]; }
 	std::string GetName() const;
 
-	//TODO: Might be some useful functions later
-	//void Resume()
-	//void Pause()
-	//	const Texture* GetTexture(IntVector2 direction) const;
-
 protected:
 	IsoSpriteAnimDefinition* m_animDef = nullptr;
-	int m_currentIsoSpriteIndex;
-	bool m_isPlaying = true;
-	bool m_isFinished = false;
-	float m_elapsedSeconds = 0.f;
-	float m_totalAnimationTime = 0.f;
+	float m_duration = 0.f;
 
-public:
+	//running sum of frame durations. parallel to m_isoSprites
+	std::vector<float> m_frameEndTimes;
 	std::vector<IsoSprite*> m_isoSprites;
+
+	static std::map<std::string, IsoSpriteAnim*> s_anims;
 };
@@ -1,102 +1,111 @@
 #include "Game\Sprites\IsoSpriteAnimSet.hpp"
+#include "Engine\Core\ErrorWarningAssert.hpp"
 #include "Engine\Core\StringUtils.hpp"
 #include "Engine\Profiler\Profiler.hpp"
 
+std::map<std::string, IsoSpriteAnimSet*> IsoSpriteAnimSet::s_animSets;
+
+//matches the set ids in the anim set definition files
+static const char* s_animationTypeNames[NUM_ANIMATION_TYPES] =
+{
+	"idle",
+	"walk",
+	"cast",
+	"shoot",
+	"die",
+	"stand",
+	"heal"
+};
+
 //  =========================================================================================
 IsoSpriteAnimSet::IsoSpriteAnimSet( IsoSpriteAnimSetDefinition* animSetDef )
 {
 	m_animSetDef = animSetDef;
 
-	std::map<std::string, IsoSpriteAnimDefinition*>::iterator defIterator = IsoSpriteAnimDefinition::s_isoSpriteAnimDefinitions.begin();
-
-	// Iterate over the map using Iterator till end.
-	while (defIterator != IsoSpriteAnimDefinition::s_isoSpriteAnimDefinitions.end())
-	{	
-		IsoSpriteAnim* newAnim = new IsoSpriteAnim(defIterator->second, 1.0f);
-		m_namedAnims[defIterator->first] = newAnim;
-		defIterator++;
+	for (int animationType = 0; animationType < NUM_ANIMATION_TYPES; ++animationType)
+	{
+		std::string animId = m_animSetDef->GetAnimationIdBySimplifiedName(s_animationTypeNames[animationType]);
+		m_anims[animationType] = IsoSpriteAnim::CreateOrGetAnim(animId);
 	}
 
-	SetCurrentAnim("idle"); //idle is our default.  If we don't find and idle, it doesn't set one.
+	//idle is our default
+	ASSERT_OR_DIE(m_anims[IDLE_ANIMATION_TYPE] != nullptr, Stringf("ANIM SET %s HAS NO IDLE", m_animSetDef->m_id.c_str()).c_str());
+	for (int animationType = 0; animationType < NUM_ANIMATION_TYPES; ++animationType)
+	{
+		if (m_anims[animationType] == nullptr)
+			m_anims[animationType] = m_anims[IDLE_ANIMATION_TYPE];
+	}
 }
 
 //  =========================================================================================
-void IsoSpriteAnimSet::Update( float deltaSeconds )
+IsoSpriteAnimSet* IsoSpriteAnimSet::CreateOrGetAnimSet( const std::string& animSetId )
 {
-	PROFILER_PUSH();
+	std::map<std::string, IsoSpriteAnimSet*>::iterator setIterator = s_animSets.find(animSetId);
+	if (setIterator != s_animSets.end())
+		return setIterator->second;
 
-	//TODO: add logic determining which anim to run from here.  This is the animation related pointer held in the entity itself.
-	m_currentAnim->Update(deltaSeconds);
+	std::map<std::string, IsoSpriteAnimSetDefinition*>::iterator defIterator = IsoSpriteAnimSetDefinition::s_isoSpriteAnimSetDefinitions.find(animSetId);
+	if (defIterator == IsoSpriteAnimSetDefinition::s_isoSpriteAnimSetDefinitions.end())
+		return nullptr;
 
-	if(m_currentAnim->IsFinished())
-	{
-		SetCurrentAnim("idle");
-	}
-}
+	IsoSpriteAnimSet* newSet = new IsoSpriteAnimSet(defIterator->second);
+	s_animSets[animSetId] = newSet;
 
-//  =========================================================================================
-void IsoSpriteAnimSet::StartAnim(const std::string& animNameSimplified )
-{
-	SetCurrentAnim(animNameSimplified);
-	m_currentAnim->PlayFromStart();
+	return newSet;
 }
 
 //  =========================================================================================
-void IsoSpriteAnimSet::SetCurrentAnim( const std::string& animNameSimplified )
+void IsoSpriteAnimSet::Update( IsoSpriteAnimState& state, float deltaSeconds ) const
 {
-	std::string animName = m_animSetDef->GetAnimationIdBySimplifiedName(ToLowerAsNew(animNameSimplified));
+	const IsoSpriteAnim* anim = m_anims[state.m_animationType];
 
-	auto animIndex = m_namedAnims.find(animName);
-	if(animIndex != m_namedAnims.end())
+	state.m_elapsedSeconds += deltaSeconds;
+	if (state.m_elapsedSeconds >= anim->GetDuration())
 	{
-		if (m_currentAnim != m_namedAnims.at(animName))
-		{
-			m_currentAnim = m_namedAnims.at(animName);
-			m_currentAnim->PlayFromStart();
-		}			
+		if (anim->DoesLoop())
+			state.m_elapsedSeconds = 0.f;
+		else
+			state.m_isFinished = true;
 	}
-	else
+
+	state.m_frameIndex = (uint8_t)anim->GetFrameIndexForTime(state.m_elapsedSeconds);
+
+	if (state.m_isFinished)
 	{
-		m_currentAnim = m_namedAnims.at("idle");
-		m_currentAnim->PlayFromStart();
+		SetCurrentAnim(state, IDLE_ANIMATION_TYPE);
 	}
 }
 
 //  =========================================================================================
-const Texture& IsoSpriteAnimSet::GetCurrentTexture(IntVector2 direction) const
+void IsoSpriteAnimSet::StartAnim( IsoSpriteAnimState& state, eAnimationType animationType ) const
 {
-	int index = m_currentAnim->GetIsoSpriteIndexForTime(m_currentAnim->GetElapsedSeconds());
-	IsoSprite* isoSprite = m_currentAnim->m_isoSprites[index];
-
-	return *isoSprite->GetCurrentTextureByDirection(direction);
+	state.m_animationType = (uint8_t)animationType;
+	state.m_frameIndex = 0;
+	state.m_isFinished = false;
+	state.m_elapsedSeconds = 0.f;
 }
 
 //  =========================================================================================
-AABB2 IsoSpriteAnimSet::GetCurrentUVs(IntVector2 direction) const
+void IsoSpriteAnimSet::SetCurrentAnim( IsoSpriteAnimState& state, eAnimationType animationType ) const
 {
-	int index = m_currentAnim->GetIsoSpriteIndexForTime(m_currentAnim->GetElapsedSeconds());
-	IsoSprite* isoSprite = m_currentAnim->m_isoSprites[index];
-
-	AABB2 uvs = isoSprite->GetCurrentUVsByDirection(direction);
+	//already playing it (or what it falls back to) so keep going
+	if (m_anims[state.m_animationType] == m_anims[animationType])
+	{
+		state.m_animationType = (uint8_t)animationType;
+		return;
+	}
 
-	return uvs;
+	StartAnim(state, animationType);
 }
 
 //  =========================================================================================
-Sprite* IsoSpriteAnimSet::GetCurrentSprite(IntVector2 direction)
+Sprite* IsoSpriteAnimSet::GetCurrentSprite(const IsoSpriteAnimState& state, const IntVector2& direction) const
 {
-	IsoSpriteAnim* anim = GetCurrentAnim();
-	int currentIsoSpriteIndex = anim->GetCurrentIsoSpriteIndex();
-
-	Sprite* sprite = anim->m_isoSprites[currentIsoSpriteIndex]->GetCurrentSpriteByDirection(direction);
-
-	return sprite;
+	return GetCurrentIsoSprite(state)->GetCurrentSpriteByDirection(direction);
 }
 
 //  =========================================================================================
-IsoSprite* IsoSpriteAnimSet::GetCurrentIsoSprite()
+IsoSprite* IsoSpriteAnimSet::GetCurrentIsoSprite(const IsoSpriteAnimState& state) const
 {
-	IsoSpriteAnim* anim = GetCurrentAnim();
-	int currentIsoSpriteIndex = anim->GetCurrentIsoSpriteIndex();
-	return anim->m_isoSprites[currentIsoSpriteIndex];	
-}
\ No newline at end of file
+	return m_anims[state.m_animationType]->GetIsoSprite(state.m_frameIndex);
+}
@@ -3,26 +3,53 @@
 #include <map>
 #include "Engine\Renderer\Texture.hpp"
 #include <string>
+#include <stdint.h>
 #include "Engine\Math\AABB2.hpp"
 #include "Game\Sprites\IsoSpriteAnim.hpp"
 
+//simplified animation names resolved once when the set is built so playback never looks anything up by string
+enum eAnimationType
+{
+	IDLE_ANIMATION_TYPE,
+	WALK_ANIMATION_TYPE,
+	CAST_ANIMATION_TYPE,
+	SHOOT_ANIMATION_TYPE,
+	DIE_ANIMATION_TYPE,
+	STAND_ANIMATION_TYPE,
+	HEAL_ANIMATION_TYPE,
+	NUM_ANIMATION_TYPES
+};
+
+//everything an agent keeps about its animation
+struct IsoSpriteAnimState
+{
+	uint8_t m_animationType = IDLE_ANIMATION_TYPE;
+	uint8_t m_frameIndex = 0;
+	bool m_isFinished = false;
+	float m_elapsedSeconds = 0.f;
+};
+
+//one shared, read only set per definition. all playback goes through the caller's IsoSpriteAnimState
 class IsoSpriteAnimSet
 {
 public:
-	IsoSpriteAnimSet( IsoSpriteAnimSetDefinition* animSetDef );
-	~IsoSpriteAnimSet();
-
-	void Update( float deltaSeconds );
-	void StartAnim( const std::string& animNameSimplified );
-	void IsoSpriteAnimSet::SetCurrentAnim( const std::string& animNameSimplified );
-	const Texture& GetCurrentTexture(IntVector2 direction) const;
-	AABB2 GetCurrentUVs(IntVector2 direction) const;
-	IsoSpriteAnim* GetCurrentAnim() const {return m_currentAnim;};
-	Sprite* GetCurrentSprite(IntVector2 direction);
-	IsoSprite* GetCurrentIsoSprite();
+	explicit IsoSpriteAnimSet( IsoSpriteAnimSetDefinition* animSetDef );
+
+	static IsoSpriteAnimSet* CreateOrGetAnimSet( const std::string& animSetId );
+
+	void Update( IsoSpriteAnimState& state, float deltaSeconds ) const;
+	void StartAnim( IsoSpriteAnimState& state, eAnimationType animationType ) const;
+	void SetCurrentAnim( IsoSpriteAnimState& state, eAnimationType animationType ) const;
+
+	const IsoSpriteAnim* GetAnim(eAnimationType animationType) const { return m_anims[animationType]; }
+	Sprite* GetCurrentSprite(const IsoSpriteAnimState& state, const IntVector2& direction) const;
+	IsoSprite* GetCurrentIsoSprite(const IsoSpriteAnimState& state) const;
 
 protected:
 	IsoSpriteAnimSetDefinition* m_animSetDef = nullptr;
-	std::map< std::string, IsoSpriteAnim* > m_namedAnims;
-	IsoSpriteAnim*	m_currentAnim = nullptr;
+
+	//types missing from the definition fall back to idle
+	IsoSpriteAnim* m_anims[NUM_ANIMATION_TYPES];
+
+	static std::map<std::string, IsoSpriteAnimSet*> s_animSets;
 };
@@ -5,6 +5,7 @@
 Sprite::Sprite(SpriteDefinition* definition)
 {
 	m_definition = definition;
+	CalculateNormalizedUV();
 }
 
 IntVector2 Sprite::GetDimensions() const
@@ -19,7 +20,7 @@ Texture* Sprite::GetSpriteTexture()
 	return theRenderer->CreateOrGetTexture(m_definition->m_diffuseSource);
 }
 
-AABB2 Sprite::GetNormalizedUV()
+void Sprite::CalculateNormalizedUV()
 {
 	AABB2 normalizedUv = m_definition->m_uvs;
 
@@ -39,5 +40,5 @@ AABB2 Sprite::GetNormalizedUV()
 	normalizedUv.mins.y = 1.f - normalizedUv.mins.y;
 	normalizedUv.maxs.y = 1.f - normalizedUv.maxs.y;
 
-	return normalizedUv;
+	m_normalizedUV = normalizedUv;
 }
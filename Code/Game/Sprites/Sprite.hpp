@@ -14,10 +14,16 @@ public:
 	//Sprite(const std::string& diffusePath, const int& pixelsPerUnit, const AABB2& uv, const Vector2& pivot);
 	IntVector2 GetDimensions() const;
 	Texture* GetSpriteTexture();
-	AABB2 GetNormalizedUV();
+	const AABB2& GetNormalizedUV() const { return m_normalizedUV; }
+
+private:
+	void CalculateNormalizedUV();
 
 public:
 	SpriteDefinition* m_definition;
+
+	//normalizing needs a texture lookup so it's done once at load. read only after that so any thread can use it
+	AABB2 m_normalizedUV;
 };
 
 